@@ -0,0 +1,111 @@
+//! \file
+//! `as-aabb-tree`
+
+#pragma once
+
+#include <vector>
+
+#include "as-math-ops.hpp"
+
+namespace as
+{
+
+//! The index used to represent no node (or proxy) in an \ref aabb_tree.
+constexpr int32_t k_aabb_tree_null = -1;
+
+//! The maximum depth of an \ref aabb_tree (the size of the fixed traversal
+//! stack).
+//! \note The tree is kept height balanced so its depth is at most
+//! `1.44 * log2(n)`, far below this limit.
+constexpr index k_aabb_tree_stack_size = 128;
+
+//! A node of an \ref aabb_tree.
+template<typename T>
+struct aabb_tree_node_t
+{
+  //! The bounds of all leaves below this node (the fattened bounds for a
+  //! leaf).
+  aabb_t<T> bounds;
+  //! The parent of the node, or the next node in the free list if the node is
+  //! not in use.
+  int32_t parent;
+  int32_t child1; //!< The first child (::k_aabb_tree_null for a leaf).
+  int32_t child2; //!< The second child (::k_aabb_tree_null for a leaf).
+  //! The height of the node (zero for a leaf and `-1` if not in use).
+  int32_t height;
+  int32_t user_data; //!< Caller provided data stored with a leaf.
+  //! If the leaf has been inserted or moved since the last pair query.
+  bool moved;
+};
+
+//! Represents an \ref aabb_tree (dynamic bounding volume hierarchy).
+//! \note Leaves (proxies) store bounds fattened by `margin` so small movements
+//! do not change the tree. Nodes are allocated from a pool with unused nodes
+//! kept in a free list so indices (proxies) remain stable.
+//! \note Inserted leaves are placed next to the sibling that minimizes the
+//! increase in surface area of the tree and ancestors are then rebalanced
+//! with tree rotations.
+template<typename T>
+struct aabb_tree_t
+{
+  std::vector<aabb_tree_node_t<T>> nodes; //!< All nodes (used and free).
+  //! Proxies inserted or moved since the last call to ::aabb_tree_query_pairs.
+  std::vector<int32_t> moved;
+  int32_t root = k_aabb_tree_null; //!< The root node.
+  int32_t free_list = k_aabb_tree_null; //!< The first node not in use.
+  T margin = T(0.1); //!< The distance leaf bounds are fattened by.
+};
+
+//! Type alias for an aabb_tree of type ::real.
+using aabb_tree = aabb_tree_t<real>;
+
+//! Inserts bounds into the tree and returns the proxy (leaf index) used to
+//! refer to it.
+//! \note The proxy is added to the set of moved proxies (see
+//! ::aabb_tree_query_pairs).
+//! \param tree The tree to insert into.
+//! \param bounds The (tight) bounds of the object.
+//! \param user_data Caller provided data stored with the leaf (usually the
+//! index of the object).
+template<typename T>
+int32_t aabb_tree_insert(
+  aabb_tree_t<T>& tree, const aabb_t<T>& bounds, int32_t user_data = 0);
+
+//! Removes a proxy from the tree.
+//! \note The node is returned to the free list and may be reused by a later
+//! insert.
+template<typename T>
+void aabb_tree_remove(aabb_tree_t<T>& tree, int32_t proxy);
+
+//! Updates the bounds of a proxy.
+//! \note If the new bounds are still contained by the fattened bounds of the
+//! proxy the tree is left unchanged and `false` is returned, otherwise the
+//! leaf is reinserted with new fattened bounds, added to the set of moved
+//! proxies and `true` is returned.
+template<typename T>
+bool aabb_tree_move(
+  aabb_tree_t<T>& tree, int32_t proxy, const aabb_t<T>& bounds);
+
+//! Invokes `fn` for each proxy whose fattened bounds overlap the bounds.
+//! \param tree The tree to query.
+//! \param bounds The bounds to test.
+//! \param fn Callable with the signature `void(int32_t proxy)`.
+template<typename T, typename Fn>
+void aabb_tree_query(
+  const aabb_tree_t<T>& tree, const aabb_t<T>& bounds, Fn&& fn);
+
+//! Invokes `fn` for each pair of overlapping proxies where at least one of
+//! the proxies has been inserted or moved since the last call, then clears
+//! the set of moved proxies.
+//! \note Only moved proxies are queried against the tree so the cost depends
+//! on the number of moved proxies, not the size of the tree. Each pair is
+//! reported once (with the lower proxy first).
+//! \param tree The tree to query.
+//! \param fn Callable with the signature `void(int32_t proxy_a, int32_t
+//! proxy_b)`.
+template<typename T, typename Fn>
+void aabb_tree_query_pairs(aabb_tree_t<T>& tree, Fn&& fn);
+
+} // namespace as
+
+#include "as-aabb-tree.inl"
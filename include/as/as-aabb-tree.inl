@@ -0,0 +1,301 @@
+namespace as
+{
+
+namespace internal
+{
+
+template<typename T>
+AS_API int32_t aabb_tree_allocate(aabb_tree_t<T>& tree)
+{
+  int32_t node = tree.free_list;
+  if (node == k_aabb_tree_null) {
+    node = static_cast<int32_t>(tree.nodes.size());
+    tree.nodes.emplace_back();
+  } else {
+    tree.free_list = tree.nodes[node].parent;
+  }
+  aabb_tree_node_t<T>& allocated = tree.nodes[node];
+  allocated.parent = k_aabb_tree_null;
+  allocated.child1 = k_aabb_tree_null;
+  allocated.child2 = k_aabb_tree_null;
+  allocated.height = 0;
+  allocated.user_data = 0;
+  allocated.moved = false;
+  return node;
+}
+
+template<typename T>
+AS_API void aabb_tree_free(aabb_tree_t<T>& tree, const int32_t node)
+{
+  tree.nodes[node].parent = tree.free_list;
+  tree.nodes[node].height = -1;
+  tree.free_list = node;
+}
+
+template<typename T>
+AS_API void aabb_tree_replace_child(
+  aabb_tree_t<T>& tree, const int32_t parent, const int32_t old_child,
+  const int32_t new_child)
+{
+  if (parent == k_aabb_tree_null) {
+    tree.root = new_child;
+  } else if (tree.nodes[parent].child1 == old_child) {
+    tree.nodes[parent].child1 = new_child;
+  } else {
+    tree.nodes[parent].child2 = new_child;
+  }
+}
+
+template<typename T>
+AS_API void aabb_tree_refit(aabb_tree_t<T>& tree, const int32_t node)
+{
+  aabb_tree_node_t<T>& current = tree.nodes[node];
+  const aabb_tree_node_t<T>& child1 = tree.nodes[current.child1];
+  const aabb_tree_node_t<T>& child2 = tree.nodes[current.child2];
+  current.bounds = aabb_merge(child1.bounds, child2.bounds);
+  current.height = 1 + std::max(child1.height, child2.height);
+}
+
+// ref: Erin Catto (2009) Box2D b2DynamicTree::Balance
+// rotates the taller child of a up if the children of a differ in height by
+// more than one and returns the node now at the position of a
+template<typename T>
+AS_API int32_t aabb_tree_balance(aabb_tree_t<T>& tree, const int32_t a)
+{
+  auto& nodes = tree.nodes;
+  if (nodes[a].child1 == k_aabb_tree_null || nodes[a].height < 2) {
+    return a;
+  }
+
+  const int32_t b = nodes[a].child1;
+  const int32_t c = nodes[a].child2;
+  const int32_t balance = nodes[c].height - nodes[b].height;
+
+  if (balance > 1) {
+    // rotate c up
+    const int32_t f = nodes[c].child1;
+    const int32_t g = nodes[c].child2;
+    nodes[c].child1 = a;
+    nodes[c].parent = nodes[a].parent;
+    nodes[a].parent = c;
+    aabb_tree_replace_child(tree, nodes[c].parent, a, c);
+    // keep the taller grandchild under c
+    const int32_t keep = nodes[f].height > nodes[g].height ? f : g;
+    const int32_t give = keep == f ? g : f;
+    nodes[c].child2 = keep;
+    nodes[a].child2 = give;
+    nodes[give].parent = a;
+    aabb_tree_refit(tree, a);
+    aabb_tree_refit(tree, c);
+    return c;
+  }
+
+  if (balance < -1) {
+    // rotate b up
+    const int32_t d = nodes[b].child1;
+    const int32_t e = nodes[b].child2;
+    nodes[b].child1 = a;
+    nodes[b].parent = nodes[a].parent;
+    nodes[a].parent = b;
+    aabb_tree_replace_child(tree, nodes[b].parent, a, b);
+    // keep the taller grandchild under b
+    const int32_t keep = nodes[d].height > nodes[e].height ? d : e;
+    const int32_t give = keep == d ? e : d;
+    nodes[b].child2 = keep;
+    nodes[a].child1 = give;
+    nodes[give].parent = a;
+    aabb_tree_refit(tree, a);
+    aabb_tree_refit(tree, b);
+    return b;
+  }
+
+  return a;
+}
+
+// refits and rebalances each node from node to the root
+template<typename T>
+AS_API void aabb_tree_refit_ancestors(aabb_tree_t<T>& tree, int32_t node)
+{
+  while (node != k_aabb_tree_null) {
+    // refit first so balancing sees the current height of the node
+    aabb_tree_refit(tree, node);
+    node = aabb_tree_balance(tree, node);
+    node = tree.nodes[node].parent;
+  }
+}
+
+// returns the cost of making leaf_bounds a sibling of a node below the
+// current node (excluding the cost inherited from ancestors)
+template<typename T>
+AS_API T aabb_tree_descend_cost(
+  const aabb_tree_node_t<T>& child, const aabb_t<T>& leaf_bounds)
+{
+  const T area = aabb_surface_area(aabb_merge(child.bounds, leaf_bounds));
+  // the area of an internal child grows, a leaf child gets a new parent
+  return child.child1 == k_aabb_tree_null
+         ? area
+         : area - aabb_surface_area(child.bounds);
+}
+
+// ref: Erin Catto (2019) Dynamic Bounding Volume Hierarchies, GDC
+template<typename T>
+AS_API void aabb_tree_insert_leaf(aabb_tree_t<T>& tree, const int32_t leaf)
+{
+  if (tree.root == k_aabb_tree_null) {
+    tree.root = leaf;
+    tree.nodes[leaf].parent = k_aabb_tree_null;
+    return;
+  }
+
+  // find the best sibling by descending toward the child with the lowest
+  // increase in surface area
+  const aabb_t<T> leaf_bounds = tree.nodes[leaf].bounds;
+  int32_t sibling = tree.root;
+  while (tree.nodes[sibling].child1 != k_aabb_tree_null) {
+    const aabb_tree_node_t<T>& node = tree.nodes[sibling];
+    const T area = aabb_surface_area(node.bounds);
+    const T combined_area =
+      aabb_surface_area(aabb_merge(node.bounds, leaf_bounds));
+    // cost of creating a new parent for this node and the new leaf
+    const T cost = T(2.0) * combined_area;
+    // minimum cost of pushing the leaf further down the tree
+    const T inheritance_cost = T(2.0) * (combined_area - area);
+    const T cost1 =
+      aabb_tree_descend_cost(tree.nodes[node.child1], leaf_bounds)
+      + inheritance_cost;
+    const T cost2 =
+      aabb_tree_descend_cost(tree.nodes[node.child2], leaf_bounds)
+      + inheritance_cost;
+    if (cost < cost1 && cost < cost2) {
+      break;
+    }
+    sibling = cost1 < cost2 ? node.child1 : node.child2;
+  }
+
+  // create a new parent for the sibling and the leaf
+  const int32_t old_parent = tree.nodes[sibling].parent;
+  const int32_t new_parent = aabb_tree_allocate(tree);
+  tree.nodes[new_parent].parent = old_parent;
+  tree.nodes[new_parent].child1 = sibling;
+  tree.nodes[new_parent].child2 = leaf;
+  tree.nodes[sibling].parent = new_parent;
+  tree.nodes[leaf].parent = new_parent;
+  aabb_tree_replace_child(tree, old_parent, sibling, new_parent);
+
+  aabb_tree_refit_ancestors(tree, new_parent);
+}
+
+template<typename T>
+AS_API void aabb_tree_remove_leaf(aabb_tree_t<T>& tree, const int32_t leaf)
+{
+  if (leaf == tree.root) {
+    tree.root = k_aabb_tree_null;
+    return;
+  }
+
+  const int32_t parent = tree.nodes[leaf].parent;
+  const int32_t grandparent = tree.nodes[parent].parent;
+  const int32_t sibling = tree.nodes[parent].child1 == leaf
+                          ? tree.nodes[parent].child2
+                          : tree.nodes[parent].child1;
+
+  // replace the parent with the sibling
+  aabb_tree_replace_child(tree, grandparent, parent, sibling);
+  tree.nodes[sibling].parent = grandparent;
+  aabb_tree_free(tree, parent);
+
+  aabb_tree_refit_ancestors(tree, grandparent);
+}
+
+template<typename T>
+AS_API void aabb_tree_mark_moved(aabb_tree_t<T>& tree, const int32_t proxy)
+{
+  if (!tree.nodes[proxy].moved) {
+    tree.nodes[proxy].moved = true;
+    tree.moved.push_back(proxy);
+  }
+}
+
+} // namespace internal
+
+template<typename T>
+AS_API int32_t aabb_tree_insert(
+  aabb_tree_t<T>& tree, const aabb_t<T>& bounds, const int32_t user_data)
+{
+  const int32_t proxy = internal::aabb_tree_allocate(tree);
+  tree.nodes[proxy].bounds = aabb_expand(bounds, tree.margin);
+  tree.nodes[proxy].user_data = user_data;
+  internal::aabb_tree_insert_leaf(tree, proxy);
+  internal::aabb_tree_mark_moved(tree, proxy);
+  return proxy;
+}
+
+template<typename T>
+AS_API void aabb_tree_remove(aabb_tree_t<T>& tree, const int32_t proxy)
+{
+  if (tree.nodes[proxy].moved) {
+    tree.moved.erase(std::find(tree.moved.begin(), tree.moved.end(), proxy));
+  }
+  internal::aabb_tree_remove_leaf(tree, proxy);
+  internal::aabb_tree_free(tree, proxy);
+}
+
+template<typename T>
+AS_API bool aabb_tree_move(
+  aabb_tree_t<T>& tree, const int32_t proxy, const aabb_t<T>& bounds)
+{
+  if (aabb_contains(tree.nodes[proxy].bounds, bounds)) {
+    return false;
+  }
+  internal::aabb_tree_remove_leaf(tree, proxy);
+  tree.nodes[proxy].bounds = aabb_expand(bounds, tree.margin);
+  internal::aabb_tree_insert_leaf(tree, proxy);
+  internal::aabb_tree_mark_moved(tree, proxy);
+  return true;
+}
+
+template<typename T, typename Fn>
+AS_API void aabb_tree_query(
+  const aabb_tree_t<T>& tree, const aabb_t<T>& bounds, Fn&& fn)
+{
+  if (tree.root == k_aabb_tree_null) {
+    return;
+  }
+
+  int32_t stack[k_aabb_tree_stack_size];
+  index top = 0;
+  stack[top++] = tree.root;
+  while (top > 0) {
+    const aabb_tree_node_t<T>& node = tree.nodes[stack[--top]];
+    if (!aabb_overlaps(node.bounds, bounds)) {
+      continue;
+    }
+    if (node.child1 == k_aabb_tree_null) {
+      fn(stack[top]);
+    } else {
+      stack[top++] = node.child2;
+      stack[top++] = node.child1;
+    }
+  }
+}
+
+template<typename T, typename Fn>
+AS_API void aabb_tree_query_pairs(aabb_tree_t<T>& tree, Fn&& fn)
+{
+  for (const int32_t proxy : tree.moved) {
+    aabb_tree_query(
+      tree, tree.nodes[proxy].bounds, [&tree, &fn, proxy](const int32_t other) {
+        // report pairs of moved proxies only once (from the lower proxy)
+        if (other == proxy || (tree.nodes[other].moved && other < proxy)) {
+          return;
+        }
+        fn(std::min(proxy, other), std::max(proxy, other));
+      });
+  }
+  for (const int32_t proxy : tree.moved) {
+    tree.nodes[proxy].moved = false;
+  }
+  tree.moved.clear();
+}
+
+} // namespace as
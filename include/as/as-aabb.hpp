@@ -0,0 +1,43 @@
+//! \file
+//! `as-aabb`
+
+#pragma once
+
+#include "as-vec.hpp"
+
+namespace as
+{
+
+//! Represents an \ref aabb (axis-aligned bounding box).
+//! The box spans from `min` to `max` (inclusive) along each axis.
+template<typename T>
+struct aabb_t
+{
+  aabb_t() noexcept = default;
+
+  //! Constructs an aabb with `(min_, max_)`
+  constexpr aabb_t(const vec<T, 3>& min_, const vec<T, 3>& max_);
+
+  //! Returns an empty aabb (`min` is the largest and `max` the lowest
+  //! representable value).
+  //! \note Merging any point or aabb with an empty aabb returns the point or
+  //! aabb itself.
+  constexpr static aabb_t empty();
+
+  //! Returns `6`.
+  constexpr static index size();
+
+  vec<T, 3> min; //!< The minimum corner of the box.
+  vec<T, 3> max; //!< The maximum corner of the box.
+};
+
+//! Type alias for an aabb of type ::real.
+using aabb = aabb_t<real>;
+//! Type alias for an aabb of type float.
+using aabbf = aabb_t<float>;
+//! Type alias for an aabb of type double.
+using aabbd = aabb_t<double>;
+
+} // namespace as
+
+#include "as-aabb.inl"
@@ -0,0 +1,24 @@
+namespace as
+{
+
+template<typename T>
+AS_API constexpr aabb_t<T>::aabb_t(const vec<T, 3>& min_, const vec<T, 3>& max_)
+  : min(min_), max(max_)
+{
+}
+
+template<typename T>
+AS_API constexpr aabb_t<T> aabb_t<T>::empty()
+{
+  return aabb_t(
+    vec<T, 3>(std::numeric_limits<T>::max()),
+    vec<T, 3>(std::numeric_limits<T>::lowest()));
+}
+
+template<typename T>
+AS_API constexpr index aabb_t<T>::size()
+{
+  return 6;
+}
+
+} // namespace as
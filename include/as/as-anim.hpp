@@ -0,0 +1,136 @@
+//! \file
+//! `as-anim`
+
+#pragma once
+
+#include <vector>
+
+#include "as-pack.hpp"
+#include "as-skeleton.hpp"
+#include "as-skin.hpp"
+
+namespace as
+{
+
+//! Represents the \ref anim_keys of one kind of track of an \ref anim_clip
+//! (rotation, translation or scale).
+//! \note Each track keeps only the keys that cannot be interpolated from
+//! their neighbors (the first and last frame are always kept). Keys are
+//! sorted by the time they are first needed during playback: the first two
+//! keys of every track come first (in track order) and the remaining keys
+//! follow, ordered by the frame of the key before them in their track. A
+//! sampler moving forward through the clip reads keys linearly.
+struct anim_keys
+{
+  std::vector<uint16_t> frames; //!< The frame of each key.
+  std::vector<uint16_t> tracks; //!< The track (joint) of each key.
+  //! The three quantized values of each key (key `k` is at `k * 3`).
+  std::vector<uint16_t> values;
+};
+
+//! Represents an \ref anim_clip (a compressed animation of the rotation,
+//! translation and scale of every joint of a skeleton).
+//! \note Rotations are stored with 48 bit smallest three encoding (see
+//! ::quat_pack_smallest3_48). Translations and scales are range reduced,
+//! each component is stored in 16 bits relative to the bounds of its track.
+//! \note Create with ::anim_clip_build and sample with ::anim_clip_sample.
+struct anim_clip
+{
+  index joint_count; //!< The number of joints (tracks of each kind).
+  index frame_count; //!< The number of frames the clip was sampled at.
+  real frame_rate; //!< The number of frames per second.
+  anim_keys rotations; //!< The rotation keys.
+  anim_keys translations; //!< The translation keys.
+  anim_keys scales; //!< The scale keys.
+  //! The minimum translation of each track.
+  std::vector<vec3> translation_min;
+  //! The size of the range of translations of each track.
+  std::vector<vec3> translation_extent;
+  std::vector<vec3> scale_min; //!< The minimum scale of each track.
+  //! The size of the range of scales of each track.
+  std::vector<vec3> scale_extent;
+};
+
+//! Represents an \ref anim_sampler (the keys each track of an
+//! \ref anim_clip is currently interpolating between).
+//! \note The frame and values of the two keys of each track are copied to a
+//! structure of arrays as keys are read, so sampling reads every track in
+//! order. Sampling forward in time only reads keys that have not been read
+//! before, sampling backward in time starts from the first keys again.
+//! \note Storage allocated by the sampler is reused.
+struct anim_sampler
+{
+  //! The keys of one kind of track.
+  struct cursor
+  {
+    //! The frame of the key before (at `t`) and after (at
+    //! `joint_count + t`) the sampled frame of each track `t`.
+    std::vector<uint16_t> frames;
+    //! The three values of the key before (at `c * joint_count + t`) and
+    //! after (at `(3 + c) * joint_count + t`) the sampled frame of each
+    //! track `t`.
+    std::vector<uint16_t> values;
+    index next = 0; //!< The next key to read.
+  };
+
+  const anim_clip* clip = nullptr; //!< The clip last sampled.
+  real frame = 0.0_r; //!< The frame last sampled.
+  cursor rotations; //!< The rotation keys of each track.
+  cursor translations; //!< The translation keys of each track.
+  cursor scales; //!< The scale keys of each track.
+};
+
+//! Returns a compressed \ref anim_clip built from samples of the local pose
+//! of every joint at a fixed frame rate.
+//! \note Samples are stored frame by frame (the sample of joint `j` at frame
+//! `f` is at `f * joint_count + j`).
+//! \note Values are quantized first and then keys that can be linearly
+//! interpolated (normalized linearly for rotations) from the neighboring
+//! keys within the tolerance are removed.
+//! \param rotations The rotation of each joint at each frame.
+//! \param translations The translation of each joint at each frame.
+//! \param scales The scale of each joint at each frame.
+//! \param joint_count The number of joints.
+//! \param frame_count The number of frames (at most 65536).
+//! \param frame_rate The number of frames per second.
+//! \param rotation_tolerance The maximum angle in radians between a sampled
+//! and interpolated rotation.
+//! \param translation_tolerance The maximum distance between a sampled and
+//! interpolated translation.
+//! \param scale_tolerance The maximum difference between a component of a
+//! sampled and interpolated scale.
+anim_clip anim_clip_build(
+  const quat* rotations, const vec3* translations, const vec3* scales,
+  index joint_count, index frame_count, real frame_rate,
+  real rotation_tolerance, real translation_tolerance, real scale_tolerance);
+
+//! Returns the number of bytes used by the keys and ranges of the
+//! \ref anim_clip.
+index anim_clip_size_bytes(const anim_clip& clip);
+
+//! Returns the length of the \ref anim_clip in seconds.
+real anim_clip_duration(const anim_clip& clip);
+
+//! Samples the local pose of every joint of the \ref anim_clip at a time.
+//! \note The keys of each track are found by the sampler (see
+//! \ref anim_sampler), the keys are then decompressed and interpolated for
+//! every track in one branch free loop for each kind of track (the keys of
+//! every joint are at the same offsets of the sampler, one joint per lane).
+//! GCC and Clang require `-fno-math-errno` to vectorize the square roots of
+//! the rotation loop.
+//! \note Sampling costs about as much as interpolating uncompressed keys, the
+//! gain is the size of the clip (see ::anim_clip_size_bytes).
+//! \param clip The clip to sample.
+//! \param sampler The keys of each track, updated to the time.
+//! \param time The time in seconds (clamped to the length of the clip).
+//! \param pose The local pose of each joint to write to (see
+//! ::skeleton_local_to_model).
+//! \param scale The scale of each joint to write to (pass `nullptr` for
+//! every member to skip sampling scale).
+void anim_clip_sample(
+  const anim_clip& clip, anim_sampler& sampler, real time,
+  const rigid_soa_t<real>& pose, const vec3_soa_t<real>& scale);
+
+} // namespace as
+
+#include "as-anim.inl"
@@ -0,0 +1,390 @@
+namespace as
+{
+
+namespace internal
+{
+
+// the number of tracks sampled together with results written to the stack
+constexpr index k_anim_block_size = 256;
+
+constexpr real k_anim_quantized_max = 65535.0_r;
+
+// returns the frames of the keys kept for a track, the first and last frame
+// are always kept and every other key is kept only if some frame between the
+// previous kept key and the next frame does not fit (see anim_clip_build)
+template<typename Fits>
+AS_API std::vector<uint16_t> anim_reduce_keys(
+  const index frame_count, const Fits& fits)
+{
+  std::vector<uint16_t> kept = {0};
+  index first = 0;
+  for (index last = 2; last < frame_count; ++last) {
+    if (!fits(first, last)) {
+      first = last - 1;
+      kept.push_back(uint16_t(first));
+    }
+  }
+  // a track with one frame has the same key twice
+  kept.push_back(uint16_t(frame_count - 1));
+  return kept;
+}
+
+// writes the kept keys of every track sorted by the time they are first
+// needed (see anim_keys), values holds the three quantized values of every
+// frame of every track (track j at frame f is at (j * frame_count + f) * 3)
+AS_API inline void anim_sort_keys(
+  const std::vector<std::vector<uint16_t>>& kept,
+  const std::vector<uint16_t>& values, const index frame_count,
+  anim_keys& keys)
+{
+  const auto push_key = [&](const index track, const uint16_t frame) {
+    keys.frames.push_back(frame);
+    keys.tracks.push_back(uint16_t(track));
+    const index value = (track * frame_count + frame) * 3;
+    keys.values.insert(
+      keys.values.end(), values.begin() + value, values.begin() + value + 3);
+  };
+
+  struct later_key
+  {
+    uint16_t previous; // the frame of the key before in the track
+    uint16_t track;
+    uint16_t frame;
+  };
+
+  std::vector<later_key> later;
+  for (index j = 0; j < index(kept.size()); ++j) {
+    push_key(j, kept[j][0]);
+    push_key(j, kept[j][1]);
+    for (index k = 2; k < index(kept[j].size()); ++k) {
+      later.push_back({kept[j][k - 1], uint16_t(j), kept[j][k]});
+    }
+  }
+  std::sort(
+    later.begin(), later.end(), [](const later_key& lhs, const later_key& rhs) {
+      return lhs.previous != rhs.previous ? lhs.previous < rhs.previous
+                                          : lhs.track < rhs.track;
+    });
+  for (const later_key& key : later) {
+    push_key(key.track, key.frame);
+  }
+}
+
+// returns the angle between two rotations (accurate for small angles unlike
+// the arc cosine of the dot product)
+AS_API inline real anim_rotation_error(const quat& lhs, const quat& rhs)
+{
+  const quat difference = quat_conjugate(lhs) * rhs;
+  return 2.0_r
+       * std::atan2(
+           std::sqrt(
+             difference.x * difference.x + difference.y * difference.y
+             + difference.z * difference.z),
+           std::abs(difference.w));
+}
+
+// builds the keys of three component values (translations or scales) range
+// reduced to the bounds of each track, error returns how far apart two values
+// are compared to the tolerance
+template<typename Error>
+AS_API void anim_build_vec3_keys(
+  const vec3* samples, const index joint_count, const index frame_count,
+  const real tolerance, const Error& error, anim_keys& keys,
+  std::vector<vec3>& min, std::vector<vec3>& extent)
+{
+  min.resize(joint_count);
+  extent.resize(joint_count);
+  std::vector<uint16_t> values(joint_count * frame_count * 3);
+  std::vector<std::vector<uint16_t>> kept(joint_count);
+  std::vector<vec3> decoded(frame_count);
+  for (index j = 0; j < joint_count; ++j) {
+    vec3 lower = samples[j];
+    vec3 upper = samples[j];
+    for (index f = 1; f < frame_count; ++f) {
+      lower = vec_min(lower, samples[f * joint_count + j]);
+      upper = vec_max(upper, samples[f * joint_count + j]);
+    }
+    min[j] = lower;
+    extent[j] = upper - lower;
+    for (index f = 0; f < frame_count; ++f) {
+      const vec3 sample = samples[f * joint_count + j];
+      for (index c = 0; c < 3; ++c) {
+        // a track that does not change stores 0
+        const real unit = extent[j][c] > 0.0_r
+                          ? (sample[c] - lower[c]) / extent[j][c]
+                          : 0.0_r;
+        const auto quantized = uint16_t(
+          std::round(clamp(unit, 0.0_r, 1.0_r) * k_anim_quantized_max));
+        values[(j * frame_count + f) * 3 + c] = quantized;
+        decoded[f][c] =
+          lower[c] + real(quantized) * extent[j][c] / k_anim_quantized_max;
+      }
+    }
+    kept[j] = anim_reduce_keys(
+      frame_count, [&](const index first, const index last) {
+        for (index f = first + 1; f < last; ++f) {
+          const real t = real(f - first) / real(last - first);
+          const vec3 interpolated =
+            vec_mix(decoded[first], decoded[last], t);
+          if (error(interpolated, samples[f * joint_count + j]) > tolerance) {
+            return false;
+          }
+        }
+        return true;
+      });
+  }
+  anim_sort_keys(kept, values, frame_count, keys);
+}
+
+// reads the first two keys of every track
+AS_API inline void anim_cursor_reset(
+  anim_sampler::cursor& cursor, const anim_keys& keys, const index joint_count)
+{
+  cursor.frames.resize(joint_count * 2);
+  cursor.values.resize(joint_count * 6);
+  for (index t = 0; t < joint_count; ++t) {
+    cursor.frames[t] = keys.frames[t * 2];
+    cursor.frames[joint_count + t] = keys.frames[t * 2 + 1];
+    for (index c = 0; c < 3; ++c) {
+      cursor.values[c * joint_count + t] = keys.values[t * 6 + c];
+      cursor.values[(3 + c) * joint_count + t] = keys.values[t * 6 + 3 + c];
+    }
+  }
+  cursor.next = joint_count * 2;
+}
+
+// reads keys until every track has a key after the frame (or has reached its
+// last key), keys are sorted so the next key replaces the key after the frame
+// of its track as soon as that key is passed
+AS_API inline void anim_cursor_advance(
+  anim_sampler::cursor& cursor, const anim_keys& keys, const index joint_count,
+  const real frame)
+{
+  const auto key_count = index(keys.frames.size());
+  while (cursor.next < key_count) {
+    const index t = keys.tracks[cursor.next];
+    if (frame <= real(cursor.frames[joint_count + t])) {
+      break;
+    }
+    cursor.frames[t] = cursor.frames[joint_count + t];
+    cursor.frames[joint_count + t] = keys.frames[cursor.next];
+    for (index c = 0; c < 3; ++c) {
+      cursor.values[c * joint_count + t] =
+        cursor.values[(3 + c) * joint_count + t];
+      cursor.values[(3 + c) * joint_count + t] =
+        keys.values[cursor.next * 3 + c];
+    }
+    ++cursor.next;
+  }
+}
+
+// returns how far between the frames of the two keys of a track the frame is
+AS_API inline real anim_key_alpha(
+  const real frame, const uint16_t before, const uint16_t after)
+{
+  const real fb = real(before);
+  const real fa = real(after);
+  return clamp((frame - fb) / (fa - fb + real(fa == fb)), 0.0_r, 1.0_r);
+}
+
+// interpolates the rotation of every track (normalized linear interpolation)
+AS_API inline void anim_sample_rotations(
+  const anim_sampler::cursor& cursor, const index joint_count,
+  const real frame, const rigid_soa_t<real>& pose)
+{
+  const uint16_t* frames = cursor.frames.data();
+  const uint16_t* values = cursor.values.data();
+  // the 48 bits of ::quat_pack_smallest3_48 from three 16 bit values (with
+  // 32 bit integers so the loop vectorizes)
+  const auto decode = [](
+                        const uint32_t low, const uint32_t mid,
+                        const uint32_t high) {
+    const uint32_t bits = low | mid << 16;
+    return quat_from_smallest3(
+      int32_t(bits & 3),
+      quat_smallest3_component<15>(int32_t((bits >> 2) & 0x7fff)),
+      quat_smallest3_component<15>(int32_t((bits >> 17) & 0x7fff)),
+      quat_smallest3_component<15>(int32_t(high & 0x7fff)));
+  };
+  for (index begin = 0; begin < joint_count; begin += k_anim_block_size) {
+    const index count = std::min(joint_count - begin, k_anim_block_size);
+    // the four rotation arrays of the pose may overlap each other, the block
+    // is interpolated on the stack and each array is filled with a copy
+    real rotation[4][k_anim_block_size];
+    for (index i = 0; i < count; ++i) {
+      const index t = begin + i;
+      const real alpha =
+        anim_key_alpha(frame, frames[t], frames[joint_count + t]);
+      const quat before = decode(
+        values[t], values[joint_count + t], values[joint_count * 2 + t]);
+      const quat after = decode(
+        values[joint_count * 3 + t], values[joint_count * 4 + t],
+        values[joint_count * 5 + t]);
+      // the shortest path between the keys
+      const real sign = std::copysign(
+        1.0_r, before.w * after.w + before.x * after.x + before.y * after.y
+                 + before.z * after.z);
+      const real w = before.w + (after.w * sign - before.w) * alpha;
+      const real x = before.x + (after.x * sign - before.x) * alpha;
+      const real y = before.y + (after.y * sign - before.y) * alpha;
+      const real z = before.z + (after.z * sign - before.z) * alpha;
+      const real inv_length = 1.0_r / std::sqrt(w * w + x * x + y * y + z * z);
+      rotation[0][i] = w * inv_length;
+      rotation[1][i] = x * inv_length;
+      rotation[2][i] = y * inv_length;
+      rotation[3][i] = z * inv_length;
+    }
+    std::copy(rotation[0], rotation[0] + count, pose.rotation_w + begin);
+    std::copy(rotation[1], rotation[1] + count, pose.rotation_x + begin);
+    std::copy(rotation[2], rotation[2] + count, pose.rotation_y + begin);
+    std::copy(rotation[3], rotation[3] + count, pose.rotation_z + begin);
+  }
+}
+
+// interpolates the range reduced value of every track (linear interpolation)
+AS_API inline void anim_sample_vec3(
+  const anim_sampler::cursor& cursor, const index joint_count,
+  const real frame, const vec3* min, const vec3* extent,
+  const vec3_soa_t<real>& result)
+{
+  const uint16_t* frames = cursor.frames.data();
+  const uint16_t* values = cursor.values.data();
+  for (index begin = 0; begin < joint_count; begin += k_anim_block_size) {
+    const index count = std::min(joint_count - begin, k_anim_block_size);
+    real value[3][k_anim_block_size];
+    for (index i = 0; i < count; ++i) {
+      const index t = begin + i;
+      const real alpha =
+        anim_key_alpha(frame, frames[t], frames[joint_count + t]);
+      for (index c = 0; c < 3; ++c) {
+        const real before = real(values[c * joint_count + t]);
+        const real after = real(values[(3 + c) * joint_count + t]);
+        value[c][i] = min[t][c]
+                    + (before + (after - before) * alpha) * extent[t][c]
+                        * (1.0_r / k_anim_quantized_max);
+      }
+    }
+    std::copy(value[0], value[0] + count, result.x + begin);
+    std::copy(value[1], value[1] + count, result.y + begin);
+    std::copy(value[2], value[2] + count, result.z + begin);
+  }
+}
+
+} // namespace internal
+
+AS_API inline anim_clip anim_clip_build(
+  const quat* rotations, const vec3* translations, const vec3* scales,
+  const index joint_count, const index frame_count, const real frame_rate,
+  const real rotation_tolerance, const real translation_tolerance,
+  const real scale_tolerance)
+{
+  anim_clip clip;
+  clip.joint_count = joint_count;
+  clip.frame_count = frame_count;
+  clip.frame_rate = frame_rate;
+
+  std::vector<uint16_t> values(joint_count * frame_count * 3);
+  std::vector<std::vector<uint16_t>> kept(joint_count);
+  std::vector<quat> decoded(frame_count);
+  for (index j = 0; j < joint_count; ++j) {
+    for (index f = 0; f < frame_count; ++f) {
+      const uint64_t packed =
+        quat_pack_smallest3_48(quat_normalize(rotations[f * joint_count + j]));
+      for (index c = 0; c < 3; ++c) {
+        values[(j * frame_count + f) * 3 + c] =
+          uint16_t((packed >> (c * 16)) & 0xffff);
+      }
+      decoded[f] = quat_unpack_smallest3_48(packed);
+    }
+    kept[j] = internal::anim_reduce_keys(
+      frame_count, [&](const index first, const index last) {
+        for (index f = first + 1; f < last; ++f) {
+          const real t = real(f - first) / real(last - first);
+          const quat interpolated =
+            quat_nlerp(decoded[first], decoded[last], t);
+          if (
+            internal::anim_rotation_error(
+              interpolated, quat_normalize(rotations[f * joint_count + j]))
+            > rotation_tolerance) {
+            return false;
+          }
+        }
+        return true;
+      });
+  }
+  internal::anim_sort_keys(kept, values, frame_count, clip.rotations);
+
+  internal::anim_build_vec3_keys(
+    translations, joint_count, frame_count, translation_tolerance,
+    [](const vec3& lhs, const vec3& rhs) { return vec_distance(lhs, rhs); },
+    clip.translations, clip.translation_min, clip.translation_extent);
+  internal::anim_build_vec3_keys(
+    scales, joint_count, frame_count, scale_tolerance,
+    [](const vec3& lhs, const vec3& rhs) {
+      return vec_max_elem(vec_abs(lhs - rhs));
+    },
+    clip.scales, clip.scale_min, clip.scale_extent);
+
+  return clip;
+}
+
+AS_API inline index anim_clip_size_bytes(const anim_clip& clip)
+{
+  const auto keys_size_bytes = [](const anim_keys& keys) {
+    return index(
+      (keys.frames.size() + keys.tracks.size() + keys.values.size())
+      * sizeof(uint16_t));
+  };
+  return keys_size_bytes(clip.rotations) + keys_size_bytes(clip.translations)
+       + keys_size_bytes(clip.scales)
+       + clip.joint_count * 4 * index(sizeof(vec3));
+}
+
+AS_API inline real anim_clip_duration(const anim_clip& clip)
+{
+  return real(clip.frame_count - 1) / clip.frame_rate;
+}
+
+AS_API inline void anim_clip_sample(
+  const anim_clip& clip, anim_sampler& sampler, const real time,
+  const rigid_soa_t<real>& pose, const vec3_soa_t<real>& scale)
+{
+  const index joint_count = clip.joint_count;
+  const real frame =
+    clamp(time * clip.frame_rate, 0.0_r, real(clip.frame_count - 1));
+
+  // keys are only read forward, start again for a different clip or when
+  // moving backward in time
+  if (
+    sampler.clip != &clip || frame < sampler.frame
+    || index(sampler.rotations.frames.size()) != joint_count * 2) {
+    internal::anim_cursor_reset(sampler.rotations, clip.rotations, joint_count);
+    internal::anim_cursor_reset(
+      sampler.translations, clip.translations, joint_count);
+    internal::anim_cursor_reset(sampler.scales, clip.scales, joint_count);
+  }
+  sampler.clip = &clip;
+  sampler.frame = frame;
+
+  internal::anim_cursor_advance(
+    sampler.rotations, clip.rotations, joint_count, frame);
+  internal::anim_cursor_advance(
+    sampler.translations, clip.translations, joint_count, frame);
+  internal::anim_sample_rotations(sampler.rotations, joint_count, frame, pose);
+  internal::anim_sample_vec3(
+    sampler.translations, joint_count, frame, clip.translation_min.data(),
+    clip.translation_extent.data(),
+    vec3_soa_t<real>{pose.translation_x, pose.translation_y,
+                     pose.translation_z});
+
+  if (scale.x == nullptr) {
+    return;
+  }
+  internal::anim_cursor_advance(
+    sampler.scales, clip.scales, joint_count, frame);
+  internal::anim_sample_vec3(
+    sampler.scales, joint_count, frame, clip.scale_min.data(),
+    clip.scale_extent.data(), scale);
+}
+
+} // namespace as
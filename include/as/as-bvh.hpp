@@ -0,0 +1,126 @@
+//! \file
+//! `as-bvh`
+
+#pragma once
+
+#include <vector>
+
+#include "as-executor.hpp"
+#include "as-math-ops.hpp"
+#include "as-morton.hpp"
+#include "as-reduce.hpp"
+
+namespace as
+{
+
+//! A node of a \ref bvh.
+//! \note Nodes are stored in depth first order so the first child of an
+//! internal node immediately follows it in memory and only the index of the
+//! second child needs to be stored. A node of type float is 32 bytes (two per
+//! cache line).
+template<typename T>
+struct bvh_node_t
+{
+  aabb_t<T> bounds; //!< The bounds of all primitives below this node.
+  //! For a leaf the index of the first primitive in bvh_t::primitives, for an
+  //! internal node the index of the second child.
+  int32_t offset;
+  int32_t count; //!< The number of primitives in a leaf (zero if internal).
+};
+
+//! Represents a \ref bvh (bounding volume hierarchy).
+//! \note Built by ::bvh_build as a linear BVH (primitives are sorted by the
+//! Morton code of their centroid and the hierarchy is formed from the bits of
+//! the sorted codes).
+template<typename T>
+struct bvh_t
+{
+  //! All nodes in depth first order (the root is the first node).
+  std::vector<bvh_node_t<T>> nodes;
+  //! Primitive indices (into the array of bounds the hierarchy was built from)
+  //! referenced by the leaves.
+  std::vector<int32_t> primitives;
+};
+
+//! Type alias for a bvh of type ::real.
+using bvh = bvh_t<real>;
+
+//! The maximum depth of a hierarchy built by ::bvh_build.
+//! \note Every split consumes one bit of the 63 bit Morton code, once codes are
+//! identical primitives are split in half (at most 31 more levels), so
+//! traversal can always use a fixed size stack of this size.
+constexpr index k_bvh_stack_size = 128;
+
+//! The number of primitives processed by each chunk when computing centroids.
+constexpr index k_bvh_chunk_size = 4096;
+
+//! The number of primitives at or below which a subtree is built as a single
+//! unit of work by ::bvh_build.
+constexpr index k_bvh_subtree_size = 16384;
+
+//! Returns a linear bounding volume hierarchy built from an array of bounds.
+//! \note Centroid computation, Morton encoding and sorting (see ::radix_sort)
+//! are split into chunks. The top of the hierarchy (ranges larger than
+//! ::k_bvh_subtree_size) is split serially and the remaining subtrees are then
+//! each built independently (and in parallel if the executor allows) before
+//! being copied into a single flat array. The result does not depend on the
+//! executor used.
+//! \param bounds The bounds of each primitive.
+//! \param count The number of primitives.
+//! \param max_leaf_size The maximum number of primitives in a leaf (must be
+//! greater than zero).
+//! \param executor The executor to process chunks with (see
+//! ::serial_executor).
+template<typename T, typename Executor = serial_executor>
+bvh_t<T> bvh_build(
+  const aabb_t<T>* bounds, index count, int32_t max_leaf_size = 4,
+  const Executor& executor = Executor{});
+
+//! Invokes `fn` for each primitive in a leaf the ray intersects.
+//! \note Children are visited closest first and any node farther than the
+//! current maximum distance is skipped.
+//! \param hierarchy The hierarchy to traverse.
+//! \param origin The origin of the ray.
+//! \param inv_direction The reciprocal of each component of the ray direction.
+//! \param max_distance The maximum distance along the ray to test.
+//! \param fn Callable with the signature `T(int32_t primitive, T max_distance)`
+//! that returns the distance to the closest hit with the primitive if less than
+//! `max_distance`, otherwise `max_distance`.
+//! ```{.cpp}
+//! int32_t closest_primitive = -1;
+//! as::bvh_intersect_ray(
+//!   hierarchy, origin, as::vec3::one() / direction, max_distance,
+//!   [&](const int32_t primitive, const as::real distance) {
+//!     const as::real hit = intersect(primitive, origin, direction, distance);
+//!     if (hit < distance) {
+//!       closest_primitive = primitive;
+//!       return hit;
+//!     }
+//!     return distance;
+//!   });
+//! ```
+template<typename T, typename Fn>
+void bvh_intersect_ray(
+  const bvh_t<T>& hierarchy, const vec<T, 3>& origin,
+  const vec<T, 3>& inv_direction, T max_distance, Fn&& fn);
+
+//! Invokes `fn` for each primitive in a leaf the \ref ray intersects.
+//! \note See ::bvh_intersect_ray(const bvh_t<T>&, const vec<T, 3>&, const
+//! vec<T, 3>&, T, Fn&&) for details of `fn`.
+template<typename T, typename Fn>
+void bvh_intersect_ray(
+  const bvh_t<T>& hierarchy, const ray_t<T>& r, T max_distance, Fn&& fn);
+
+//! Invokes `fn` for each primitive in a leaf overlapping the bounds.
+//! \note Leaves may hold several primitives so callers should test the bounds
+//! of the primitive itself if an exact result is required.
+//! \param hierarchy The hierarchy to traverse.
+//! \param bounds The bounds to test.
+//! \param fn Callable with the signature `void(int32_t primitive)`.
+template<typename T, typename Fn>
+void bvh_query_aabb(
+  const bvh_t<T>& hierarchy, const aabb_t<T>& bounds, Fn&& fn);
+
+} // namespace as
+
+#include "as-bvh.inl"
@@ -0,0 +1,320 @@
+namespace as
+{
+
+namespace internal
+{
+
+AS_API constexpr int32_t count_leading_zeros(uint64_t v)
+{
+  if (v == 0) {
+    return 64;
+  }
+  int32_t count = 0;
+  for (int32_t shift = 32; shift > 0; shift >>= 1) {
+    if ((v >> (64 - shift)) == 0) {
+      count += shift;
+      v <<= shift;
+    }
+  }
+  return count;
+}
+
+// ref: Tero Karras (2012) Maximizing Parallelism in the Construction of BVHs,
+// Octrees, and k-d Trees
+// returns the index of the first code in the second half of [first, last)
+// (the first code with the highest differing bit of the range set)
+AS_API inline index bvh_find_split(
+  const uint64_t* codes, const index first, const index last)
+{
+  const uint64_t first_code = codes[first];
+  const uint64_t last_code = codes[last - 1];
+  if (first_code == last_code) {
+    return (first + last) / 2;
+  }
+  const int32_t common_prefix = count_leading_zeros(first_code ^ last_code);
+  // codes[lo] shares more than the common prefix with the first code,
+  // codes[hi] does not
+  index lo = first;
+  index hi = last - 1;
+  while (hi - lo > 1) {
+    const index mid = lo + (hi - lo) / 2;
+    if (count_leading_zeros(first_code ^ codes[mid]) > common_prefix) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  return hi;
+}
+
+template<typename T>
+struct bvh_build_t
+{
+  const aabb_t<T>* bounds;
+  const uint64_t* codes;
+  const int32_t* primitives;
+  index max_leaf_size;
+};
+
+// builds the subtree of [first, last) in depth first order appending to nodes
+// (internal node offsets are relative to the start of nodes)
+template<typename T>
+AS_API aabb_t<T> bvh_build_subtree(
+  const bvh_build_t<T>& build, const index first, const index last,
+  std::vector<bvh_node_t<T>>& nodes)
+{
+  const auto node = static_cast<index>(nodes.size());
+  nodes.emplace_back();
+  if (last - first <= build.max_leaf_size) {
+    aabb_t<T> bounds = aabb_t<T>::empty();
+    for (index i = first; i < last; ++i) {
+      bounds = aabb_merge(bounds, build.bounds[build.primitives[i]]);
+    }
+    nodes[node] = {bounds, int32_t(first), int32_t(last - first)};
+    return bounds;
+  }
+  const index split = bvh_find_split(build.codes, first, last);
+  const aabb_t<T> left = bvh_build_subtree(build, first, split, nodes);
+  const auto second = static_cast<int32_t>(nodes.size());
+  const aabb_t<T> right = bvh_build_subtree(build, split, last, nodes);
+  nodes[node] = {aabb_merge(left, right), second, 0};
+  return nodes[node].bounds;
+}
+
+// splits [first, last) until ranges are small enough to be built as one unit
+template<typename T>
+AS_API void bvh_collect_subtrees(
+  const bvh_build_t<T>& build, const index first, const index last,
+  std::vector<index>& subtree_firsts)
+{
+  if (last - first <= k_bvh_subtree_size) {
+    subtree_firsts.push_back(first);
+    return;
+  }
+  const index split = bvh_find_split(build.codes, first, last);
+  bvh_collect_subtrees(build, first, split, subtree_firsts);
+  bvh_collect_subtrees(build, split, last, subtree_firsts);
+}
+
+// emits the top of the hierarchy (mirroring bvh_collect_subtrees) reserving
+// space for each subtree and recording where it should be copied
+template<typename T>
+AS_API aabb_t<T> bvh_build_top(
+  const bvh_build_t<T>& build, const index first, const index last,
+  const std::vector<std::vector<bvh_node_t<T>>>& subtrees, index& subtree,
+  std::vector<index>& subtree_offsets, std::vector<bvh_node_t<T>>& nodes)
+{
+  if (last - first <= k_bvh_subtree_size) {
+    subtree_offsets[subtree] = static_cast<index>(nodes.size());
+    nodes.resize(nodes.size() + subtrees[subtree].size());
+    return subtrees[subtree++].front().bounds;
+  }
+  const auto node = static_cast<index>(nodes.size());
+  nodes.emplace_back();
+  const index split = bvh_find_split(build.codes, first, last);
+  const aabb_t<T> left = bvh_build_top(
+    build, first, split, subtrees, subtree, subtree_offsets, nodes);
+  const auto second = static_cast<int32_t>(nodes.size());
+  const aabb_t<T> right = bvh_build_top(
+    build, split, last, subtrees, subtree, subtree_offsets, nodes);
+  nodes[node] = {aabb_merge(left, right), second, 0};
+  return nodes[node].bounds;
+}
+
+template<typename T>
+struct bvh_stack_entry_t
+{
+  int32_t node;
+  T entry;
+};
+
+} // namespace internal
+
+template<typename T, typename Executor>
+AS_API bvh_t<T> bvh_build(
+  const aabb_t<T>* bounds, const index count, const int32_t max_leaf_size,
+  const Executor& executor)
+{
+  bvh_t<T> hierarchy;
+  if (count == 0) {
+    return hierarchy;
+  }
+
+  std::vector<vec<T, 3>> centroids(count);
+  executor(chunk_count(count, k_bvh_chunk_size), [&](const index chunk) {
+    const index end = chunk_end(chunk, count, k_bvh_chunk_size);
+    for (index i = chunk_begin(chunk, k_bvh_chunk_size); i < end; ++i) {
+      centroids[i] = aabb_center(bounds[i]);
+    }
+  });
+
+  vec<T, 3> min;
+  vec<T, 3> max;
+  std::tie(min, max) =
+    vec_min_max_chunked(centroids.data(), count, executor);
+
+  // centroids in a plane (or a single centroid) have bounds with no extent
+  // along an axis, vec_quantize puts every centroid in cell 0 along it
+  std::vector<uint64_t> codes(count);
+  morton_encode_positions(
+    centroids.data(), count, min, max, codes.data(), executor);
+
+  hierarchy.primitives.resize(count);
+  std::iota(hierarchy.primitives.begin(), hierarchy.primitives.end(), 0);
+  radix_sort(codes.data(), hierarchy.primitives.data(), count, 63, executor);
+
+  const internal::bvh_build_t<T> build{
+    bounds, codes.data(), hierarchy.primitives.data(), max_leaf_size};
+
+  std::vector<index> subtree_firsts;
+  internal::bvh_collect_subtrees(build, 0, count, subtree_firsts);
+  const auto subtree_count = static_cast<index>(subtree_firsts.size());
+
+  std::vector<std::vector<bvh_node_t<T>>> subtrees(subtree_count);
+  executor(subtree_count, [&](const index subtree) {
+    const index last =
+      subtree + 1 < subtree_count ? subtree_firsts[subtree + 1] : count;
+    internal::bvh_build_subtree(
+      build, subtree_firsts[subtree], last, subtrees[subtree]);
+  });
+
+  std::vector<index> subtree_offsets(subtree_count);
+  index next_subtree = 0;
+  internal::bvh_build_top(
+    build, 0, count, subtrees, next_subtree, subtree_offsets, hierarchy.nodes);
+
+  executor(subtree_count, [&](const index subtree) {
+    const index offset = subtree_offsets[subtree];
+    const auto& nodes = subtrees[subtree];
+    const auto size = static_cast<index>(nodes.size());
+    for (index i = 0; i < size; ++i) {
+      bvh_node_t<T> node = nodes[i];
+      if (node.count == 0) {
+        node.offset += static_cast<int32_t>(offset);
+      }
+      hierarchy.nodes[offset + i] = node;
+    }
+  });
+
+  return hierarchy;
+}
+
+template<typename T, typename Fn>
+AS_API void bvh_intersect_ray(
+  const bvh_t<T>& hierarchy, const vec<T, 3>& origin,
+  const vec<T, 3>& inv_direction, T max_distance, Fn&& fn)
+{
+  if (hierarchy.nodes.empty()) {
+    return;
+  }
+
+  T entry;
+  if (!internal::ray_aabb_slab(
+        hierarchy.nodes.front().bounds, origin, inv_direction, max_distance,
+        entry)) {
+    return;
+  }
+
+  internal::bvh_stack_entry_t<T> stack[k_bvh_stack_size];
+  index top = 0;
+  int32_t node = 0;
+  for (;;) {
+    const bvh_node_t<T>& current = hierarchy.nodes[node];
+    if (current.count > 0) {
+      for (int32_t i = current.offset, end = current.offset + current.count;
+           i < end; ++i) {
+        max_distance = fn(hierarchy.primitives[i], max_distance);
+      }
+    } else {
+      const int32_t first = node + 1;
+      const int32_t second = current.offset;
+      T first_entry;
+      T second_entry;
+      const bool first_hit = internal::ray_aabb_slab(
+        hierarchy.nodes[first].bounds, origin, inv_direction, max_distance,
+        first_entry);
+      const bool second_hit = internal::ray_aabb_slab(
+        hierarchy.nodes[second].bounds, origin, inv_direction, max_distance,
+        second_entry);
+      if (first_hit && second_hit) {
+        // visit the closest child first and revisit the other later
+        if (first_entry <= second_entry) {
+          stack[top++] = {second, second_entry};
+          node = first;
+        } else {
+          stack[top++] = {first, first_entry};
+          node = second;
+        }
+        continue;
+      }
+      if (first_hit || second_hit) {
+        node = first_hit ? first : second;
+        continue;
+      }
+    }
+    // skip nodes beyond the closest hit found since they were pushed
+    while (top > 0 && stack[top - 1].entry > max_distance) {
+      --top;
+    }
+    if (top == 0) {
+      break;
+    }
+    node = stack[--top].node;
+  }
+}
+
+template<typename T, typename Fn>
+AS_API void bvh_intersect_ray(
+  const bvh_t<T>& hierarchy, const ray_t<T>& r, const T max_distance,
+  Fn&& fn)
+{
+  bvh_intersect_ray(
+    hierarchy, r.origin, r.inv_direction, max_distance,
+    std::forward<Fn>(fn));
+}
+
+template<typename T, typename Fn>
+AS_API void bvh_query_aabb(
+  const bvh_t<T>& hierarchy, const aabb_t<T>& bounds, Fn&& fn)
+{
+  if (
+    hierarchy.nodes.empty()
+    || !aabb_overlaps(hierarchy.nodes.front().bounds, bounds)) {
+    return;
+  }
+
+  int32_t stack[k_bvh_stack_size];
+  index top = 0;
+  int32_t node = 0;
+  for (;;) {
+    const bvh_node_t<T>& current = hierarchy.nodes[node];
+    if (current.count > 0) {
+      for (int32_t i = current.offset, end = current.offset + current.count;
+           i < end; ++i) {
+        fn(hierarchy.primitives[i]);
+      }
+    } else {
+      const int32_t first = node + 1;
+      const int32_t second = current.offset;
+      const bool first_hit =
+        aabb_overlaps(hierarchy.nodes[first].bounds, bounds);
+      const bool second_hit =
+        aabb_overlaps(hierarchy.nodes[second].bounds, bounds);
+      if (first_hit && second_hit) {
+        stack[top++] = second;
+        node = first;
+        continue;
+      }
+      if (first_hit || second_hit) {
+        node = first_hit ? first : second;
+        continue;
+      }
+    }
+    if (top == 0) {
+      break;
+    }
+    node = stack[--top];
+  }
+}
+
+} // namespace as
@@ -0,0 +1,99 @@
+//! \file
+//! `as-camera`
+
+#pragma once
+
+#include "as-frustum.hpp"
+#include "as-view.hpp"
+
+namespace as
+{
+
+//! Represents a \ref camera (a projection and view with the matrices derived
+//! from them cached).
+//! \note Derived values (the view projection matrix, its inverse, the frustum
+//! and the pixel ray deltas) are computed the first time they are requested
+//! and cached until a setter changes a value they depend on. Changing the
+//! screen dimension for example only invalidates the pixel ray deltas.
+//! \note Derived values are cached by const member functions so a camera must
+//! not be shared between threads without synchronization until every derived
+//! value has been requested once.
+//! \note The free functions in `as-view` remain the stateless equivalent,
+//! results match them exactly.
+class camera
+{
+public:
+  camera() noexcept = default;
+  //! Constructs a camera with the given projection, view, screen dimension and
+  //! depth range.
+  //! \param projection The camera projection matrix.
+  //! \param view The camera view matrix (stored as an affine transformation
+  //! due to axis orthogonality).
+  //! \param screen_dimension The size of the screen/viewport.
+  //! \param depth_range The depth range depending on if depth is mapped from
+  //! 0 to 1 or -1 to 1. Pass either {0, 1} or {-1, 1} (or {1, 0} when the
+  //! projection has been passed to ::reverse_z).
+  camera(
+    const mat4& projection, const affine& view, const vec2i& screen_dimension,
+    const vec2& depth_range);
+
+  //! Sets the projection matrix and the depth range it maps to.
+  void set_projection(const mat4& projection, const vec2& depth_range);
+  //! Sets the view matrix.
+  void set_view(const affine& view);
+  //! Sets the size of the screen/viewport.
+  void set_screen_dimension(const vec2i& screen_dimension);
+
+  //! Returns the projection matrix.
+  const mat4& projection() const;
+  //! Returns the view matrix.
+  const affine& view() const;
+  //! Returns the size of the screen/viewport.
+  const vec2i& screen_dimension() const;
+  //! Returns the depth range of the projection.
+  const vec2& depth_range() const;
+
+  //! Returns the view projection matrix (see ::view_projection).
+  const mat4& view_projection() const;
+  //! Returns the inverse view projection matrix (see
+  //! ::inverse_view_projection).
+  const mat4& inverse_view_projection() const;
+  //! Returns the frustum of the view projection matrix (see
+  //! ::frustum_from_mat4).
+  const frustum& view_frustum() const;
+  //! Returns the pixel ray deltas (see ::pixel_ray_deltas_from_mat4).
+  const pixel_ray_deltas& ray_deltas() const;
+
+  //! Takes a position in world space and transforms it to screen coordinates
+  //! (see ::world_to_screen).
+  vec2i world_to_screen(const vec3& world_position) const;
+  //! Takes a position in screen space and returns it in world space aligned to
+  //! the near clip plane of the camera (see ::screen_to_world).
+  vec3 screen_to_world(const vec2i& screen_position) const;
+
+private:
+  // flags for each cached value needing to be recomputed
+  enum : uint8_t
+  {
+    dirty_view_projection = 1 << 0,
+    dirty_inverse_view_projection = 1 << 1,
+    dirty_frustum = 1 << 2,
+    dirty_ray_deltas = 1 << 3,
+    dirty_all = 0xf
+  };
+
+  mat4 projection_ = mat4::identity();
+  affine view_ = affine::identity();
+  vec2i screen_dimension_ = vec2i::one();
+  vec2 depth_range_ = vec2(0.0_r, 1.0_r);
+
+  mutable mat4 view_projection_{};
+  mutable mat4 inverse_view_projection_{};
+  mutable frustum frustum_{};
+  mutable pixel_ray_deltas ray_deltas_{};
+  mutable uint8_t dirty_ = dirty_all;
+};
+
+} // namespace as
+
+#include "as-camera.inl"
@@ -0,0 +1,104 @@
+namespace as
+{
+
+AS_API inline camera::camera(
+  const mat4& projection, const affine& view, const vec2i& screen_dimension,
+  const vec2& depth_range)
+  : projection_(projection),
+    view_(view),
+    screen_dimension_(screen_dimension),
+    depth_range_(depth_range)
+{
+}
+
+AS_API inline void camera::set_projection(
+  const mat4& projection, const vec2& depth_range)
+{
+  projection_ = projection;
+  depth_range_ = depth_range;
+  dirty_ = dirty_all;
+}
+
+AS_API inline void camera::set_view(const affine& view)
+{
+  view_ = view;
+  dirty_ = dirty_all;
+}
+
+AS_API inline void camera::set_screen_dimension(const vec2i& screen_dimension)
+{
+  screen_dimension_ = screen_dimension;
+  dirty_ |= dirty_ray_deltas;
+}
+
+AS_API inline const mat4& camera::projection() const
+{
+  return projection_;
+}
+
+AS_API inline const affine& camera::view() const
+{
+  return view_;
+}
+
+AS_API inline const vec2i& camera::screen_dimension() const
+{
+  return screen_dimension_;
+}
+
+AS_API inline const vec2& camera::depth_range() const
+{
+  return depth_range_;
+}
+
+AS_API inline const mat4& camera::view_projection() const
+{
+  if ((dirty_ & dirty_view_projection) != 0) {
+    view_projection_ = as::view_projection(view_, projection_);
+    dirty_ &= uint8_t(~dirty_view_projection);
+  }
+  return view_projection_;
+}
+
+AS_API inline const mat4& camera::inverse_view_projection() const
+{
+  if ((dirty_ & dirty_inverse_view_projection) != 0) {
+    inverse_view_projection_ = as::inverse_view_projection(view_, projection_);
+    dirty_ &= uint8_t(~dirty_inverse_view_projection);
+  }
+  return inverse_view_projection_;
+}
+
+AS_API inline const frustum& camera::view_frustum() const
+{
+  if ((dirty_ & dirty_frustum) != 0) {
+    frustum_ = frustum_from_mat4(view_projection(), depth_range_);
+    dirty_ &= uint8_t(~dirty_frustum);
+  }
+  return frustum_;
+}
+
+AS_API inline const pixel_ray_deltas& camera::ray_deltas() const
+{
+  if ((dirty_ & dirty_ray_deltas) != 0) {
+    ray_deltas_ = pixel_ray_deltas_from_mat4(
+      inverse_view_projection(), screen_dimension_, depth_range_);
+    dirty_ &= uint8_t(~dirty_ray_deltas);
+  }
+  return ray_deltas_;
+}
+
+AS_API inline vec2i camera::world_to_screen(const vec3& world_position) const
+{
+  return as::world_to_screen(
+    world_position, view_projection(), screen_dimension_);
+}
+
+AS_API inline vec3 camera::screen_to_world(const vec2i& screen_position) const
+{
+  return as::screen_to_world(
+    screen_position, inverse_view_projection(), screen_dimension_,
+    depth_range_);
+}
+
+} // namespace as
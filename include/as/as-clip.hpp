@@ -0,0 +1,97 @@
+//! \file
+//! `as-clip`
+
+#pragma once
+
+#include "as-math-ops.hpp"
+
+namespace as
+{
+
+//! Bits of a clip space outcode (see ::clip_outcode), one for each plane of
+//! the view volume a position is outside of.
+//! \note Planes are in the same order as the planes of a \ref frustum.
+enum clip_plane_bits : uint8_t
+{
+  clip_left = 1 << 0, //!< Outside the left plane (`x < -w`).
+  clip_right = 1 << 1, //!< Outside the right plane (`x > w`).
+  clip_bottom = 1 << 2, //!< Outside the bottom plane (`y < -w`).
+  clip_top = 1 << 3, //!< Outside the top plane (`y > w`).
+  clip_near = 1 << 4, //!< In front of the near plane.
+  clip_far = 1 << 5 //!< Beyond the far plane.
+};
+
+//! The number of planes a polygon is clipped against.
+constexpr index k_clip_plane_count = 6;
+
+//! The maximum number of vertices of a clipped triangle (each plane adds at
+//! most one vertex).
+constexpr index k_clip_max_vertex_count = 3 + k_clip_plane_count;
+
+//! The maximum number of triangles a clipped triangle is split into.
+constexpr index k_clip_max_triangle_count = k_clip_max_vertex_count - 2;
+
+//! Returns the bitmask of planes (see ::clip_plane_bits) the clip space
+//! position is outside of.
+//! \param clip_position The position in clip space (see ::view_projection).
+//! \param depth_range The normalized device coordinate depth of the near and
+//! far planes. Pass {-1, 1} for OpenGL, {0, 1} for Direct3D, Metal and Vulkan
+//! and {1, 0} when the projection has been passed to ::reverse_z.
+//! \param guard_band How far the left, right, bottom and top planes are
+//! moved out in normalized device coordinates (pass {1, 1} to use the edges
+//! of the screen).
+uint8_t clip_outcode(
+  const vec4& clip_position, const vec2& depth_range,
+  const vec2& guard_band = vec2::one());
+
+//! Clips a convex polygon in clip space against the planes of the view volume
+//! and returns the number of vertices of the clipped polygon (zero if it is
+//! entirely outside).
+//! \note Uses Sutherland–Hodgman clipping in homogeneous coordinates (before
+//! the divide by w) so vertices behind the camera are handled correctly. Only
+//! planes the polygon crosses are clipped against.
+//! \note New vertices are always interpolated from the inside vertex to the
+//! outside vertex of an edge so an edge shared by two polygons is clipped to
+//! exactly the same position in both.
+//! \note No memory is allocated, `clipped` and `scratch` must each have space
+//! for `vertex_count + k_clip_plane_count` elements.
+//! \param vertices The vertices of the polygon in clip space.
+//! \param vertex_count The number of vertices.
+//! \param depth_range The normalized device coordinate depth of the near and
+//! far planes (see ::clip_outcode).
+//! \param guard_band How far the left, right, bottom and top planes are
+//! moved out in normalized device coordinates (see ::clip_outcode).
+//! \param clipped The vertices of the clipped polygon to write to.
+//! \param scratch Temporary storage used while clipping.
+index clip_polygon(
+  const vec4* vertices, index vertex_count, const vec2& depth_range,
+  const vec2& guard_band, vec4* clipped, vec4* scratch);
+
+//! Clips an array of triangles in clip space against the planes of the view
+//! volume, writes the triangles that are inside and returns how many there
+//! are.
+//! \note Triangles entirely outside a plane are rejected and triangles
+//! entirely inside are written unchanged. Other triangles are clipped with
+//! ::clip_polygon and the resulting polygon is split into a fan of triangles.
+//! Triangles are written in the order of the input.
+//! \note No memory is allocated, `clipped_vertices` must have space for
+//! `triangle_count * k_clip_max_triangle_count * 3` elements and
+//! `clipped_triangles` for `triangle_count * k_clip_max_triangle_count`
+//! elements.
+//! \param vertices Three vertices in clip space for each triangle.
+//! \param triangle_count The number of triangles.
+//! \param depth_range The normalized device coordinate depth of the near and
+//! far planes (see ::clip_outcode).
+//! \param guard_band How far the left, right, bottom and top planes are
+//! moved out in normalized device coordinates (see ::clip_outcode).
+//! \param clipped_vertices Three vertices for each triangle written.
+//! \param clipped_triangles The index of the input triangle each triangle
+//! written came from.
+index clip_triangles(
+  const vec4* vertices, index triangle_count, const vec2& depth_range,
+  const vec2& guard_band, vec4* clipped_vertices,
+  uint32_t* clipped_triangles);
+
+} // namespace as
+
+#include "as-clip.inl"
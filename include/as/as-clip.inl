@@ -0,0 +1,132 @@
+namespace as
+{
+
+namespace internal
+{
+
+// returns the coefficients of a clip plane (dot(plane, clip) is positive
+// inside)
+AS_API inline vec4 clip_plane(
+  const index plane, const vec2& depth_range, const vec2& guard_band)
+{
+  // depth increases away from the camera unless reversed
+  const real depth_sign = depth_range.y > depth_range.x ? 1.0_r : -1.0_r;
+  switch (plane) {
+    case 0:
+      return vec4(1.0_r, 0.0_r, 0.0_r, guard_band.x);
+    case 1:
+      return vec4(-1.0_r, 0.0_r, 0.0_r, guard_band.x);
+    case 2:
+      return vec4(0.0_r, 1.0_r, 0.0_r, guard_band.y);
+    case 3:
+      return vec4(0.0_r, -1.0_r, 0.0_r, guard_band.y);
+    case 4:
+      return vec4(0.0_r, 0.0_r, depth_sign, -depth_sign * depth_range.x);
+    default:
+      return vec4(0.0_r, 0.0_r, -depth_sign, depth_sign * depth_range.y);
+  }
+}
+
+} // namespace internal
+
+AS_API inline uint8_t clip_outcode(
+  const vec4& clip_position, const vec2& depth_range, const vec2& guard_band)
+{
+  uint8_t outcode = 0;
+  for (index plane = 0; plane < k_clip_plane_count; ++plane) {
+    const vec4 coefficients =
+      internal::clip_plane(plane, depth_range, guard_band);
+    outcode |= uint8_t(
+      uint8_t(vec_dot(coefficients, clip_position) < 0.0_r) << plane);
+  }
+  return outcode;
+}
+
+// ref: Ivan Sutherland, Gary Hodgman (1974) Reentrant Polygon Clipping
+AS_API inline index clip_polygon(
+  const vec4* vertices, const index vertex_count, const vec2& depth_range,
+  const vec2& guard_band, vec4* clipped, vec4* scratch)
+{
+  // clip from the input to scratch and then between scratch and clipped
+  const vec4* source = vertices;
+  vec4* destination = scratch;
+  index count = vertex_count;
+  for (index plane = 0; plane < k_clip_plane_count && count > 0; ++plane) {
+    const vec4 coefficients =
+      internal::clip_plane(plane, depth_range, guard_band);
+    bool crossed = false;
+    for (index i = 0; i < count; ++i) {
+      crossed |= vec_dot(coefficients, source[i]) < 0.0_r;
+    }
+    if (!crossed) {
+      continue;
+    }
+    index clipped_count = 0;
+    for (index i = 0; i < count; ++i) {
+      const vec4& current = source[i];
+      const vec4& next = source[(i + 1) % count];
+      const real current_distance = vec_dot(coefficients, current);
+      const real next_distance = vec_dot(coefficients, next);
+      const bool current_inside = current_distance >= 0.0_r;
+      if (current_inside) {
+        destination[clipped_count++] = current;
+      }
+      if (current_inside != (next_distance >= 0.0_r)) {
+        // interpolate from the inside vertex so shared edges match
+        destination[clipped_count++] =
+          current_inside
+            ? vec_mix(
+                current, next,
+                current_distance / (current_distance - next_distance))
+            : vec_mix(
+                next, current,
+                next_distance / (next_distance - current_distance));
+      }
+    }
+    count = clipped_count;
+    source = destination;
+    destination = destination == scratch ? clipped : scratch;
+  }
+  if (source != clipped) {
+    std::copy(source, source + count, clipped);
+  }
+  return count;
+}
+
+AS_API inline index clip_triangles(
+  const vec4* vertices, const index triangle_count, const vec2& depth_range,
+  const vec2& guard_band, vec4* clipped_vertices,
+  uint32_t* clipped_triangles)
+{
+  index clipped_count = 0;
+  for (index t = 0; t < triangle_count; ++t) {
+    const vec4* triangle = vertices + t * 3;
+    const uint8_t outcode0 = clip_outcode(triangle[0], depth_range, guard_band);
+    const uint8_t outcode1 = clip_outcode(triangle[1], depth_range, guard_band);
+    const uint8_t outcode2 = clip_outcode(triangle[2], depth_range, guard_band);
+    // entirely outside one plane
+    if ((outcode0 & outcode1 & outcode2) != 0) {
+      continue;
+    }
+    // entirely inside every plane
+    if ((outcode0 | outcode1 | outcode2) == 0) {
+      std::copy(triangle, triangle + 3, clipped_vertices + clipped_count * 3);
+      clipped_triangles[clipped_count++] = uint32_t(t);
+      continue;
+    }
+    vec4 polygon[k_clip_max_vertex_count];
+    vec4 scratch[k_clip_max_vertex_count];
+    const index vertex_count =
+      clip_polygon(triangle, 3, depth_range, guard_band, polygon, scratch);
+    for (index v = 2; v < vertex_count; ++v) {
+      vec4* out = clipped_vertices + clipped_count * 3;
+      out[0] = polygon[0];
+      out[1] = polygon[v - 1];
+      out[2] = polygon[v];
+      clipped_triangles[clipped_count++] = uint32_t(t);
+    }
+  }
+  return clipped_count;
+}
+
+} // namespace as
@@ -0,0 +1,146 @@
+//! \file
+//! `as-curve`
+
+#pragma once
+
+#include <vector>
+
+#include "as-math-ops.hpp"
+
+namespace as
+{
+
+//! Represents a \ref cubic_curve_t (a cubic polynomial curve).
+//! \note The curve is stored in the power basis
+//! (`c0 + c1 * t + c2 * t^2 + c3 * t^3`) so evaluating it is three multiply
+//! adds per component in Horner form (repeated ::vec_mix of the control
+//! points with De Casteljau's algorithm costs about three times as much).
+//! \note Create from control points with ::cubic_curve_from_bezier,
+//! ::cubic_curve_from_hermite or ::cubic_curve_from_catmull_rom.
+template<typename T, index d>
+struct cubic_curve_t
+{
+  vec<T, d> c0; //!< The constant coefficient (the position at `t = 0`).
+  vec<T, d> c1; //!< The linear coefficient (the derivative at `t = 0`).
+  vec<T, d> c2; //!< The quadratic coefficient.
+  vec<T, d> c3; //!< The cubic coefficient.
+};
+
+//! Type alias for a two dimensional cubic curve of type \ref real.
+using cubic_curve2 = cubic_curve_t<real, 2>;
+//! Type alias for a three dimensional cubic curve of type \ref real.
+using cubic_curve3 = cubic_curve_t<real, 3>;
+
+//! Represents an \ref arc_length_table_t (the arc length of a
+//! \ref cubic_curve_t at evenly spaced parameters).
+//! \note Used to sample a curve at a constant speed without solving for the
+//! parameter of each sample (see ::cubic_curve_evaluate_constant_speed).
+//! \note Create with ::cubic_curve_arc_length_table.
+template<typename T>
+struct arc_length_table_t
+{
+  //! The length of the curve from `t = 0` to `t = i / (lengths.size() - 1)`
+  //! at each `i`.
+  std::vector<T> lengths;
+};
+
+//! Type alias for an arc length table of type \ref real.
+using arc_length_table = arc_length_table_t<real>;
+
+//! Returns the \ref cubic_curve_t of a cubic Bezier curve.
+//! \param p0 The start point.
+//! \param p1 The first control point.
+//! \param p2 The second control point.
+//! \param p3 The end point.
+template<typename T, index d>
+constexpr cubic_curve_t<T, d> cubic_curve_from_bezier(
+  const vec<T, d>& p0, const vec<T, d>& p1, const vec<T, d>& p2,
+  const vec<T, d>& p3);
+
+//! Returns the \ref cubic_curve_t of a cubic Hermite curve.
+//! \param p0 The start point.
+//! \param m0 The tangent at the start point.
+//! \param p1 The end point.
+//! \param m1 The tangent at the end point.
+template<typename T, index d>
+constexpr cubic_curve_t<T, d> cubic_curve_from_hermite(
+  const vec<T, d>& p0, const vec<T, d>& m0, const vec<T, d>& p1,
+  const vec<T, d>& m1);
+
+//! Returns the \ref cubic_curve_t of the segment of a (uniform) Catmull-Rom
+//! spline between `p1` and `p2`.
+//! \note The tangent at each point is half the vector between its
+//! neighbors.
+template<typename T, index d>
+constexpr cubic_curve_t<T, d> cubic_curve_from_catmull_rom(
+  const vec<T, d>& p0, const vec<T, d>& p1, const vec<T, d>& p2,
+  const vec<T, d>& p3);
+
+//! Returns the position on the \ref cubic_curve_t at `t`.
+//! \note `t` should be in the range `[0-1]`.
+template<typename T, index d>
+constexpr vec<T, d> cubic_curve_evaluate(const cubic_curve_t<T, d>& curve, T t);
+
+//! Writes the position on the \ref cubic_curve_t at each `t` to `positions`.
+//! \note `positions` must have space for at least `count` elements.
+template<typename T, index d>
+void cubic_curve_evaluate(
+  const cubic_curve_t<T, d>& curve, const T* ts, index count,
+  vec<T, d>* positions);
+
+//! Writes `count` positions on the \ref cubic_curve_t at evenly spaced `t`
+//! from `0` to `1` (inclusive) to `positions`.
+//! \note Uses forward differencing, each position after the first is three
+//! additions per component. Rounding errors accumulate with each step, for
+//! `float` prefer ::cubic_curve_evaluate beyond a few thousand samples.
+//! \note `positions` must have space for at least `count` elements.
+template<typename T, index d>
+void cubic_curve_evaluate_uniform(
+  const cubic_curve_t<T, d>& curve, index count, vec<T, d>* positions);
+
+//! Returns the first derivative (the tangent) of the \ref cubic_curve_t at
+//! `t`.
+template<typename T, index d>
+constexpr vec<T, d> cubic_curve_derivative(
+  const cubic_curve_t<T, d>& curve, T t);
+
+//! Returns the second derivative of the \ref cubic_curve_t at `t`.
+template<typename T, index d>
+constexpr vec<T, d> cubic_curve_second_derivative(
+  const cubic_curve_t<T, d>& curve, T t);
+
+//! Returns the \ref arc_length_table_t of the \ref cubic_curve_t.
+//! \note The length of each interval is integrated with three point
+//! Gauss-Legendre quadrature of the speed of the curve.
+//! \param curve The curve to measure.
+//! \param interval_count The number of intervals (the table has
+//! `interval_count + 1` lengths), values less than one are treated as one.
+template<typename T, index d>
+arc_length_table_t<T> cubic_curve_arc_length_table(
+  const cubic_curve_t<T, d>& curve, index interval_count);
+
+//! Returns the parameter `t` at which the length of the curve is `distance`.
+//! \note The interval is found with a binary search and `t` is interpolated
+//! linearly within it, `distance` is clamped to the length of the curve.
+//! \note The error of linear interpolation falls with the square of the
+//! number of intervals, use more where the speed of the curve changes
+//! quickly.
+//! \note The table must have at least two lengths (as built by
+//! ::cubic_curve_arc_length_table).
+template<typename T>
+T arc_length_param_from_distance(
+  const arc_length_table_t<T>& table, T distance);
+
+//! Writes `count` positions on the \ref cubic_curve_t evenly spaced by arc
+//! length from the start to the end (inclusive) to `positions`.
+//! \note The distances increase so the table is walked forward once
+//! (see ::arc_length_param_from_distance).
+//! \note `positions` must have space for at least `count` elements.
+template<typename T, index d>
+void cubic_curve_evaluate_constant_speed(
+  const cubic_curve_t<T, d>& curve, const arc_length_table_t<T>& table,
+  index count, vec<T, d>* positions);
+
+} // namespace as
+
+#include "as-curve.inl"
@@ -0,0 +1,165 @@
+namespace as
+{
+
+namespace internal
+{
+
+// returns the parameter at distance within the interval of the table
+template<typename T>
+AS_API T arc_length_interval_param(
+  const arc_length_table_t<T>& table, const index interval, const T distance)
+{
+  const T begin = table.lengths[interval];
+  const T width = table.lengths[interval + 1] - begin;
+  const T ratio =
+    width > T(0.0) ? clamp((distance - begin) / width, T(0.0), T(1.0))
+                   : T(0.0);
+  return (T(interval) + ratio) / T(table.lengths.size() - 1);
+}
+
+} // namespace internal
+
+template<typename T, index d>
+AS_API constexpr cubic_curve_t<T, d> cubic_curve_from_bezier(
+  const vec<T, d>& p0, const vec<T, d>& p1, const vec<T, d>& p2,
+  const vec<T, d>& p3)
+{
+  return {
+    p0, (p1 - p0) * T(3.0), (p0 - p1 * T(2.0) + p2) * T(3.0),
+    p3 - p0 + (p1 - p2) * T(3.0)};
+}
+
+template<typename T, index d>
+AS_API constexpr cubic_curve_t<T, d> cubic_curve_from_hermite(
+  const vec<T, d>& p0, const vec<T, d>& m0, const vec<T, d>& p1,
+  const vec<T, d>& m1)
+{
+  return {
+    p0, m0, (p1 - p0) * T(3.0) - m0 * T(2.0) - m1,
+    (p0 - p1) * T(2.0) + m0 + m1};
+}
+
+template<typename T, index d>
+AS_API constexpr cubic_curve_t<T, d> cubic_curve_from_catmull_rom(
+  const vec<T, d>& p0, const vec<T, d>& p1, const vec<T, d>& p2,
+  const vec<T, d>& p3)
+{
+  return cubic_curve_from_hermite(
+    p1, (p2 - p0) * T(0.5), p2, (p3 - p1) * T(0.5));
+}
+
+template<typename T, index d>
+AS_API constexpr vec<T, d> cubic_curve_evaluate(
+  const cubic_curve_t<T, d>& curve, const T t)
+{
+  return ((curve.c3 * t + curve.c2) * t + curve.c1) * t + curve.c0;
+}
+
+template<typename T, index d>
+AS_API void cubic_curve_evaluate(
+  const cubic_curve_t<T, d>& curve, const T* ts, const index count,
+  vec<T, d>* positions)
+{
+  for (index i = 0; i < count; ++i) {
+    positions[i] = cubic_curve_evaluate(curve, ts[i]);
+  }
+}
+
+// ref: Foley et al. (1990) Computer Graphics: Principles and Practice
+template<typename T, index d>
+AS_API void cubic_curve_evaluate_uniform(
+  const cubic_curve_t<T, d>& curve, const index count, vec<T, d>* positions)
+{
+  if (count <= 0) {
+    return;
+  }
+  const T h = count > 1 ? T(1.0) / T(count - 1) : T(0.0);
+  const T h2 = h * h;
+  const T h3 = h2 * h;
+  // the first, second and third differences of the positions at t = 0
+  vec<T, d> position = curve.c0;
+  vec<T, d> delta1 = curve.c1 * h + curve.c2 * h2 + curve.c3 * h3;
+  vec<T, d> delta2 = curve.c2 * (T(2.0) * h2) + curve.c3 * (T(6.0) * h3);
+  const vec<T, d> delta3 = curve.c3 * (T(6.0) * h3);
+  for (index i = 0; i < count; ++i) {
+    positions[i] = position;
+    position += delta1;
+    delta1 += delta2;
+    delta2 += delta3;
+  }
+}
+
+template<typename T, index d>
+AS_API constexpr vec<T, d> cubic_curve_derivative(
+  const cubic_curve_t<T, d>& curve, const T t)
+{
+  return (curve.c3 * (T(3.0) * t) + curve.c2 * T(2.0)) * t + curve.c1;
+}
+
+template<typename T, index d>
+AS_API constexpr vec<T, d> cubic_curve_second_derivative(
+  const cubic_curve_t<T, d>& curve, const T t)
+{
+  return curve.c3 * (T(6.0) * t) + curve.c2 * T(2.0);
+}
+
+template<typename T, index d>
+AS_API arc_length_table_t<T> cubic_curve_arc_length_table(
+  const cubic_curve_t<T, d>& curve, const index requested_interval_count)
+{
+  // at least one interval so the table always has a start and end length
+  const index interval_count = std::max(requested_interval_count, index(1));
+
+  // three point Gauss-Legendre nodes and weights on [-1, 1]
+  const T node = std::sqrt(T(0.6));
+  const T nodes[] = {-node, T(0.0), node};
+  const T weights[] = {T(5.0) / T(9.0), T(8.0) / T(9.0), T(5.0) / T(9.0)};
+
+  arc_length_table_t<T> table;
+  table.lengths.assign(interval_count + 1, T(0.0));
+  const T half_width = T(0.5) / T(interval_count);
+  for (index i = 0; i < interval_count; ++i) {
+    const T middle = (T(i) + T(0.5)) / T(interval_count);
+    T length = T(0.0);
+    for (index n = 0; n < 3; ++n) {
+      length += weights[n]
+              * T(vec_length(
+                cubic_curve_derivative(curve, middle + nodes[n] * half_width)));
+    }
+    table.lengths[i + 1] = table.lengths[i] + length * half_width;
+  }
+  return table;
+}
+
+template<typename T>
+AS_API T arc_length_param_from_distance(
+  const arc_length_table_t<T>& table, const T distance)
+{
+  // the last interval that starts at or before the distance
+  const auto upper = std::upper_bound(
+    table.lengths.begin() + 1, table.lengths.end() - 1, distance);
+  return internal::arc_length_interval_param(
+    table, index(upper - table.lengths.begin()) - 1, distance);
+}
+
+template<typename T, index d>
+AS_API void cubic_curve_evaluate_constant_speed(
+  const cubic_curve_t<T, d>& curve, const arc_length_table_t<T>& table,
+  const index count, vec<T, d>* positions)
+{
+  const auto interval_count = index(table.lengths.size()) - 1;
+  const T spacing =
+    count > 1 ? table.lengths.back() / T(count - 1) : T(0.0);
+  index interval = 0;
+  for (index i = 0; i < count; ++i) {
+    const T distance = T(i) * spacing;
+    while (interval < interval_count - 1
+           && table.lengths[interval + 1] <= distance) {
+      ++interval;
+    }
+    positions[i] = cubic_curve_evaluate(
+      curve, internal::arc_length_interval_param(table, interval, distance));
+  }
+}
+
+} // namespace as
@@ -0,0 +1,136 @@
+//! \file
+//! `as-dual-quat`
+
+#pragma once
+
+#include "as-math-ops.hpp"
+
+namespace as
+{
+
+//! Represents a \ref dual_quat (a rigid transformation stored as a dual
+//! quaternion).
+//! \note The real part is the rotation and the dual part is half the
+//! translation multiplied by the rotation (`0.5 * t * r`). Unlike a
+//! \ref rigid the rotation and translation are combined, so dual quaternions
+//! can be blended with a weighted sum and normalized (no rotation of the
+//! translation is required).
+template<typename T>
+struct dual_quat_t
+{
+  dual_quat_t() noexcept = default;
+
+  //! Constructs a dual quaternion with `(real_part_, dual_part_)`.
+  constexpr dual_quat_t(
+    const quat_t<T>& real_part_, const quat_t<T>& dual_part_);
+
+  //! Returns an identity dual quaternion (identity transform).
+  constexpr static dual_quat_t identity();
+
+  //! Returns `8`.
+  constexpr static index size();
+
+  quat_t<T> real_part; //!< The rotation.
+  quat_t<T> dual_part; //!< The translation (multiplied by the rotation).
+};
+
+//! Type alias for a dual quaternion of type ::real.
+using dual_quat = dual_quat_t<real>;
+//! Type alias for a dual quaternion of type float.
+using dual_quatf = dual_quat_t<float>;
+//! Type alias for a dual quaternion of type double.
+using dual_quatd = dual_quat_t<double>;
+
+//! Returns the sum of two dual quaternions.
+template<typename T>
+constexpr dual_quat_t<T> operator+(
+  const dual_quat_t<T>& lhs, const dual_quat_t<T>& rhs);
+
+//! Returns the negation of the dual quaternion.
+//! \note Represents the same transformation.
+template<typename T>
+constexpr dual_quat_t<T> operator-(const dual_quat_t<T>& dq);
+
+//! Returns a dual quaternion multiplied by a scalar quantity.
+template<typename T>
+constexpr dual_quat_t<T> operator*(const dual_quat_t<T>& lhs, T rhs);
+
+//! Returns a \ref dual_quat from a \ref rigid.
+template<typename T>
+dual_quat_t<T> dual_quat_from_rigid(const rigid_t<T>& r);
+
+//! Returns a \ref rigid from a \ref dual_quat.
+//! \note The real part is normalized.
+template<typename T>
+rigid_t<T> rigid_from_dual_quat(const dual_quat_t<T>& dq);
+
+//! Returns a \ref dual_quat from a ::mat4.
+//! \note The ::mat3 part of the ::mat4 must be a valid rotation matrix.
+template<typename T>
+dual_quat_t<T> dual_quat_from_mat4(const mat<T, 4>& m);
+
+//! Returns a ::mat4 from a \ref dual_quat.
+template<typename T>
+mat<T, 4> mat4_from_dual_quat(const dual_quat_t<T>& dq);
+
+//! Returns the result of two \ref dual_quat types multiplied together.
+//! \note `lhs` is performed first, then `rhs` (the same as ::rigid_mul).
+template<typename T>
+constexpr dual_quat_t<T> dual_quat_mul(
+  const dual_quat_t<T>& lhs, const dual_quat_t<T>& rhs);
+
+//! Returns the conjugate of the dual quaternion (the quaternion conjugate of
+//! both parts).
+//! \note This is the inverse if the dual quaternion is normalized.
+template<typename T>
+constexpr dual_quat_t<T> dual_quat_conjugate(const dual_quat_t<T>& dq);
+
+//! Returns the inverse of the dual quaternion.
+//! ```{.cpp}
+//! // dq * inv(dq) = identity
+//! ```
+template<typename T>
+dual_quat_t<T> dual_quat_inverse(const dual_quat_t<T>& dq);
+
+//! Returns the input dual quaternion normalized.
+//! \note Both parts are divided by the length of the real part and the part
+//! of the dual part parallel to the real part is removed, so the result is a
+//! valid rigid transformation (e.g. after blending).
+template<typename T>
+dual_quat_t<T> dual_quat_normalize(const dual_quat_t<T>& dq);
+
+//! Returns if two dual quaternions are the same as each other (within a
+//! certain tolerance).
+template<typename T>
+bool dual_quat_near(
+  const dual_quat_t<T>& lhs, const dual_quat_t<T>& rhs,
+  real max_diff = std::numeric_limits<float>::epsilon(),
+  real max_rel_diff = std::numeric_limits<float>::epsilon());
+
+//! Returns the input direction transformed by the \ref dual_quat.
+//! \note The dual quaternion must be normalized.
+template<typename T>
+vec<T, 3> dual_quat_transform_dir(
+  const dual_quat_t<T>& dq, const vec<T, 3>& direction);
+
+//! Returns the input position transformed by the \ref dual_quat.
+//! \note The dual quaternion must be normalized.
+template<typename T>
+vec<T, 3> dual_quat_transform_pos(
+  const dual_quat_t<T>& dq, const vec<T, 3>& position);
+
+//! Returns the result of a screw linear interpolation between the two dual
+//! quaternions by ratio `t`.
+//! \note The relative transformation is a rotation about and translation
+//! along a single axis (a screw motion), the angle and distance are both
+//! scaled by `t` so the rotation and translation change at a constant rate
+//! (the rigid equivalent of ::quat_slerp). The shortest path is taken.
+//! \note `t` should be in the range `[0-1]`, both dual quaternions must be
+//! normalized.
+template<typename T>
+dual_quat_t<T> dual_quat_sclerp(
+  const dual_quat_t<T>& dq0, const dual_quat_t<T>& dq1, T t);
+
+} // namespace as
+
+#include "as-dual-quat.inl"
@@ -0,0 +1,173 @@
+namespace as
+{
+
+template<typename T>
+AS_API constexpr dual_quat_t<T>::dual_quat_t(
+  const quat_t<T>& real_part_, const quat_t<T>& dual_part_)
+  : real_part(real_part_), dual_part(dual_part_)
+{
+}
+
+template<typename T>
+AS_API constexpr dual_quat_t<T> dual_quat_t<T>::identity()
+{
+  return {quat_t<T>::identity(), quat_t<T>(T(0.0), T(0.0), T(0.0), T(0.0))};
+}
+
+template<typename T>
+AS_API constexpr index dual_quat_t<T>::size()
+{
+  return 8;
+}
+
+template<typename T>
+AS_API constexpr dual_quat_t<T> operator+(
+  const dual_quat_t<T>& lhs, const dual_quat_t<T>& rhs)
+{
+  return {lhs.real_part + rhs.real_part, lhs.dual_part + rhs.dual_part};
+}
+
+template<typename T>
+AS_API constexpr dual_quat_t<T> operator-(const dual_quat_t<T>& dq)
+{
+  return {-dq.real_part, -dq.dual_part};
+}
+
+template<typename T>
+AS_API constexpr dual_quat_t<T> operator*(const dual_quat_t<T>& lhs, T rhs)
+{
+  return {lhs.real_part * rhs, lhs.dual_part * rhs};
+}
+
+template<typename T>
+AS_API dual_quat_t<T> dual_quat_from_rigid(const rigid_t<T>& r)
+{
+  const quat_t<T> translation(T(0.0), r.translation);
+  return {r.rotation, translation * r.rotation * T(0.5)};
+}
+
+template<typename T>
+AS_API rigid_t<T> rigid_from_dual_quat(const dual_quat_t<T>& dq)
+{
+  const T inv_length = T(1.0) / quat_length(dq.real_part);
+  const quat_t<T> rotation = dq.real_part * inv_length;
+  const quat_t<T> translation =
+    dq.dual_part * inv_length * quat_conjugate(rotation) * T(2.0);
+  return rigid_t<T>(
+    rotation, vec<T, 3>(translation.x, translation.y, translation.z));
+}
+
+template<typename T>
+AS_API dual_quat_t<T> dual_quat_from_mat4(const mat<T, 4>& m)
+{
+  return dual_quat_from_rigid(rigid_from_mat4(m));
+}
+
+template<typename T>
+AS_API mat<T, 4> mat4_from_dual_quat(const dual_quat_t<T>& dq)
+{
+  return mat4_from_rigid(rigid_from_dual_quat(dq));
+}
+
+template<typename T>
+AS_API constexpr dual_quat_t<T> dual_quat_mul(
+  const dual_quat_t<T>& lhs, const dual_quat_t<T>& rhs)
+{
+  return {
+    rhs.real_part * lhs.real_part,
+    rhs.real_part * lhs.dual_part + rhs.dual_part * lhs.real_part};
+}
+
+template<typename T>
+AS_API constexpr dual_quat_t<T> dual_quat_conjugate(const dual_quat_t<T>& dq)
+{
+  return {quat_conjugate(dq.real_part), quat_conjugate(dq.dual_part)};
+}
+
+template<typename T>
+AS_API dual_quat_t<T> dual_quat_inverse(const dual_quat_t<T>& dq)
+{
+  // (r + e d)^-1 = r^-1 - e (r^-1 d r^-1) where e^2 = 0
+  const quat_t<T> inv_real = quat_inverse(dq.real_part);
+  return {inv_real, -(inv_real * dq.dual_part * inv_real)};
+}
+
+template<typename T>
+AS_API dual_quat_t<T> dual_quat_normalize(const dual_quat_t<T>& dq)
+{
+  const T inv_length = T(1.0) / quat_length(dq.real_part);
+  const quat_t<T> real_part = dq.real_part * inv_length;
+  const quat_t<T> dual_part = dq.dual_part * inv_length;
+  return {
+    real_part, dual_part - real_part * quat_dot(real_part, dual_part)};
+}
+
+template<typename T>
+AS_API bool dual_quat_near(
+  const dual_quat_t<T>& lhs, const dual_quat_t<T>& rhs,
+  const real max_diff /*= std::numeric_limits<float>::epsilon()*/,
+  const real max_rel_diff /*= std::numeric_limits<float>::epsilon()*/)
+{
+  return quat_near(lhs.real_part, rhs.real_part, max_diff, max_rel_diff)
+      && quat_near(lhs.dual_part, rhs.dual_part, max_diff, max_rel_diff);
+}
+
+template<typename T>
+AS_API vec<T, 3> dual_quat_transform_dir(
+  const dual_quat_t<T>& dq, const vec<T, 3>& direction)
+{
+  return quat_rotate(dq.real_part, direction);
+}
+
+template<typename T>
+AS_API vec<T, 3> dual_quat_transform_pos(
+  const dual_quat_t<T>& dq, const vec<T, 3>& position)
+{
+  const quat_t<T> translation =
+    dq.dual_part * quat_conjugate(dq.real_part) * T(2.0);
+  return quat_rotate(dq.real_part, position)
+       + vec<T, 3>(translation.x, translation.y, translation.z);
+}
+
+// ref: Ladislav Kavan, Steven Collins, Jiri Zara, Carol O'Sullivan (2008)
+// Geometric Skinning with Approximate Dual Quaternion Blending
+template<typename T>
+AS_API dual_quat_t<T> dual_quat_sclerp(
+  const dual_quat_t<T>& dq0, const dual_quat_t<T>& dq1, const T t)
+{
+  // the transformation from dq0 to dq1 (taking the shortest path)
+  const dual_quat_t<T> difference = dual_quat_mul(
+    dual_quat_conjugate(dq0),
+    quat_dot(dq0.real_part, dq1.real_part) < T(0.0) ? -dq1 : dq1);
+  const quat_t<T>& r = difference.real_part;
+  const quat_t<T>& d = difference.dual_part;
+
+  // the screw parameters (half the angle, the axis, the distance along the
+  // axis and the moment of the axis)
+  const T half_angle = std::acos(std::min(std::max(r.w, T(-1.0)), T(1.0)));
+  const T sin_half_angle = std::sin(half_angle);
+  if (sin_half_angle < T(1e-6)) {
+    // (almost) no rotation, only the translation is interpolated
+    return dual_quat_mul(
+      dq0, dual_quat_t<T>(quat_nlerp(quat_t<T>::identity(), r, t), d * t));
+  }
+  const T inv_sin_half_angle = T(1.0) / sin_half_angle;
+  const vec<T, 3> axis = vec<T, 3>(r.x, r.y, r.z) * inv_sin_half_angle;
+  const T distance = T(-2.0) * d.w * inv_sin_half_angle;
+  const vec<T, 3> moment =
+    (vec<T, 3>(d.x, d.y, d.z) - axis * (distance * T(0.5) * r.w))
+    * inv_sin_half_angle;
+
+  // scale the angle and distance of the screw motion
+  const T sin_scaled = std::sin(half_angle * t);
+  const T cos_scaled = std::cos(half_angle * t);
+  const T half_distance = distance * t * T(0.5);
+  const dual_quat_t<T> scaled(
+    quat_t<T>(cos_scaled, axis * sin_scaled),
+    quat_t<T>(
+      -half_distance * sin_scaled,
+      moment * sin_scaled + axis * (half_distance * cos_scaled)));
+  return dual_quat_mul(dq0, scaled);
+}
+
+} // namespace as
@@ -0,0 +1,48 @@
+//! \file
+//! `as-executor`
+
+#pragma once
+
+#include "as-types.hpp"
+
+namespace as
+{
+
+//! An executor that runs all work on the calling thread.
+//! \note An executor is any callable with the signature
+//! `void(index count, const Fn& fn)` that invokes `fn(i)` exactly once for
+//! every `i` in `[0, count)` and only returns once all invocations have
+//! completed. Each invocation writes to separate memory so no further
+//! synchronization is required.
+//! \note Functions accepting an executor split work into chunks that depend
+//! only on the size of the input, never on the executor, so results are
+//! identical whether chunks are run serially or spread across many threads.
+//! ```{.cpp}
+//! // adapt an existing thread pool
+//! auto pool_executor = [&pool](as::index count, const auto& fn) {
+//!   pool.parallel_for(0, count, fn); // blocks until complete
+//! };
+//! as::vec3 centroid =
+//!   as::vec_average_chunked(points, point_count, pool_executor);
+//! ```
+struct serial_executor
+{
+  //! Invokes `fn(i)` for each `i` in `[0, count)` in order.
+  template<typename Fn>
+  void operator()(index count, const Fn& fn) const;
+};
+
+//! Returns the number of chunks of `chunk_size` required to cover `count`
+//! elements.
+constexpr index chunk_count(index count, index chunk_size);
+
+//! Returns the index of the first element in the chunk.
+constexpr index chunk_begin(index chunk, index chunk_size);
+
+//! Returns the index one past the last element in the chunk.
+//! \note The last chunk may be smaller than `chunk_size`.
+constexpr index chunk_end(index chunk, index count, index chunk_size);
+
+} // namespace as
+
+#include "as-executor.inl"
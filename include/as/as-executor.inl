@@ -0,0 +1,28 @@
+namespace as
+{
+
+template<typename Fn>
+AS_API void serial_executor::operator()(const index count, const Fn& fn) const
+{
+  for (index i = 0; i < count; ++i) {
+    fn(i);
+  }
+}
+
+AS_API constexpr index chunk_count(const index count, const index chunk_size)
+{
+  return (count + chunk_size - 1) / chunk_size;
+}
+
+AS_API constexpr index chunk_begin(const index chunk, const index chunk_size)
+{
+  return chunk * chunk_size;
+}
+
+AS_API constexpr index chunk_end(
+  const index chunk, const index count, const index chunk_size)
+{
+  return (chunk + 1) * chunk_size < count ? (chunk + 1) * chunk_size : count;
+}
+
+} // namespace as
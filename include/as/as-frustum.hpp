@@ -0,0 +1,131 @@
+//! \file
+//! `as-frustum`
+
+#pragma once
+
+#include "as-executor.hpp"
+#include "as-math-ops.hpp"
+
+namespace as
+{
+
+//! Represents a \ref frustum (the volume visible to a camera).
+//! \note Each plane is stored as a vec4 `(nx, ny, nz, d)` with the normal
+//! pointing into the frustum, a point `p` is inside a plane when
+//! `dot(n, p) + d >= 0`.
+//! \note Planes are stored in the order left, right, bottom, top, near, far.
+//! When the projection flips y (see ::invert_y or the Vulkan projections) the
+//! bottom and top planes are swapped.
+template<typename T>
+struct frustum_t
+{
+  //! Returns `6`.
+  constexpr static index size();
+
+  vec<T, 4> planes[6]; //!< The planes bounding the frustum.
+};
+
+//! Type alias for a frustum of type ::real.
+using frustum = frustum_t<real>;
+
+//! Array of sphere positions and radii stored as a structure of arrays.
+template<typename T>
+struct sphere_soa_t
+{
+  const T* x; //!< The x component of the center of each sphere.
+  const T* y; //!< The y component of the center of each sphere.
+  const T* z; //!< The z component of the center of each sphere.
+  const T* radius; //!< The radius of each sphere.
+};
+
+//! Array of axis-aligned boxes stored as a structure of arrays.
+template<typename T>
+struct aabb_soa_t
+{
+  const T* min_x; //!< The x component of the minimum corner of each box.
+  const T* min_y; //!< The y component of the minimum corner of each box.
+  const T* min_z; //!< The z component of the minimum corner of each box.
+  const T* max_x; //!< The x component of the maximum corner of each box.
+  const T* max_y; //!< The y component of the maximum corner of each box.
+  const T* max_z; //!< The z component of the maximum corner of each box.
+};
+
+//! The number of elements processed by each chunk of a batched cull.
+//! \note A multiple of 32 so each chunk writes whole words of the visibility
+//! bitmask.
+constexpr index k_cull_chunk_size = 4096;
+
+//! Returns the frustum of a view projection matrix.
+//! \note The view projection matrix is usually
+//! `mat_mul(mat4_from_affine(view), projection)`. Passing only a projection
+//! matrix returns the frustum in view space.
+//! \note Planes are extracted using the method of Gribb and Hartmann and are
+//! normalized (the normal is unit length so distances are in world units).
+//! For an infinite far plane (reverse z) the far plane normal has zero length
+//! and is left unnormalized (every point is inside it).
+//! \param view_projection The view projection matrix to extract planes from.
+//! \param depth_range The normalized device coordinate depth of the near and
+//! far planes. Pass {-1, 1} for OpenGL, {0, 1} for Direct3D, Metal and Vulkan
+//! and {1, 0} when the projection has been passed to ::reverse_z.
+template<typename T>
+frustum_t<T> frustum_from_mat4(
+  const mat<T, 4>& view_projection, const vec<T, 2>& depth_range);
+
+//! Returns the signed distance of the point to the plane (positive inside).
+template<typename T>
+T plane_distance(const vec<T, 4>& plane, const vec<T, 3>& point);
+
+//! Returns if the sphere is inside or intersects the \ref frustum.
+//! \note The test is conservative, spheres near the corners of the frustum
+//! may be reported as intersecting when they are outside.
+template<typename T>
+bool frustum_intersects_sphere(
+  const frustum_t<T>& view_frustum, const vec<T, 3>& center, T radius);
+
+//! Returns if the \ref aabb is inside or intersects the \ref frustum.
+//! \note The test is conservative, boxes near the corners of the frustum
+//! may be reported as intersecting when they are outside.
+template<typename T>
+bool frustum_intersects_aabb(
+  const frustum_t<T>& view_frustum, const aabb_t<T>& bounds);
+
+//! Tests an array of spheres against the \ref frustum and writes the result to
+//! a bitmask (bit `i % 32` of `visibility[i / 32]` is set if sphere `i` is
+//! inside or intersects the frustum).
+//! \note `visibility` must have space for `chunk_count(count, 32)` elements.
+//! \note Each plane is tested against a whole chunk of spheres (the smallest
+//! signed distance of each sphere is kept in a temporary array) before the
+//! bitmask is written.
+//! \param view_frustum The frustum to test against.
+//! \param spheres The spheres to test.
+//! \param count The number of spheres.
+//! \param visibility The bitmask to write to.
+//! \param executor The executor to process chunks with (see
+//! ::serial_executor).
+template<typename T, typename Executor = serial_executor>
+void frustum_cull_spheres(
+  const frustum_t<T>& view_frustum, const sphere_soa_t<T>& spheres,
+  index count, uint32_t* visibility, const Executor& executor = Executor{});
+
+//! Tests an array of boxes against the \ref frustum and writes the result to a
+//! bitmask (bit `i % 32` of `visibility[i / 32]` is set if box `i` is inside
+//! or intersects the frustum).
+//! \note For each plane only the corner of the box farthest along the plane
+//! normal (the positive vertex) is tested. As the planes are the same for
+//! every box, which of the min or max array each component is read from is
+//! decided once per plane, leaving one dot product per plane and box.
+//! \note `visibility` must have space for `chunk_count(count, 32)` elements.
+//! \param view_frustum The frustum to test against.
+//! \param boxes The boxes to test.
+//! \param count The number of boxes.
+//! \param visibility The bitmask to write to.
+//! \param executor The executor to process chunks with (see
+//! ::serial_executor).
+template<typename T, typename Executor = serial_executor>
+void frustum_cull_aabbs(
+  const frustum_t<T>& view_frustum, const aabb_soa_t<T>& boxes, index count,
+  uint32_t* visibility, const Executor& executor = Executor{});
+
+} // namespace as
+
+#include "as-frustum.inl"
@@ -0,0 +1,160 @@
+namespace as
+{
+
+namespace internal
+{
+
+// returns the coefficients mapping a position to component i of its clip
+// space position (mat_mul(vec4, mat4) reads memory the same way for row and
+// column major)
+template<typename T>
+AS_API vec<T, 4> clip_component(const mat<T, 4>& m, const index i)
+{
+  return vec<T, 4>(m[i], m[i + 4], m[i + 8], m[i + 12]);
+}
+
+template<typename T>
+AS_API vec<T, 4> plane_normalize(const vec<T, 4>& plane)
+{
+  const T length = T(vec_length(vec3_from_vec4(plane)));
+  return length > T(0.0) ? plane / length : plane;
+}
+
+// writes the visibility bits of [first, last) given the minimum signed
+// distance to any plane of each element (relative to first)
+template<typename T>
+AS_API void cull_write_bits(
+  const T* min_distance, const index first, const index last,
+  uint32_t* visibility)
+{
+  for (index word_begin = first; word_begin < last; word_begin += 32) {
+    const index word_end = std::min(word_begin + 32, last);
+    uint32_t bits = 0;
+    for (index i = word_begin; i < word_end; ++i) {
+      bits |= uint32_t(min_distance[i - first] >= T(0.0))
+           << uint32_t(i - word_begin);
+    }
+    visibility[word_begin / 32] = bits;
+  }
+}
+
+} // namespace internal
+
+template<typename T>
+AS_API constexpr index frustum_t<T>::size()
+{
+  return 6;
+}
+
+// ref: Gil Gribb, Klaus Hartmann (2001) Fast Extraction of Viewing Frustum
+// Planes from the World-View-Projection Matrix
+template<typename T>
+AS_API frustum_t<T> frustum_from_mat4(
+  const mat<T, 4>& view_projection, const vec<T, 2>& depth_range)
+{
+  const vec<T, 4> x = internal::clip_component(view_projection, 0);
+  const vec<T, 4> y = internal::clip_component(view_projection, 1);
+  const vec<T, 4> z = internal::clip_component(view_projection, 2);
+  const vec<T, 4> w = internal::clip_component(view_projection, 3);
+  // depth increases away from the camera unless reversed
+  const T depth_sign = depth_range.y > depth_range.x ? T(1.0) : T(-1.0);
+  frustum_t<T> view_frustum;
+  view_frustum.planes[0] = internal::plane_normalize(w + x);
+  view_frustum.planes[1] = internal::plane_normalize(w - x);
+  view_frustum.planes[2] = internal::plane_normalize(w + y);
+  view_frustum.planes[3] = internal::plane_normalize(w - y);
+  view_frustum.planes[4] =
+    internal::plane_normalize((z - w * depth_range.x) * depth_sign);
+  view_frustum.planes[5] =
+    internal::plane_normalize((w * depth_range.y - z) * depth_sign);
+  return view_frustum;
+}
+
+template<typename T>
+AS_API T plane_distance(const vec<T, 4>& plane, const vec<T, 3>& point)
+{
+  return vec_dot(vec3_from_vec4(plane), point) + plane.w;
+}
+
+template<typename T>
+AS_API bool frustum_intersects_sphere(
+  const frustum_t<T>& view_frustum, const vec<T, 3>& center, const T radius)
+{
+  for (const vec<T, 4>& plane : view_frustum.planes) {
+    if (plane_distance(plane, center) < -radius) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template<typename T>
+AS_API bool frustum_intersects_aabb(
+  const frustum_t<T>& view_frustum, const aabb_t<T>& bounds)
+{
+  for (const vec<T, 4>& plane : view_frustum.planes) {
+    // the corner farthest along the normal (positive vertex)
+    const vec<T, 3> positive(
+      plane.x >= T(0.0) ? bounds.max.x : bounds.min.x,
+      plane.y >= T(0.0) ? bounds.max.y : bounds.min.y,
+      plane.z >= T(0.0) ? bounds.max.z : bounds.min.z);
+    if (plane_distance(plane, positive) < T(0.0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template<typename T, typename Executor>
+AS_API void frustum_cull_spheres(
+  const frustum_t<T>& view_frustum, const sphere_soa_t<T>& spheres,
+  const index count, uint32_t* visibility, const Executor& executor)
+{
+  executor(chunk_count(count, k_cull_chunk_size), [&](const index chunk) {
+    const index begin = chunk_begin(chunk, k_cull_chunk_size);
+    const index end = chunk_end(chunk, count, k_cull_chunk_size);
+    T min_distance[k_cull_chunk_size];
+    std::fill(
+      min_distance, min_distance + (end - begin),
+      std::numeric_limits<T>::max());
+    for (const vec<T, 4>& plane : view_frustum.planes) {
+      for (index i = begin; i < end; ++i) {
+        // distance to the plane offset by the radius
+        const T distance = plane.x * spheres.x[i] + plane.y * spheres.y[i]
+                         + plane.z * spheres.z[i] + plane.w
+                         + spheres.radius[i];
+        min_distance[i - begin] = std::min(min_distance[i - begin], distance);
+      }
+    }
+    internal::cull_write_bits(min_distance, begin, end, visibility);
+  });
+}
+
+template<typename T, typename Executor>
+AS_API void frustum_cull_aabbs(
+  const frustum_t<T>& view_frustum, const aabb_soa_t<T>& boxes,
+  const index count, uint32_t* visibility, const Executor& executor)
+{
+  executor(chunk_count(count, k_cull_chunk_size), [&](const index chunk) {
+    const index begin = chunk_begin(chunk, k_cull_chunk_size);
+    const index end = chunk_end(chunk, count, k_cull_chunk_size);
+    T min_distance[k_cull_chunk_size];
+    std::fill(
+      min_distance, min_distance + (end - begin),
+      std::numeric_limits<T>::max());
+    for (const vec<T, 4>& plane : view_frustum.planes) {
+      // read the positive vertex of every box from the min or max arrays
+      const T* px = plane.x >= T(0.0) ? boxes.max_x : boxes.min_x;
+      const T* py = plane.y >= T(0.0) ? boxes.max_y : boxes.min_y;
+      const T* pz = plane.z >= T(0.0) ? boxes.max_z : boxes.min_z;
+      for (index i = begin; i < end; ++i) {
+        const T distance =
+          plane.x * px[i] + plane.y * py[i] + plane.z * pz[i] + plane.w;
+        min_distance[i - begin] = std::min(min_distance[i - begin], distance);
+      }
+    }
+    internal::cull_write_bits(min_distance, begin, end, visibility);
+  });
+}
+
+} // namespace as
@@ -0,0 +1,104 @@
+//! \file
+//! `as-half`
+
+#pragma once
+
+#include <cstdint>
+
+#if defined __F16C__
+#include <immintrin.h>
+#endif // __F16C__
+
+#include "as-math-ops.hpp"
+
+namespace as
+{
+
+//! A half precision (IEEE 754 binary16) floating point value for storage.
+//! \note Arithmetic is not supported, values are converted to `float` to
+//! compute with and back to half to store (see ::half_from_float and
+//! ::float_from_half). Use `vec<half, d>` and `mat<half, d>` to store vectors
+//! and matrices in half the space of `float` (see ::vec_from_vec and
+//! ::mat_from_mat).
+//! \note Half precision has 11 bits of precision (about 3 decimal digits) and
+//! a largest finite value of `65504`.
+struct half
+{
+  half() noexcept = default;
+
+  //! Constructs half from the nearest representable value of a `float` (ties
+  //! are rounded to even, values too large to represent become infinity).
+  explicit half(float value);
+  //! Returns the value as a `float` (every half value is exactly
+  //! representable).
+  explicit operator float() const;
+
+  uint16_t bits; //!< The sign, exponent and mantissa bits.
+};
+
+//! Type alias for a two dimensional vector of type \ref half.
+using vec2h = vec<half, 2>;
+//! Type alias for a three dimensional vector of type \ref half.
+using vec3h = vec<half, 3>;
+//! Type alias for a four dimensional vector of type \ref half.
+using vec4h = vec<half, 4>;
+//! Type alias for a three by three matrix of type \ref half.
+using mat3h = mat<half, 3>;
+//! Type alias for a four by four matrix of type \ref half.
+using mat4h = mat<half, 4>;
+
+//! Returns the \ref half with the given bits.
+half half_from_bits(uint16_t bits);
+
+//! Returns the nearest \ref half to a `float` (see half::half).
+//! \note Uses the F16C `vcvtps2ph` instruction when `__F16C__` is defined
+//! (e.g. compiling with `-mf16c` or `-march=haswell`), otherwise converts
+//! with integer operations.
+//! ref: Giesen (2012) Half to float done quic
+half half_from_float(float value);
+
+//! Returns the `float` value of a \ref half (see half::operator float).
+//! \note Uses the F16C `vcvtph2ps` instruction when `__F16C__` is defined.
+float float_from_half(half value);
+
+//! Writes the nearest \ref half to each `float` to `halves`.
+//! \note Converts eight values at a time with F16C instructions when
+//! `__F16C__` is defined, otherwise every value is converted with the same
+//! integer operations (rounding and special values are selected with masks
+//! rather than branches).
+//! \note `halves` must have space for at least `count` elements.
+void half_from_float(const float* values, index count, half* halves);
+
+//! Writes the `float` value of each \ref half to `values`.
+//! \note Converts eight values at a time with F16C instructions when
+//! `__F16C__` is defined.
+//! \note `values` must have space for at least `count` elements.
+void float_from_half(const half* halves, index count, float* values);
+
+//! Writes each `float` vector converted to half precision to `result`.
+//! \note Vectors are converted as one array of `count * d` elements (see
+//! ::half_from_float).
+//! \note `result` must have space for at least `count` elements.
+template<index d>
+void vec_from_vec(const vec<float, d>* vs, index count, vec<half, d>* result);
+
+//! Writes each half precision vector converted to `float` to `result`.
+//! \note Vectors are converted as one array of `count * d` elements (see
+//! ::float_from_half).
+//! \note `result` must have space for at least `count` elements.
+template<index d>
+void vec_from_vec(const vec<half, d>* vs, index count, vec<float, d>* result);
+
+//! Writes each `float` matrix converted to half precision to `result`.
+//! \note `result` must have space for at least `count` elements.
+template<index d>
+void mat_from_mat(const mat<float, d>* ms, index count, mat<half, d>* result);
+
+//! Writes each half precision matrix converted to `float` to `result`.
+//! \note `result` must have space for at least `count` elements.
+template<index d>
+void mat_from_mat(const mat<half, d>* ms, index count, mat<float, d>* result);
+
+} // namespace as
+
+#include "as-half.inl"
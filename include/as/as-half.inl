@@ -0,0 +1,193 @@
+namespace as
+{
+
+namespace internal
+{
+
+// returns the bits of a float (copied as bytes, the same as std::memcpy)
+AS_API inline uint32_t float_to_bits(const float value)
+{
+  uint32_t bits;
+  std::copy_n(
+    reinterpret_cast<const unsigned char*>(&value), sizeof(float),
+    reinterpret_cast<unsigned char*>(&bits));
+  return bits;
+}
+
+// returns the float with the given bits
+AS_API inline float float_from_bits(const uint32_t bits)
+{
+  float value;
+  std::copy_n(
+    reinterpret_cast<const unsigned char*>(&bits), sizeof(float),
+    reinterpret_cast<unsigned char*>(&value));
+  return value;
+}
+
+// returns a if the mask is all ones and b if it is zero
+AS_API inline uint32_t select_bits(
+  const uint32_t mask, const uint32_t a, const uint32_t b)
+{
+  return (a & mask) | (b & ~mask);
+}
+
+// returns all ones if the condition is true and zero otherwise
+AS_API inline uint32_t mask_bits(const bool condition)
+{
+  return 0u - uint32_t(condition);
+}
+
+// returns the bits of the nearest half to a float (branch free so it can be
+// used in loops the compiler vectorizes)
+AS_API inline uint16_t half_bits_from_float(const float value)
+{
+  const uint32_t bits = float_to_bits(value);
+  const uint32_t sign = (bits >> 16) & 0x8000;
+  const uint32_t magnitude = bits & 0x7fffffff;
+  // nan stays nan (quiet) and values too large become infinity
+  const uint32_t overflow =
+    select_bits(mask_bits(magnitude > 0x7f800000), 0x7e00, 0x7c00);
+  // values below the smallest normal half are rounded by adding 0.5 (which
+  // shifts the mantissa into the low bits)
+  const uint32_t subnormal =
+    float_to_bits(float_from_bits(magnitude) + 0.5f) - 0x3f000000;
+  // rebias the exponent and round to nearest even
+  const uint32_t normal =
+    (magnitude + 0xc8000fff + ((magnitude >> 13) & 1)) >> 13;
+  const uint32_t finite =
+    select_bits(mask_bits(magnitude < 0x38800000), subnormal, normal);
+  return uint16_t(
+    select_bits(mask_bits(magnitude >= 0x47800000), overflow, finite) | sign);
+}
+
+// returns the float value of the bits of a half (branch free)
+AS_API inline float float_from_half_bits(const uint16_t bits)
+{
+  const uint32_t shifted = uint32_t(bits & 0x7fff) << 13;
+  const uint32_t exponent = shifted & 0x0f800000;
+  // rebias the exponent (twice for infinity and nan)
+  const uint32_t normal = shifted + 0x38000000
+                        + (mask_bits(exponent == 0x0f800000) & 0x38000000);
+  // subnormals are renormalized with a float subtraction
+  const float subnormal =
+    float_from_bits(shifted + 0x38800000) - float_from_bits(0x38800000);
+  return float_from_bits(
+    select_bits(mask_bits(exponent == 0), float_to_bits(subnormal), normal)
+    | uint32_t(bits & 0x8000) << 16);
+}
+
+} // namespace internal
+
+AS_API inline half::half(const float value)
+  : bits(half_from_float(value).bits)
+{
+}
+
+AS_API inline half::operator float() const
+{
+  return float_from_half(*this);
+}
+
+AS_API inline half half_from_bits(const uint16_t bits)
+{
+  half result;
+  result.bits = bits;
+  return result;
+}
+
+AS_API inline half half_from_float(const float value)
+{
+#if defined __F16C__
+  return half_from_bits(_cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT));
+#else
+  return half_from_bits(internal::half_bits_from_float(value));
+#endif // __F16C__
+}
+
+AS_API inline float float_from_half(const half value)
+{
+#if defined __F16C__
+  return _cvtsh_ss(value.bits);
+#else
+  return internal::float_from_half_bits(value.bits);
+#endif // __F16C__
+}
+
+AS_API inline void half_from_float(
+  const float* values, const index count, half* halves)
+{
+  index i = 0;
+#if defined __F16C__
+  for (const index simd_count = count - count % 8; i < simd_count; i += 8) {
+    _mm_storeu_si128(
+      reinterpret_cast<__m128i*>(halves + i),
+      _mm256_cvtps_ph(
+        _mm256_loadu_ps(values + i), _MM_FROUND_TO_NEAREST_INT));
+  }
+#endif // __F16C__
+  for (; i < count; ++i) {
+    halves[i].bits = internal::half_bits_from_float(values[i]);
+  }
+}
+
+AS_API inline void float_from_half(
+  const half* halves, const index count, float* values)
+{
+  index i = 0;
+#if defined __F16C__
+  for (const index simd_count = count - count % 8; i < simd_count; i += 8) {
+    _mm256_storeu_ps(
+      values + i, _mm256_cvtph_ps(_mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(halves + i))));
+  }
+#endif // __F16C__
+  for (; i < count; ++i) {
+    values[i] = internal::float_from_half_bits(halves[i].bits);
+  }
+}
+
+template<index d>
+AS_API void vec_from_vec(
+  const vec<float, d>* vs, const index count, vec<half, d>* result)
+{
+  static_assert(sizeof(vec<float, d>) == sizeof(float) * d);
+  static_assert(sizeof(vec<half, d>) == sizeof(half) * d);
+  half_from_float(
+    reinterpret_cast<const float*>(vs), count * d,
+    reinterpret_cast<half*>(result));
+}
+
+template<index d>
+AS_API void vec_from_vec(
+  const vec<half, d>* vs, const index count, vec<float, d>* result)
+{
+  static_assert(sizeof(vec<float, d>) == sizeof(float) * d);
+  static_assert(sizeof(vec<half, d>) == sizeof(half) * d);
+  float_from_half(
+    reinterpret_cast<const half*>(vs), count * d,
+    reinterpret_cast<float*>(result));
+}
+
+template<index d>
+AS_API void mat_from_mat(
+  const mat<float, d>* ms, const index count, mat<half, d>* result)
+{
+  static_assert(sizeof(mat<float, d>) == sizeof(float) * d * d);
+  static_assert(sizeof(mat<half, d>) == sizeof(half) * d * d);
+  half_from_float(
+    reinterpret_cast<const float*>(ms), count * d * d,
+    reinterpret_cast<half*>(result));
+}
+
+template<index d>
+AS_API void mat_from_mat(
+  const mat<half, d>* ms, const index count, mat<float, d>* result)
+{
+  static_assert(sizeof(mat<float, d>) == sizeof(float) * d * d);
+  static_assert(sizeof(mat<half, d>) == sizeof(half) * d * d);
+  float_from_half(
+    reinterpret_cast<const half*>(ms), count * d * d,
+    reinterpret_cast<float*>(result));
+}
+
+} // namespace as
@@ -8,11 +8,13 @@
 #include <numeric>
 #include <tuple>
 
+#include "as-aabb.hpp"
 #include "as-affine.hpp"
 #include "as-mat3.hpp"
 #include "as-mat4.hpp"
 #include "as-math.hpp"
 #include "as-quat.hpp"
+#include "as-ray.hpp"
 #include "as-rigid.hpp"
 #include "as-vec.hpp"
 
@@ -70,6 +72,22 @@ constexpr real vec_dot(const vec3& lhs, const vec3& rhs);
 template<typename T, index d>
 constexpr real vec_length_sq(const vec<T, d>& v);
 
+//! Returns the dot product of two vectors using compensated (Neumaier)
+//! summation.
+//! \note The rounding error of the result does not grow with the dimension of
+//! the vectors, prefer this to ::vec_dot for vectors with many elements or
+//! products that vary greatly in magnitude.
+//! \warning The compensation is removed by the compiler if fast-math
+//! optimizations are enabled (e.g. `-ffast-math` or `/fp:fast`).
+template<typename T, index d>
+real vec_dot_compensated(const vec<T, d>& lhs, const vec<T, d>& rhs);
+
+//! Returns the length squared of the vector using compensated (Neumaier)
+//! summation.
+//! \note See ::vec_dot_compensated.
+template<typename T, index d>
+real vec_length_sq_compensated(const vec<T, d>& v);
+
 //! Returns the length of the vector.
 template<typename T, index d>
 real vec_length(const vec<T, d>& v);
@@ -327,6 +345,19 @@ constexpr vec<T, 4> vec4_direction(const vec<T, 3>& v);
 template<typename T, index d>
 vec<T, d> vec_average(const vec<T, d>* vectors, index count);
 
+//! Returns the average of an array of vectors using compensated (Neumaier)
+//! summation.
+//! \note Vectors are summed in fixed size blocks (using four interleaved
+//! accumulators to allow the compiler to vectorize the loop) and the block
+//! sums are then combined. The rounding error of the result is effectively
+//! independent of `count`, making it suitable for averaging millions of
+//! `float` vectors (e.g. the centroid of a point cloud) without switching to
+//! `double`.
+//! \warning The compensation is removed by the compiler if fast-math
+//! optimizations are enabled (e.g. `-ffast-math` or `/fp:fast`).
+template<typename T, index d>
+vec<T, d> vec_average_compensated(const vec<T, d>* vectors, index count);
+
 //! Returns the average of a parameter pack of vectors.
 template<typename... vectors>
 auto vec_average_fold(vectors&&... vecs);
@@ -865,6 +896,18 @@ quat_t<T> quat_nlerp(const quat_t<T>& q0, const quat_t<T>& q1, T t);
 template<typename T>
 quat_t<T> quat_slerp(const quat_t<T>& q0, const quat_t<T>& q1, T t);
 
+//! Returns the natural logarithm of the quaternion.
+//! \note For a unit quaternion representing a rotation of `2 * theta`
+//! radians about `axis` the result is `(0, axis * theta)`.
+template<typename T>
+quat_t<T> quat_log(const quat_t<T>& q);
+
+//! Returns the exponential of the quaternion (the inverse of ::quat_log).
+//! \note For a quaternion `(0, v)` the result is the unit quaternion
+//! representing a rotation of `2 * length(v)` radians about `v`.
+template<typename T>
+quat_t<T> quat_exp(const quat_t<T>& q);
+
 //! Converts a rotation matrix to a quaternion.
 //! \note Ensure ::mat3 is a valid rotation. It must be 'special orthogonal'
 //! (pure rotation without reflection).
@@ -988,6 +1031,52 @@ rigid_t<T> rigid_from_ptr(const T* data);
 template<typename T>
 rigid_t<T> rigid_from_mat4(const mat<T, 4>& m);
 
+//! Returns the rotation and translation (as a \ref rigid) and the scale of a
+//! ::mat4.
+//! \note Unlike ::rigid_from_mat4 the scale of each basis vector is removed
+//! before the rotation is found (`mat4_from_rigid(rigid)` multiplied by
+//! `mat4_scale(scale)` first gives back the ::mat4).
+//! \note A reflection (negative determinant) is represented by a negative `x`
+//! scale.
+//! \note Ensure that the ::mat4 holds a valid a transformation
+//! (translation/scale/rotation) without shear and with non-zero scale (see
+//! ::mat4_decompose_polar for sheared transformations).
+template<typename T>
+std::tuple<rigid_t<T>, vec<T, 3>> mat4_decompose(const mat<T, 4>& m);
+
+//! Writes the rotation and translation and the scale of each ::mat4 to
+//! `rigids` and `scales`.
+//! \note See ::mat4_decompose.
+//! \note `rigids` and `scales` must have space for at least `count` elements.
+template<typename T>
+void mat4_decompose(
+  const mat<T, 4>* ms, index count, rigid_t<T>* rigids, vec<T, 3>* scales);
+
+//! Returns the rotation and translation (as a \ref rigid) and the stretch of
+//! a ::mat4 from the polar decomposition of its ::mat3 part.
+//! \note The ::mat3 part is the rotation multiplied by the stretch (which is
+//! symmetric), the stretch holds any scale and shear. The stretch of a
+//! transformation without shear is a scale matrix (see ::mat4_decompose).
+//! \note A reflection (negative determinant) is represented by a negative
+//! stretch.
+//! \note The rotation is found with a scaled Newton iteration which
+//! converges in a handful of iterations for well conditioned matrices.
+//! \note Ensure that the ::mat4 holds a valid a transformation
+//! (translation/scale/shear/rotation) with a non-singular ::mat3 part.
+//! ref: Higham (1986) Computing the Polar Decomposition - with Applications
+template<typename T>
+std::tuple<rigid_t<T>, mat<T, 3>> mat4_decompose_polar(const mat<T, 4>& m);
+
+//! Writes the rotation and translation and the stretch of each ::mat4 to
+//! `rigids` and `stretches`.
+//! \note See ::mat4_decompose_polar.
+//! \note `rigids` and `stretches` must have space for at least `count`
+//! elements.
+template<typename T>
+void mat4_decompose_polar(
+  const mat<T, 4>* ms, index count, rigid_t<T>* rigids,
+  mat<T, 3>* stretches);
+
 //! Returns a \ref rigid from a \ref quat.
 //! \note Ensure that the \ref quat holds a valid a transformation
 //! (scale/rotation)
@@ -1049,6 +1138,72 @@ template<typename T>
 vec<T, 3> rigid_inv_transform_pos(
   const rigid_t<T>& r, const vec<T, 3>& position);
 
+//! Returns the \ref aabb enclosing both boxes.
+template<typename T>
+aabb_t<T> aabb_merge(const aabb_t<T>& lhs, const aabb_t<T>& rhs);
+
+//! Returns the \ref aabb enclosing both the box and the point.
+template<typename T>
+aabb_t<T> aabb_merge(const aabb_t<T>& bounds, const vec<T, 3>& point);
+
+//! Returns the \ref aabb grown by `margin` along each axis in both
+//! directions.
+template<typename T>
+aabb_t<T> aabb_expand(const aabb_t<T>& bounds, T margin);
+
+//! Returns the center of the \ref aabb.
+template<typename T>
+vec<T, 3> aabb_center(const aabb_t<T>& bounds);
+
+//! Returns the extent (size along each axis) of the \ref aabb.
+template<typename T>
+vec<T, 3> aabb_extent(const aabb_t<T>& bounds);
+
+//! Returns the surface area of the \ref aabb.
+//! \note Used by the surface area heuristic to estimate the cost of visiting a
+//! node in a bounding volume hierarchy.
+template<typename T>
+T aabb_surface_area(const aabb_t<T>& bounds);
+
+//! Returns if the two boxes overlap (touching boxes are considered
+//! overlapping).
+template<typename T>
+bool aabb_overlaps(const aabb_t<T>& lhs, const aabb_t<T>& rhs);
+
+//! Returns if `inner` is entirely contained within `outer`.
+template<typename T>
+bool aabb_contains(const aabb_t<T>& outer, const aabb_t<T>& inner);
+
+//! Returns the point at `distance` along the \ref ray.
+template<typename T>
+vec<T, 3> ray_point(const ray_t<T>& r, T distance);
+
+//! Returns if the \ref ray intersects the \ref aabb and the distance along the
+//! ray the box is entered (zero if the origin is inside the box).
+//! \note Uses the slab test (no division as the ray stores the reciprocal of
+//! its direction).
+//! \param r The ray to test.
+//! \param bounds The box to test.
+//! \param max_distance The maximum distance along the ray to test.
+template<typename T>
+std::tuple<bool, T> ray_intersect_aabb(
+  const ray_t<T>& r, const aabb_t<T>& bounds,
+  T max_distance = std::numeric_limits<T>::max());
+
+//! Returns if the \ref ray intersects the triangle, the distance along the ray
+//! of the intersection and the barycentric coordinates `(u, v)` of the
+//! intersection (the weights of `v1` and `v2` respectively).
+//! \note Uses the Moller-Trumbore algorithm. Triangles are double sided.
+//! \param r The ray to test.
+//! \param v0 The first vertex of the triangle.
+//! \param v1 The second vertex of the triangle.
+//! \param v2 The third vertex of the triangle.
+//! \param max_distance The maximum distance along the ray to test.
+template<typename T>
+std::tuple<bool, T, vec<T, 2>> ray_intersect_triangle(
+  const ray_t<T>& r, const vec<T, 3>& v0, const vec<T, 3>& v1,
+  const vec<T, 3>& v2, T max_distance = std::numeric_limits<T>::max());
+
 } // namespace as
 
 #include "as-math-ops.inl"
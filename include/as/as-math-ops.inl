@@ -75,6 +75,48 @@ AS_API constexpr real vec_length_sq(const vec<T, d>& v)
   return vec_dot(v, v);
 }
 
+namespace internal
+{
+
+// ref: Neumaier, A. (1974) Rundungsfehleranalyse einiger Verfahren zur
+// Summation endlicher Summen
+template<typename T>
+AS_API constexpr void neumaier_add(T& sum, T& compensation, const T value)
+{
+  const T t = sum + value;
+  compensation +=
+    abs(sum) >= abs(value) ? (sum - t) + value : (value - t) + sum;
+  sum = t;
+}
+
+template<typename T, index d>
+AS_API constexpr void neumaier_add(
+  vec<T, d>& sum, vec<T, d>& compensation, const vec<T, d>& value)
+{
+  for (index i = 0; i < d; ++i) {
+    neumaier_add(sum[i], compensation[i], value[i]);
+  }
+}
+
+} // namespace internal
+
+template<typename T, index d>
+AS_API real vec_dot_compensated(const vec<T, d>& lhs, const vec<T, d>& rhs)
+{
+  auto sum = real(0.0);
+  auto compensation = real(0.0);
+  for (index i = 0; i < d; ++i) {
+    internal::neumaier_add(sum, compensation, real(lhs[i] * rhs[i]));
+  }
+  return sum + compensation;
+}
+
+template<typename T, index d>
+AS_API real vec_length_sq_compensated(const vec<T, d>& v)
+{
+  return vec_dot_compensated(v, v);
+}
+
 template<typename T, index d>
 AS_API real vec_length(const vec<T, d>& v)
 {
@@ -474,6 +516,53 @@ AS_API vec<T, d> vec_average(const vec<T, d>* vectors, const index count)
     / real(count));
 }
 
+namespace internal
+{
+
+// sums vectors in fixed size blocks (with interleaved accumulators) and adds
+// each block sum to the running total
+template<typename T, index d>
+AS_API void neumaier_sum(
+  const vec<T, d>* vectors, const index count, vec<T, d>& sum,
+  vec<T, d>& compensation)
+{
+  constexpr index block_size = 1024;
+  constexpr index lane_count = 4;
+
+  for (index begin = 0; begin < count; begin += block_size) {
+    const index end = min(begin + block_size, count);
+    const index lane_end = end - (end - begin) % lane_count;
+
+    vec<T, d> lane_sums[lane_count] = {};
+    vec<T, d> lane_compensations[lane_count] = {};
+    for (index i = begin; i < lane_end; i += lane_count) {
+      for (index l = 0; l < lane_count; ++l) {
+        neumaier_add(lane_sums[l], lane_compensations[l], vectors[i + l]);
+      }
+    }
+    for (index i = lane_end; i < end; ++i) {
+      neumaier_add(lane_sums[0], lane_compensations[0], vectors[i]);
+    }
+
+    for (index l = 0; l < lane_count; ++l) {
+      neumaier_add(sum, compensation, lane_sums[l]);
+      neumaier_add(sum, compensation, lane_compensations[l]);
+    }
+  }
+}
+
+} // namespace internal
+
+template<typename T, index d>
+AS_API vec<T, d> vec_average_compensated(
+  const vec<T, d>* vectors, const index count)
+{
+  vec<T, d> sum = {};
+  vec<T, d> compensation = {};
+  internal::neumaier_sum(vectors, count, sum, compensation);
+  return vec<T, d>((sum + compensation) / real(count));
+}
+
 template<typename... vectors>
 AS_API auto vec_average_fold(vectors&&... vecs)
 {
@@ -668,7 +757,7 @@ AS_API mat<T, d> minor_impl(const mat<T, d>& m, int2type<I> /*unused*/)
 } // namespace internal
 
 template<typename T, index d>
-AS_API T determinant(const mat<T, d>& m)
+AS_API T mat_determinant(const mat<T, d>& m)
 {
   return internal::determinant_impl(m, internal::int2type<d>{});
 }
@@ -679,7 +768,7 @@ AS_API mat<T, d> mat_inverse(const mat<T, d>& m)
   mat<T, d> result;
   result = internal::minor_impl(m, internal::int2type<d>{});
   result = mat_transpose(result);
-  result *= T(1.0) / determinant(m);
+  result *= T(1.0) / mat_determinant(m);
   return result;
 }
 
@@ -689,7 +778,7 @@ AS_API mat<T, 2> mat_inverse(const mat<T, 2>& m)
   // clang-format off
   return mat<T, 2>{m[3], -m[1],
                   -m[2],  m[0]}
-        * (T(1.0) / determinant(m));
+        * (T(1.0) / mat_determinant(m));
   // clang-format on
 }
 
@@ -1466,6 +1555,29 @@ AS_API inline quat_t<T> quat_slerp(
        / std::sin(theta);
 }
 
+template<typename T>
+AS_API quat_t<T> quat_log(const quat_t<T>& q)
+{
+  const T length_sq = quat_length_sq(q);
+  const T v_length = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z);
+  // atan2(|v|, w) / |v| tends to 1 / w as |v| approaches zero and the
+  // vector part is zero when |v| is
+  const T scale = v_length > T(0.0) ? std::atan2(v_length, q.w) / v_length
+                                    : T(0.0);
+  return {
+    std::log(length_sq) * T(0.5), q.x * scale, q.y * scale, q.z * scale};
+}
+
+template<typename T>
+AS_API quat_t<T> quat_exp(const quat_t<T>& q)
+{
+  const T v_length = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z);
+  const T exp_w = std::exp(q.w);
+  const T scale =
+    v_length > T(0.0) ? exp_w * std::sin(v_length) / v_length : exp_w;
+  return {exp_w * std::cos(v_length), q.x * scale, q.y * scale, q.z * scale};
+}
+
 // ref: euclidean space
 // http://www.euclideanspace.com/maths/geometry/rotations/conversions/matrixToQuaternion/index.htm
 template<typename T>
@@ -1692,6 +1804,114 @@ AS_API rigid_t<T> rigid_from_mat4(const mat<T, 4>& m)
   return rigid_t<T>(quat_from_mat3(mat3_from_mat4(m)), mat4_translation(m));
 }
 
+template<typename T>
+AS_API std::tuple<rigid_t<T>, vec<T, 3>> mat4_decompose(const mat<T, 4>& m)
+{
+  const mat<T, 3> basis = mat3_from_mat4(m);
+  // a reflection flips the x axis
+  const T sign = std::copysign(T(1.0), mat_determinant(basis));
+  const vec<T, 3> scale(
+    T(vec_length(mat3_basis_x(basis))) * sign,
+    T(vec_length(mat3_basis_y(basis))), T(vec_length(mat3_basis_z(basis))));
+  mat<T, 3> rotation;
+  mat3_basis_x(rotation, mat3_basis_x(basis) / scale.x);
+  mat3_basis_y(rotation, mat3_basis_y(basis) / scale.y);
+  mat3_basis_z(rotation, mat3_basis_z(basis) / scale.z);
+  return {
+    rigid_t<T>(quat_normalize(quat_from_mat3(rotation)), mat4_translation(m)),
+    scale};
+}
+
+template<typename T>
+AS_API void mat4_decompose(
+  const mat<T, 4>* ms, const index count, rigid_t<T>* rigids,
+  vec<T, 3>* scales)
+{
+  for (index i = 0; i < count; ++i) {
+    std::tie(rigids[i], scales[i]) = mat4_decompose(ms[i]);
+  }
+}
+
+namespace internal
+{
+
+// returns the sum of the squares of the elements of the matrix
+template<typename T>
+AS_API T mat3_frobenius_sq(const mat<T, 3>& m)
+{
+  T sum = T(0.0);
+  for (index e = 0; e < mat<T, 3>::size(); ++e) {
+    sum += m[e] * m[e];
+  }
+  return sum;
+}
+
+// returns the orthogonal factor of the polar decomposition of the matrix
+// (the average of the matrix and its inverse transpose, each scaled to have
+// the same norm, converges quadratically)
+template<typename T>
+AS_API mat<T, 3> mat3_orthogonal_factor(const mat<T, 3>& m)
+{
+  constexpr index max_iterations = 20;
+  mat<T, 3> q = m;
+  for (index i = 0; i < max_iterations; ++i) {
+    const mat<T, 3> inv_t = mat_transpose(mat_inverse(q));
+    const T gamma =
+      std::sqrt(std::sqrt(mat3_frobenius_sq(inv_t) / mat3_frobenius_sq(q)));
+    T change = T(0.0);
+    for (index e = 0; e < mat<T, 3>::size(); ++e) {
+      const T next = (q[e] * gamma + inv_t[e] / gamma) * T(0.5);
+      change += std::abs(next - q[e]);
+      q[e] = next;
+    }
+    if (change <= std::numeric_limits<T>::epsilon() * T(16.0)) {
+      break;
+    }
+  }
+  return q;
+}
+
+} // namespace internal
+
+template<typename T>
+AS_API std::tuple<rigid_t<T>, mat<T, 3>> mat4_decompose_polar(
+  const mat<T, 4>& m)
+{
+  const mat<T, 3> basis = mat3_from_mat4(m);
+  // the orthogonal factor of a reflection is negated to be a rotation
+  const mat<T, 3> rotation = internal::mat3_orthogonal_factor(basis)
+                           * std::copysign(T(1.0), mat_determinant(basis));
+  // the stretch is the transpose of the rotation multiplied by the basis
+  const vec<T, 3> axes[] = {
+    mat3_basis_x(rotation), mat3_basis_y(rotation), mat3_basis_z(rotation)};
+  const vec<T, 3> columns[] = {
+    mat3_basis_x(basis), mat3_basis_y(basis), mat3_basis_z(basis)};
+  mat<T, 3> stretch;
+  for (index r = 0; r < 3; ++r) {
+    for (index c = r; c < 3; ++c) {
+      // symmetric by construction (averaged to remove rounding)
+      const T value =
+        (T(vec_dot(axes[r], columns[c])) + T(vec_dot(axes[c], columns[r])))
+        * T(0.5);
+      stretch[r * 3 + c] = value;
+      stretch[c * 3 + r] = value;
+    }
+  }
+  return {
+    rigid_t<T>(quat_normalize(quat_from_mat3(rotation)), mat4_translation(m)),
+    stretch};
+}
+
+template<typename T>
+AS_API void mat4_decompose_polar(
+  const mat<T, 4>* ms, const index count, rigid_t<T>* rigids,
+  mat<T, 3>* stretches)
+{
+  for (index i = 0; i < count; ++i) {
+    std::tie(rigids[i], stretches[i]) = mat4_decompose_polar(ms[i]);
+  }
+}
+
 template<typename T>
 AS_API rigid_t<T> rigid_from_quat(const quat_t<T>& q)
 {
@@ -1770,4 +1990,123 @@ AS_API vec<T, 3> rigid_inv_transform_pos(
   return quat_rotate(quat_inverse(r.rotation), position - r.translation);
 }
 
+template<typename T>
+AS_API aabb_t<T> aabb_merge(const aabb_t<T>& lhs, const aabb_t<T>& rhs)
+{
+  return aabb_t<T>(vec_min(lhs.min, rhs.min), vec_max(lhs.max, rhs.max));
+}
+
+template<typename T>
+AS_API aabb_t<T> aabb_merge(const aabb_t<T>& bounds, const vec<T, 3>& point)
+{
+  return aabb_t<T>(vec_min(bounds.min, point), vec_max(bounds.max, point));
+}
+
+template<typename T>
+AS_API aabb_t<T> aabb_expand(const aabb_t<T>& bounds, const T margin)
+{
+  return aabb_t<T>(
+    bounds.min - vec<T, 3>(margin), bounds.max + vec<T, 3>(margin));
+}
+
+template<typename T>
+AS_API vec<T, 3> aabb_center(const aabb_t<T>& bounds)
+{
+  return (bounds.min + bounds.max) * T(0.5);
+}
+
+template<typename T>
+AS_API vec<T, 3> aabb_extent(const aabb_t<T>& bounds)
+{
+  return bounds.max - bounds.min;
+}
+
+template<typename T>
+AS_API T aabb_surface_area(const aabb_t<T>& bounds)
+{
+  const vec<T, 3> extent = aabb_extent(bounds);
+  return T(2.0)
+       * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+}
+
+template<typename T>
+AS_API bool aabb_overlaps(const aabb_t<T>& lhs, const aabb_t<T>& rhs)
+{
+  return lhs.min.x <= rhs.max.x && lhs.max.x >= rhs.min.x
+      && lhs.min.y <= rhs.max.y && lhs.max.y >= rhs.min.y
+      && lhs.min.z <= rhs.max.z && lhs.max.z >= rhs.min.z;
+}
+
+template<typename T>
+AS_API bool aabb_contains(const aabb_t<T>& outer, const aabb_t<T>& inner)
+{
+  return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y
+      && outer.min.z <= inner.min.z && outer.max.x >= inner.max.x
+      && outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+}
+
+namespace internal
+{
+
+// ref: Amy Williams et al. (2005) An Efficient and Robust Ray-Box Intersection
+// Algorithm
+template<typename T>
+AS_API bool ray_aabb_slab(
+  const aabb_t<T>& bounds, const vec<T, 3>& origin,
+  const vec<T, 3>& inv_direction, const T max_distance, T& entry)
+{
+  const vec<T, 3> t0 = (bounds.min - origin) * inv_direction;
+  const vec<T, 3> t1 = (bounds.max - origin) * inv_direction;
+  const vec<T, 3> t_near = vec_min(t0, t1);
+  const vec<T, 3> t_far = vec_max(t0, t1);
+  entry = std::max(std::max(t_near.x, t_near.y), std::max(t_near.z, T(0.0)));
+  const T exit = std::min(
+    std::min(t_far.x, t_far.y), std::min(t_far.z, max_distance));
+  return entry <= exit;
+}
+
+} // namespace internal
+
+template<typename T>
+AS_API vec<T, 3> ray_point(const ray_t<T>& r, const T distance)
+{
+  return r.origin + r.direction * distance;
+}
+
+template<typename T>
+AS_API std::tuple<bool, T> ray_intersect_aabb(
+  const ray_t<T>& r, const aabb_t<T>& bounds, const T max_distance)
+{
+  T entry;
+  const bool hit = internal::ray_aabb_slab(
+    bounds, r.origin, r.inv_direction, max_distance, entry);
+  return {hit, entry};
+}
+
+// ref: Tomas Moller, Ben Trumbore (1997) Fast, Minimum Storage Ray/Triangle
+// Intersection
+template<typename T>
+AS_API std::tuple<bool, T, vec<T, 2>> ray_intersect_triangle(
+  const ray_t<T>& r, const vec<T, 3>& v0, const vec<T, 3>& v1,
+  const vec<T, 3>& v2, const T max_distance)
+{
+  const vec<T, 3> edge1 = v1 - v0;
+  const vec<T, 3> edge2 = v2 - v0;
+  const vec<T, 3> p = vec3_cross(r.direction, edge2);
+  const T det = vec_dot(edge1, p);
+  // ray is parallel to the plane of the triangle
+  if (det == T(0.0)) {
+    return {false, max_distance, vec<T, 2>::zero()};
+  }
+  const T inv_det = T(1.0) / det;
+  const vec<T, 3> s = r.origin - v0;
+  const T u = vec_dot(s, p) * inv_det;
+  const vec<T, 3> q = vec3_cross(s, edge1);
+  const T v = vec_dot(r.direction, q) * inv_det;
+  const T distance = vec_dot(edge2, q) * inv_det;
+  const bool hit = u >= T(0.0) && v >= T(0.0) && u + v <= T(1.0)
+                && distance >= T(0.0) && distance <= max_distance;
+  return {hit, distance, vec<T, 2>(u, v)};
+}
+
 } // namespace as
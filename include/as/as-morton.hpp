@@ -0,0 +1,125 @@
+//! \file
+//! `as-morton`
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#if defined __BMI2__
+#include <immintrin.h>
+#endif // __BMI2__
+
+#include "as-executor.hpp"
+#include "as-math-ops.hpp"
+
+namespace as
+{
+
+//! Returns the 64 bit Morton code (Z-order) of a two dimensional cell.
+//! Bits of `x` are stored in the even bits of the code and bits of `y` in the
+//! odd bits.
+//! \note Components must be non-negative.
+//! \note Uses the BMI2 `pdep` instruction when `__BMI2__` is defined (e.g.
+//! compiling with `-mbmi2` or `/arch:AVX2`).
+uint64_t morton_encode(const vec2i& cell);
+
+//! Returns the 64 bit Morton code (Z-order) of a three dimensional cell.
+//! Bits of `x`, `y` and `z` are stored in every third bit of the code starting
+//! at bits 0, 1 and 2 respectively.
+//! \note Components must be non-negative and less than `2^21`.
+//! \note Uses the BMI2 `pdep` instruction when `__BMI2__` is defined.
+uint64_t morton_encode(const vec3i& cell);
+
+//! Returns the two dimensional cell of a 64 bit Morton code.
+//! \note Inverse of ::morton_encode(const vec2i&).
+vec2i morton_decode2(uint64_t code);
+
+//! Returns the three dimensional cell of a 64 bit Morton code.
+//! \note Inverse of ::morton_encode(const vec3i&).
+vec3i morton_decode3(uint64_t code);
+
+//! Returns the 64 bit Hilbert curve index of a two dimensional cell.
+//! \note Hilbert order has better locality than Morton order (consecutive
+//! indices are always neighboring cells) at a slightly higher cost.
+//! \note Components must be non-negative.
+uint64_t hilbert_encode(const vec2i& cell);
+
+//! Returns the 64 bit Hilbert curve index of a three dimensional cell.
+//! \note Components must be non-negative and less than `2^21`.
+uint64_t hilbert_encode(const vec3i& cell);
+
+//! Returns the two dimensional cell of a 64 bit Hilbert curve index.
+//! \note Inverse of ::hilbert_encode(const vec2i&).
+vec2i hilbert_decode2(uint64_t code);
+
+//! Returns the three dimensional cell of a 64 bit Hilbert curve index.
+//! \note Inverse of ::hilbert_encode(const vec3i&).
+vec3i hilbert_decode3(uint64_t code);
+
+//! Returns the cell of a grid with `2^bits` cells along each axis spanning
+//! `min` to `max` that the position falls in.
+//! \note Positions outside of `min` and `max` are clamped to the first or last
+//! cell.
+//! \note Every position is in cell 0 along axes where `max` equals `min` (a
+//! flat set of points or a single point).
+//! \param position The position to quantize.
+//! \param min The minimum corner of the grid (usually the bounds of the set
+//! of points being encoded).
+//! \param max The maximum corner of the grid.
+//! \param bits The number of bits per component of the cell (at most `21` for
+//! three dimensional and `31` for two dimensional cells).
+template<typename T, index d>
+vec<int32_t, d> vec_quantize(
+  const vec<T, d>& position, const vec<T, d>& min, const vec<T, d>& max,
+  int32_t bits);
+
+//! Writes the Morton code of each cell to `codes`.
+//! \note `codes` must have space for at least `count` elements.
+template<index d>
+void morton_encode(const vec<int32_t, d>* cells, index count, uint64_t* codes);
+
+//! Writes the Hilbert curve index of each cell to `codes`.
+//! \note `codes` must have space for at least `count` elements.
+template<index d>
+void hilbert_encode(const vec<int32_t, d>* cells, index count, uint64_t* codes);
+
+//! Writes the Morton code of each position (quantized to a grid spanning `min`
+//! to `max`, see ::vec_quantize) to `codes`.
+//! \note Positions are quantized using the maximum number of bits available to
+//! the dimension (`21` for three dimensions and `31` for two).
+//! \note `codes` must have space for at least `count` elements.
+template<typename T, index d, typename Executor = serial_executor>
+void morton_encode_positions(
+  const vec<T, d>* positions, index count, const vec<T, d>& min,
+  const vec<T, d>& max, uint64_t* codes, const Executor& executor = Executor{});
+
+//! The number of elements processed by each chunk of ::radix_sort.
+constexpr index k_radix_sort_chunk_size = 65536;
+
+//! Sorts `keys` in ascending order and applies the same reordering to
+//! `values`.
+//! \note This is a stable least significant digit radix sort (8 bits per pass)
+//! so the result does not depend on the executor used. Each pass counts and
+//! scatters chunks independently.
+//! \note Passes where every key has the same digit are skipped, so sorting
+//! codes with few significant bits (or `key_bits` set to the number of bits
+//! actually used) is cheaper.
+//! \note A common use is to pass the Morton or Hilbert code of each point in
+//! `keys` and the index of each point in `values`, then reorder the points
+//! using the sorted indices.
+//! \param keys The keys to sort (sorted in place).
+//! \param values Values associated with each key (reordered in place).
+//! \param count The number of keys and values.
+//! \param key_bits The number of low bits of each key to sort by.
+//! \param executor The executor to process chunks with (see
+//! ::serial_executor).
+template<typename Value, typename Executor = serial_executor>
+void radix_sort(
+  uint64_t* keys, Value* values, index count, int32_t key_bits = 64,
+  const Executor& executor = Executor{});
+
+} // namespace as
+
+#include "as-morton.inl"
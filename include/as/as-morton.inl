@@ -0,0 +1,347 @@
+namespace as
+{
+
+namespace internal
+{
+
+constexpr uint64_t k_morton2_mask_x = 0x5555555555555555;
+constexpr uint64_t k_morton2_mask_y = 0xaaaaaaaaaaaaaaaa;
+constexpr uint64_t k_morton3_mask_x = 0x1249249249249249;
+constexpr uint64_t k_morton3_mask_y = 0x2492492492492492;
+constexpr uint64_t k_morton3_mask_z = 0x4924924924924924;
+
+// spreads the low 32 bits of v into the even bits of the result
+AS_API constexpr uint64_t morton2_expand(uint64_t v)
+{
+  v &= 0x00000000ffffffff;
+  v = (v | (v << 16)) & 0x0000ffff0000ffff;
+  v = (v | (v << 8)) & 0x00ff00ff00ff00ff;
+  v = (v | (v << 4)) & 0x0f0f0f0f0f0f0f0f;
+  v = (v | (v << 2)) & 0x3333333333333333;
+  v = (v | (v << 1)) & 0x5555555555555555;
+  return v;
+}
+
+// gathers the even bits of v into the low 32 bits of the result
+AS_API constexpr uint64_t morton2_compact(uint64_t v)
+{
+  v &= 0x5555555555555555;
+  v = (v | (v >> 1)) & 0x3333333333333333;
+  v = (v | (v >> 2)) & 0x0f0f0f0f0f0f0f0f;
+  v = (v | (v >> 4)) & 0x00ff00ff00ff00ff;
+  v = (v | (v >> 8)) & 0x0000ffff0000ffff;
+  v = (v | (v >> 16)) & 0x00000000ffffffff;
+  return v;
+}
+
+// spreads the low 21 bits of v into every third bit of the result
+AS_API constexpr uint64_t morton3_expand(uint64_t v)
+{
+  v &= 0x00000000001fffff;
+  v = (v | (v << 32)) & 0x001f00000000ffff;
+  v = (v | (v << 16)) & 0x001f0000ff0000ff;
+  v = (v | (v << 8)) & 0x100f00f00f00f00f;
+  v = (v | (v << 4)) & 0x10c30c30c30c30c3;
+  v = (v | (v << 2)) & 0x1249249249249249;
+  return v;
+}
+
+// gathers every third bit of v into the low 21 bits of the result
+AS_API constexpr uint64_t morton3_compact(uint64_t v)
+{
+  v &= 0x1249249249249249;
+  v = (v | (v >> 2)) & 0x10c30c30c30c30c3;
+  v = (v | (v >> 4)) & 0x100f00f00f00f00f;
+  v = (v | (v >> 8)) & 0x001f0000ff0000ff;
+  v = (v | (v >> 16)) & 0x001f00000000ffff;
+  v = (v | (v >> 32)) & 0x00000000001fffff;
+  return v;
+}
+
+// ref: John Skilling (2004) Programming the Hilbert curve, AIP Conference
+// Proceedings 707, 381
+// converts axes to the 'transposed' Hilbert index (interleaving the bits of
+// the result, x[0] most significant, gives the Hilbert index)
+template<index d>
+AS_API void hilbert_axes_to_transpose(uint32_t (&x)[d], const int32_t bits)
+{
+  const uint32_t m = uint32_t(1) << (bits - 1);
+  // inverse undo
+  for (uint32_t q = m; q > 1; q >>= 1) {
+    const uint32_t p = q - 1;
+    for (index i = 0; i < d; ++i) {
+      if ((x[i] & q) != 0) {
+        x[0] ^= p; // invert
+      } else {
+        const uint32_t t = (x[0] ^ x[i]) & p; // exchange
+        x[0] ^= t;
+        x[i] ^= t;
+      }
+    }
+  }
+  // gray encode
+  for (index i = 1; i < d; ++i) {
+    x[i] ^= x[i - 1];
+  }
+  uint32_t t = 0;
+  for (uint32_t q = m; q > 1; q >>= 1) {
+    if ((x[d - 1] & q) != 0) {
+      t ^= q - 1;
+    }
+  }
+  for (index i = 0; i < d; ++i) {
+    x[i] ^= t;
+  }
+}
+
+template<index d>
+AS_API void hilbert_transpose_to_axes(uint32_t (&x)[d], const int32_t bits)
+{
+  const uint32_t m = uint32_t(1) << (bits - 1);
+  // gray decode by h ^ (h / 2)
+  uint32_t t = x[d - 1] >> 1;
+  for (index i = d - 1; i > 0; --i) {
+    x[i] ^= x[i - 1];
+  }
+  x[0] ^= t;
+  // undo excess work
+  for (uint32_t q = 2; q != 0 && q <= m; q <<= 1) {
+    const uint32_t p = q - 1;
+    for (index i = d - 1; i >= 0; --i) {
+      if ((x[i] & q) != 0) {
+        x[0] ^= p; // invert
+      } else {
+        t = (x[0] ^ x[i]) & p; // exchange
+        x[0] ^= t;
+        x[i] ^= t;
+      }
+    }
+  }
+}
+
+template<index d>
+AS_API constexpr int32_t morton_bits()
+{
+  static_assert(d == 2 || d == 3, "Morton codes support 2 or 3 dimensions");
+  return d == 2 ? 32 : 21;
+}
+
+} // namespace internal
+
+AS_API inline uint64_t morton_encode(const vec2i& cell)
+{
+#if defined __BMI2__
+  return _pdep_u64(uint32_t(cell.x), internal::k_morton2_mask_x)
+       | _pdep_u64(uint32_t(cell.y), internal::k_morton2_mask_y);
+#else
+  return internal::morton2_expand(uint32_t(cell.x))
+       | (internal::morton2_expand(uint32_t(cell.y)) << 1);
+#endif // __BMI2__
+}
+
+AS_API inline uint64_t morton_encode(const vec3i& cell)
+{
+#if defined __BMI2__
+  return _pdep_u64(uint32_t(cell.x), internal::k_morton3_mask_x)
+       | _pdep_u64(uint32_t(cell.y), internal::k_morton3_mask_y)
+       | _pdep_u64(uint32_t(cell.z), internal::k_morton3_mask_z);
+#else
+  return internal::morton3_expand(uint32_t(cell.x))
+       | (internal::morton3_expand(uint32_t(cell.y)) << 1)
+       | (internal::morton3_expand(uint32_t(cell.z)) << 2);
+#endif // __BMI2__
+}
+
+AS_API inline vec2i morton_decode2(const uint64_t code)
+{
+#if defined __BMI2__
+  return {
+    int32_t(_pext_u64(code, internal::k_morton2_mask_x)),
+    int32_t(_pext_u64(code, internal::k_morton2_mask_y))};
+#else
+  return {
+    int32_t(internal::morton2_compact(code)),
+    int32_t(internal::morton2_compact(code >> 1))};
+#endif // __BMI2__
+}
+
+AS_API inline vec3i morton_decode3(const uint64_t code)
+{
+#if defined __BMI2__
+  return {
+    int32_t(_pext_u64(code, internal::k_morton3_mask_x)),
+    int32_t(_pext_u64(code, internal::k_morton3_mask_y)),
+    int32_t(_pext_u64(code, internal::k_morton3_mask_z))};
+#else
+  return {
+    int32_t(internal::morton3_compact(code)),
+    int32_t(internal::morton3_compact(code >> 1)),
+    int32_t(internal::morton3_compact(code >> 2))};
+#endif // __BMI2__
+}
+
+AS_API inline uint64_t hilbert_encode(const vec2i& cell)
+{
+  uint32_t x[] = {uint32_t(cell.x), uint32_t(cell.y)};
+  internal::hilbert_axes_to_transpose(x, internal::morton_bits<2>());
+  // x[0] holds the most significant bit of each pair
+  return morton_encode(vec2i(int32_t(x[1]), int32_t(x[0])));
+}
+
+AS_API inline uint64_t hilbert_encode(const vec3i& cell)
+{
+  uint32_t x[] = {uint32_t(cell.x), uint32_t(cell.y), uint32_t(cell.z)};
+  internal::hilbert_axes_to_transpose(x, internal::morton_bits<3>());
+  // x[0] holds the most significant bit of each triple
+  return morton_encode(vec3i(int32_t(x[2]), int32_t(x[1]), int32_t(x[0])));
+}
+
+AS_API inline vec2i hilbert_decode2(const uint64_t code)
+{
+  const vec2i transpose = morton_decode2(code);
+  uint32_t x[] = {uint32_t(transpose.y), uint32_t(transpose.x)};
+  internal::hilbert_transpose_to_axes(x, internal::morton_bits<2>());
+  return {int32_t(x[0]), int32_t(x[1])};
+}
+
+AS_API inline vec3i hilbert_decode3(const uint64_t code)
+{
+  const vec3i transpose = morton_decode3(code);
+  uint32_t x[] = {
+    uint32_t(transpose.z), uint32_t(transpose.y), uint32_t(transpose.x)};
+  internal::hilbert_transpose_to_axes(x, internal::morton_bits<3>());
+  return {int32_t(x[0]), int32_t(x[1]), int32_t(x[2])};
+}
+
+template<typename T, index d>
+AS_API vec<int32_t, d> vec_quantize(
+  const vec<T, d>& position, const vec<T, d>& min, const vec<T, d>& max,
+  const int32_t bits)
+{
+  const T cells = T(int64_t(1) << bits);
+  const int64_t last_cell = (int64_t(1) << bits) - 1;
+  vec<int32_t, d> result;
+  for (index i = 0; i < d; ++i) {
+    // axes with no extent (e.g. a flat or single point set) map to cell 0
+    const T extent = max[i] - min[i];
+    const T scale = extent > T(0.0) ? cells / extent : T(0.0);
+    const T cell = std::floor((position[i] - min[i]) * scale);
+    // clamped to [0, cells] first (the last cell is only exact as an
+    // integer, cells - 1 rounds up to cells for float when bits is greater
+    // than 24)
+    const T clamped = std::min(std::max(cell, T(0.0)), cells);
+    result[i] = int32_t(std::min(int64_t(clamped), last_cell));
+  }
+  return result;
+}
+
+template<index d>
+AS_API void morton_encode(
+  const vec<int32_t, d>* cells, const index count, uint64_t* codes)
+{
+  for (index i = 0; i < count; ++i) {
+    codes[i] = morton_encode(cells[i]);
+  }
+}
+
+template<index d>
+AS_API void hilbert_encode(
+  const vec<int32_t, d>* cells, const index count, uint64_t* codes)
+{
+  for (index i = 0; i < count; ++i) {
+    codes[i] = hilbert_encode(cells[i]);
+  }
+}
+
+template<typename T, index d, typename Executor>
+AS_API void morton_encode_positions(
+  const vec<T, d>* positions, const index count, const vec<T, d>& min,
+  const vec<T, d>& max, uint64_t* codes, const Executor& executor)
+{
+  // two dimensional cells are limited to 31 bits to remain non-negative
+  constexpr int32_t bits = d == 2 ? 31 : internal::morton_bits<d>();
+  constexpr index chunk_size = 4096;
+  executor(chunk_count(count, chunk_size), [&](const index chunk) {
+    const index end = chunk_end(chunk, count, chunk_size);
+    for (index i = chunk_begin(chunk, chunk_size); i < end; ++i) {
+      codes[i] = morton_encode(vec_quantize(positions[i], min, max, bits));
+    }
+  });
+}
+
+template<typename Value, typename Executor>
+AS_API void radix_sort(
+  uint64_t* keys, Value* values, const index count, const int32_t key_bits,
+  const Executor& executor)
+{
+  constexpr int32_t digit_bits = 8;
+  constexpr index bucket_count = index(1) << digit_bits;
+  constexpr index chunk_size = k_radix_sort_chunk_size;
+
+  const index chunks = chunk_count(count, chunk_size);
+  std::vector<uint64_t> keys_scratch(count);
+  std::vector<Value> values_scratch(count);
+  // offsets[chunk * bucket_count + bucket]
+  std::vector<index> offsets(chunks * bucket_count);
+
+  uint64_t* keys_in = keys;
+  uint64_t* keys_out = keys_scratch.data();
+  Value* values_in = values;
+  Value* values_out = values_scratch.data();
+
+  for (int32_t shift = 0; shift < key_bits; shift += digit_bits) {
+    const auto digit = [shift](const uint64_t key) {
+      return index((key >> shift) & (bucket_count - 1));
+    };
+
+    // histogram each chunk
+    executor(chunks, [&](const index chunk) {
+      index* histogram = offsets.data() + chunk * bucket_count;
+      std::fill(histogram, histogram + bucket_count, index(0));
+      const index end = chunk_end(chunk, count, chunk_size);
+      for (index i = chunk_begin(chunk, chunk_size); i < end; ++i) {
+        ++histogram[digit(keys_in[i])];
+      }
+    });
+
+    // exclusive prefix sum over buckets (outer) and chunks (inner) so each
+    // chunk scatters to its own range within a bucket (keeps the sort stable)
+    index total = 0;
+    bool single_bucket = false;
+    for (index bucket = 0; bucket < bucket_count; ++bucket) {
+      const index bucket_begin = total;
+      for (index chunk = 0; chunk < chunks; ++chunk) {
+        index& offset = offsets[chunk * bucket_count + bucket];
+        const index bucket_size = offset;
+        offset = total;
+        total += bucket_size;
+      }
+      single_bucket = single_bucket || total - bucket_begin == count;
+    }
+
+    // every key has the same digit, the order is unchanged
+    if (single_bucket) {
+      continue;
+    }
+
+    executor(chunks, [&](const index chunk) {
+      index* chunk_offsets = offsets.data() + chunk * bucket_count;
+      const index end = chunk_end(chunk, count, chunk_size);
+      for (index i = chunk_begin(chunk, chunk_size); i < end; ++i) {
+        const index destination = chunk_offsets[digit(keys_in[i])]++;
+        keys_out[destination] = keys_in[i];
+        values_out[destination] = values_in[i];
+      }
+    });
+
+    std::swap(keys_in, keys_out);
+    std::swap(values_in, values_out);
+  }
+
+  if (keys_in != keys) {
+    std::copy(keys_in, keys_in + count, keys);
+    std::copy(values_in, values_in + count, values);
+  }
+}
+
+} // namespace as
@@ -0,0 +1,85 @@
+//! \file
+//! `as-occlusion`
+
+#pragma once
+
+#include "as-frustum.hpp"
+#include "as-raster.hpp"
+
+namespace as
+{
+
+//! Represents a \ref depth_pyramid (the minimum and maximum depth of each
+//! region of a depth buffer at successively halved resolutions).
+//! \note Level 0 is the depth buffer itself. Each texel of level `n + 1`
+//! holds the minimum and maximum of the (up to) 2x2 texels of level `n` it
+//! covers, the last level is a single texel.
+//! \note Texel `(x, y)` of level `n` is at
+//! `level_offsets[n] + y * level_dimensions[n].x + x`.
+struct depth_pyramid
+{
+  //! The depth range of the depth buffer (see ::raster_target_create).
+  vec2 depth_range;
+  std::vector<vec2i> level_dimensions; //!< The width and height of each level.
+  std::vector<index> level_offsets; //!< The first texel of each level.
+  std::vector<float> min_depth; //!< The minimum depth of each texel.
+  std::vector<float> max_depth; //!< The maximum depth of each texel.
+};
+
+//! Builds the \ref depth_pyramid of the depth buffer of a \ref raster_target.
+//! \note Occluders are usually drawn with ::rasterize_triangles to a low
+//! resolution target (e.g. 256x128) first, only large simplified occluders
+//! need to be drawn. Depth is sampled at pixel centers so an occluder only
+//! partially covering a pixel may still hide objects behind that pixel.
+//! \note Storage already allocated by the pyramid is reused.
+//! \note The target must be at most 65536 pixels across.
+//! \param pyramid The pyramid to build.
+//! \param target The target with the depth of the occluders.
+//! \param executor The executor to process rows of each level with (see
+//! ::serial_executor).
+template<typename Executor = serial_executor>
+void depth_pyramid_build(
+  depth_pyramid& pyramid, const raster_target& target,
+  const Executor& executor = Executor{});
+
+//! Returns if the \ref aabb is entirely behind the occluders in the
+//! \ref depth_pyramid.
+//! \note The box is projected to screen space and the level of the pyramid
+//! where its bounds cover at most 2x2 texels is chosen. The box is occluded
+//! when its closest depth is farther than the farthest depth of those texels.
+//! \note Boxes crossing the near plane and boxes entirely off screen are never
+//! occluded (use ::frustum_cull_aabbs to reject boxes outside the view).
+//! \param pyramid The pyramid to test against.
+//! \param view_projection The view projection matrix the occluders were drawn
+//! with (see ::view_projection).
+//! \param bounds The box to test.
+bool depth_pyramid_occludes_aabb(
+  const depth_pyramid& pyramid, const mat4& view_projection,
+  const aabb& bounds);
+
+//! Tests an array of boxes against the \ref depth_pyramid and writes the
+//! result to a bitmask (bit `i % 32` of `visibility[i / 32]` is set if box
+//! `i` is not occluded, see ::depth_pyramid_occludes_aabb).
+//! \note Boxes are processed in blocks, first the corners of every box in the
+//! block are projected, then the level and texels to read are found and
+//! finally the texels are read and compared. Each step is a separate loop
+//! over the block (texel offsets are found with integer shifts and the
+//! level with a fixed number of comparisons, so no box branches).
+//! \note `visibility` must have space for `chunk_count(count, 32)` elements.
+//! \param pyramid The pyramid to test against.
+//! \param view_projection The view projection matrix the occluders were drawn
+//! with (see ::view_projection).
+//! \param boxes The boxes to test.
+//! \param count The number of boxes.
+//! \param visibility The bitmask to write to.
+//! \param executor The executor to process chunks with (see
+//! ::serial_executor).
+template<typename Executor = serial_executor>
+void occlusion_cull_aabbs(
+  const depth_pyramid& pyramid, const mat4& view_projection,
+  const aabb_soa_t<real>& boxes, index count, uint32_t* visibility,
+  const Executor& executor = Executor{});
+
+} // namespace as
+
+#include "as-occlusion.inl"
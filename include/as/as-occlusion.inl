@@ -0,0 +1,278 @@
+namespace as
+{
+
+namespace internal
+{
+
+// projects the boxes [begin, end) to normalized device coordinates and writes
+// the bounds of their corners and their closest depth (remapped to [0, 1] the
+// same as the rasterizer and negated when reversed so closer is always less,
+// boxes crossing the near plane are given the lowest depth so they are never
+// occluded), outputs are relative to begin
+AS_API inline void occlusion_project_aabbs(
+  const mat4& view_projection, const vec2& depth_range,
+  const aabb_soa_t<real>& boxes, const index begin, const index end,
+  real* ndc_min_x, real* ndc_min_y, real* ndc_max_x, real* ndc_max_y,
+  real* closest)
+{
+  const real depth_sign = depth_range.y > depth_range.x ? 1.0_r : -1.0_r;
+  const real near_depth = depth_range.x;
+  // the closest depth is remapped after the minimum of the corners is found
+  // (the remapping is increasing so the minimum is unchanged)
+  const real depth_offset =
+    std::min(depth_range.x, depth_range.y) * depth_sign;
+  const real inv_depth_scale =
+    1.0_r / std::abs(depth_range.y - depth_range.x);
+  // copy to locals so they are not reloaded after every store
+  real m[16];
+  std::copy(
+    mat_const_data(view_projection), mat_const_data(view_projection) + 16, m);
+  for (index i = begin; i < end; ++i) {
+    real min_x = std::numeric_limits<real>::max();
+    real min_y = std::numeric_limits<real>::max();
+    real max_x = std::numeric_limits<real>::lowest();
+    real max_y = std::numeric_limits<real>::lowest();
+    real min_depth = std::numeric_limits<real>::max();
+    bool behind = false;
+    // each corner is expanded explicitly so the loop over boxes has no
+    // control flow
+    const auto corner = [&](const real cx, const real cy, const real cz) {
+      const real clip_x = cx * m[0] + cy * m[4] + cz * m[8] + m[12];
+      const real clip_y = cx * m[1] + cy * m[5] + cz * m[9] + m[13];
+      const real clip_z = cx * m[2] + cy * m[6] + cz * m[10] + m[14];
+      const real clip_w = cx * m[3] + cy * m[7] + cz * m[11] + m[15];
+      behind |= (clip_z - clip_w * near_depth) * depth_sign < 0.0_r;
+      // avoid dividing by zero (the result is discarded when behind)
+      const real inv_w = 1.0_r / (clip_w + real(clip_w == 0.0_r));
+      min_x = std::min(min_x, clip_x * inv_w);
+      min_y = std::min(min_y, clip_y * inv_w);
+      max_x = std::max(max_x, clip_x * inv_w);
+      max_y = std::max(max_y, clip_y * inv_w);
+      min_depth = std::min(min_depth, clip_z * inv_w * depth_sign);
+    };
+    const real x0 = boxes.min_x[i];
+    const real y0 = boxes.min_y[i];
+    const real z0 = boxes.min_z[i];
+    const real x1 = boxes.max_x[i];
+    const real y1 = boxes.max_y[i];
+    const real z1 = boxes.max_z[i];
+    corner(x0, y0, z0);
+    corner(x1, y0, z0);
+    corner(x0, y1, z0);
+    corner(x1, y1, z0);
+    corner(x0, y0, z1);
+    corner(x1, y0, z1);
+    corner(x0, y1, z1);
+    corner(x1, y1, z1);
+    ndc_min_x[i - begin] = min_x;
+    ndc_min_y[i - begin] = min_y;
+    ndc_max_x[i - begin] = max_x;
+    ndc_max_y[i - begin] = max_y;
+    closest[i - begin] =
+      behind ? std::numeric_limits<real>::lowest()
+             : (min_depth - depth_offset) * inv_depth_scale;
+  }
+}
+
+// the number of boxes projected and tested together (bounds the size of the
+// temporary arrays on the stack)
+constexpr index k_occlusion_block_size = 256;
+
+// writes the difference between the farthest depth of the pyramid within the
+// bounds of each box in [begin, end) and the closest depth of the box
+// (negative if occluded) to margin (relative to begin)
+AS_API inline void occlusion_test_aabbs(
+  const depth_pyramid& pyramid, const mat4& view_projection,
+  const aabb_soa_t<real>& boxes, const index begin, const index end,
+  real* margin)
+{
+  real ndc_min_x[k_occlusion_block_size];
+  real ndc_min_y[k_occlusion_block_size];
+  real ndc_max_x[k_occlusion_block_size];
+  real ndc_max_y[k_occlusion_block_size];
+  real closest[k_occlusion_block_size];
+  occlusion_project_aabbs(
+    view_projection, pyramid.depth_range, boxes, begin, end, ndc_min_x,
+    ndc_min_y, ndc_max_x, ndc_max_y, closest);
+
+  // the first texel and width of each level (read together with the level
+  // of each box, enough levels for a target 65536 pixels across)
+  const auto level_count =
+    std::min(index(pyramid.level_dimensions.size()), index(17));
+  int32_t level_offset[17] = {};
+  int32_t level_width[17] = {};
+  for (index level = 0; level < level_count; ++level) {
+    level_offset[level] = int32_t(pyramid.level_offsets[level]);
+    level_width[level] = pyramid.level_dimensions[level].x;
+  }
+
+  // the texels to read at the first level where the bounds of each box cover
+  // at most 2x2 texels
+  int32_t texel00[k_occlusion_block_size];
+  int32_t texel01[k_occlusion_block_size];
+  int32_t texel10[k_occlusion_block_size];
+  int32_t texel11[k_occlusion_block_size];
+  const vec2i& dimension = pyramid.level_dimensions.front();
+  const auto width = real(dimension.x);
+  const auto height = real(dimension.y);
+  const auto last_level = int32_t(level_count) - 1;
+  const index count = end - begin;
+  for (index i = 0; i < count; ++i) {
+    const real screen_min_x = (ndc_min_x[i] + 1.0_r) * 0.5_r * width;
+    const real screen_max_x = (ndc_max_x[i] + 1.0_r) * 0.5_r * width;
+    const real screen_min_y = (1.0_r - ndc_max_y[i]) * 0.5_r * height;
+    const real screen_max_y = (1.0_r - ndc_min_y[i]) * 0.5_r * height;
+    // boxes crossing the near plane or entirely off screen are never
+    // occluded
+    const bool skip = (closest[i] == std::numeric_limits<real>::lowest())
+                    | (screen_max_x < 0.0_r) | (screen_min_x >= width)
+                    | (screen_max_y < 0.0_r) | (screen_min_y >= height);
+    closest[i] = skip ? std::numeric_limits<real>::lowest() : closest[i];
+    // the pixels touched by the bounds (the lower limit is first so values
+    // that are not finite are clamped)
+    const auto x0 =
+      int32_t(std::min(std::max(0.0_r, screen_min_x), width - 1.0_r));
+    const auto y0 =
+      int32_t(std::min(std::max(0.0_r, screen_min_y), height - 1.0_r));
+    const auto x1 =
+      int32_t(std::min(std::max(0.0_r, screen_max_x), width - 1.0_r));
+    const auto y1 =
+      int32_t(std::min(std::max(0.0_r, screen_max_y), height - 1.0_r));
+    // the level where 2^level >= extent (so a span of pixels is at most two
+    // texels)
+    const int32_t extent = std::max(x1 - x0, y1 - y0);
+    int32_t level = 0;
+    for (int32_t bit = 0; bit < 16; ++bit) {
+      level += extent > (1 << bit) ? 1 : 0;
+    }
+    level = std::min(level, last_level);
+    const int32_t offset = level_offset[level];
+    const int32_t row0 = (y0 >> level) * level_width[level];
+    const int32_t row1 = (y1 >> level) * level_width[level];
+    texel00[i] = offset + row0 + (x0 >> level);
+    texel01[i] = offset + row0 + (x1 >> level);
+    texel10[i] = offset + row1 + (x0 >> level);
+    texel11[i] = offset + row1 + (x1 >> level);
+  }
+
+  // the farthest texel (the greatest depth unless reversed)
+  const real depth_sign =
+    pyramid.depth_range.y > pyramid.depth_range.x ? 1.0_r : -1.0_r;
+  const float* farthest = depth_sign > 0.0_r ? pyramid.max_depth.data()
+                                             : pyramid.min_depth.data();
+  for (index i = 0; i < count; ++i) {
+    const real farthest_depth = std::max(
+      std::max(
+        real(farthest[texel00[i]]) * depth_sign,
+        real(farthest[texel01[i]]) * depth_sign),
+      std::max(
+        real(farthest[texel10[i]]) * depth_sign,
+        real(farthest[texel11[i]]) * depth_sign));
+    // boxes that are never occluded have the lowest depth so the margin is
+    // always positive
+    margin[i] = farthest_depth - closest[i];
+  }
+}
+
+} // namespace internal
+
+template<typename Executor>
+AS_API void depth_pyramid_build(
+  depth_pyramid& pyramid, const raster_target& target,
+  const Executor& executor)
+{
+  pyramid.depth_range = target.depth_range;
+  pyramid.level_dimensions.clear();
+  pyramid.level_offsets.clear();
+  index texel_count = 0;
+  vec2i dimension = target.dimension;
+  while (true) {
+    pyramid.level_dimensions.push_back(dimension);
+    pyramid.level_offsets.push_back(texel_count);
+    texel_count += index(dimension.x) * dimension.y;
+    if (dimension.x <= 1 && dimension.y <= 1) {
+      break;
+    }
+    dimension = vec2i((dimension.x + 1) / 2, (dimension.y + 1) / 2);
+  }
+  pyramid.min_depth.resize(texel_count);
+  pyramid.max_depth.resize(texel_count);
+
+  // level 0 is the depth buffer without the padding at the end of each row
+  const vec2i& base = target.dimension;
+  executor(base.y, [&](const index y) {
+    const float* row = target.depth.data() + y * target.stride;
+    std::copy(row, row + base.x, pyramid.min_depth.begin() + y * base.x);
+    std::copy(row, row + base.x, pyramid.max_depth.begin() + y * base.x);
+  });
+
+  for (index level = 1; level < index(pyramid.level_dimensions.size());
+       ++level) {
+    const vec2i& source = pyramid.level_dimensions[level - 1];
+    const vec2i& destination = pyramid.level_dimensions[level];
+    const index source_offset = pyramid.level_offsets[level - 1];
+    const index destination_offset = pyramid.level_offsets[level];
+    executor(destination.y, [&](const index y) {
+      // rows and columns past the edge of an odd sized level are repeated
+      const index y0 = y * 2;
+      const index y1 = std::min(y0 + 1, index(source.y) - 1);
+      const float* min_row0 =
+        pyramid.min_depth.data() + source_offset + y0 * source.x;
+      const float* min_row1 =
+        pyramid.min_depth.data() + source_offset + y1 * source.x;
+      const float* max_row0 =
+        pyramid.max_depth.data() + source_offset + y0 * source.x;
+      const float* max_row1 =
+        pyramid.max_depth.data() + source_offset + y1 * source.x;
+      float* min_out =
+        pyramid.min_depth.data() + destination_offset + y * destination.x;
+      float* max_out =
+        pyramid.max_depth.data() + destination_offset + y * destination.x;
+      for (index x = 0; x < destination.x; ++x) {
+        const index x0 = x * 2;
+        const index x1 = std::min(x0 + 1, index(source.x) - 1);
+        min_out[x] = std::min(
+          std::min(min_row0[x0], min_row0[x1]),
+          std::min(min_row1[x0], min_row1[x1]));
+        max_out[x] = std::max(
+          std::max(max_row0[x0], max_row0[x1]),
+          std::max(max_row1[x0], max_row1[x1]));
+      }
+    });
+  }
+}
+
+AS_API inline bool depth_pyramid_occludes_aabb(
+  const depth_pyramid& pyramid, const mat4& view_projection,
+  const aabb& bounds)
+{
+  const aabb_soa_t<real> boxes = {&bounds.min.x, &bounds.min.y, &bounds.min.z,
+                                  &bounds.max.x, &bounds.max.y, &bounds.max.z};
+  real margin;
+  internal::occlusion_test_aabbs(
+    pyramid, view_projection, boxes, 0, 1, &margin);
+  return margin < 0.0_r;
+}
+
+template<typename Executor>
+AS_API void occlusion_cull_aabbs(
+  const depth_pyramid& pyramid, const mat4& view_projection,
+  const aabb_soa_t<real>& boxes, const index count, uint32_t* visibility,
+  const Executor& executor)
+{
+  executor(chunk_count(count, k_cull_chunk_size), [&](const index chunk) {
+    const index begin = chunk_begin(chunk, k_cull_chunk_size);
+    const index end = chunk_end(chunk, count, k_cull_chunk_size);
+    real margin[k_cull_chunk_size];
+    for (index block = begin; block < end;
+         block += internal::k_occlusion_block_size) {
+      internal::occlusion_test_aabbs(
+        pyramid, view_projection, boxes, block,
+        std::min(block + internal::k_occlusion_block_size, end),
+        margin + (block - begin));
+    }
+    internal::cull_write_bits(margin, begin, end, visibility);
+  });
+}
+
+} // namespace as
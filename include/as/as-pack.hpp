@@ -0,0 +1,157 @@
+//! \file
+//! `as-pack`
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "as-math-ops.hpp"
+
+namespace as
+{
+
+//! Returns the unit quaternion packed into 32 bits (smallest three encoding).
+//! \note The largest component is dropped (it is recomputed from the other
+//! three when unpacking), the quaternion is negated if it is negative so its
+//! sign does not need to be stored (both represent the same rotation). The
+//! index of the largest component is stored in the low 2 bits and the
+//! remaining three components (which are in the range
+//! `[-1/sqrt(2), 1/sqrt(2)]`) in 10 bits each.
+//! \note The rotation of the unpacked quaternion differs from the original by
+//! at most `0.005` radians (0.29 degrees).
+//! \note The quaternion must be normalized.
+uint32_t quat_pack_smallest3_32(const quat& q);
+
+//! Returns the unit quaternion packed into the low 48 bits of the result
+//! (smallest three encoding with 15 bits per component, see
+//! ::quat_pack_smallest3_32).
+//! \note The rotation of the unpacked quaternion differs from the original by
+//! at most `0.00015` radians.
+//! \note The quaternion must be normalized.
+uint64_t quat_pack_smallest3_48(const quat& q);
+
+//! Returns the unit quaternion packed into the low 62 bits of the result
+//! (smallest three encoding with 20 bits per component, see
+//! ::quat_pack_smallest3_32).
+//! \note The rotation of the unpacked quaternion differs from the original by
+//! at most `0.000005` radians.
+//! \note The quaternion must be normalized.
+uint64_t quat_pack_smallest3_64(const quat& q);
+
+//! Returns the unit quaternion from a value packed with
+//! ::quat_pack_smallest3_32.
+quat quat_unpack_smallest3_32(uint32_t packed);
+
+//! Returns the unit quaternion from a value packed with
+//! ::quat_pack_smallest3_48.
+quat quat_unpack_smallest3_48(uint64_t packed);
+
+//! Returns the unit quaternion from a value packed with
+//! ::quat_pack_smallest3_64.
+quat quat_unpack_smallest3_64(uint64_t packed);
+
+//! Writes each unit quaternion packed with ::quat_pack_smallest3_32 to
+//! `packed`.
+//! \note The largest component is chosen with arithmetic selects and each
+//! component is clamped as an integer, so every quaternion runs the same
+//! instructions.
+//! \note `packed` must have space for at least `count` elements.
+void quat_pack_smallest3_32(const quat* quats, index count, uint32_t* packed);
+
+//! Writes each unit quaternion packed with ::quat_pack_smallest3_48 to
+//! `packed`.
+//! \note `packed` must have space for at least `count` elements.
+void quat_pack_smallest3_48(const quat* quats, index count, uint64_t* packed);
+
+//! Writes each unit quaternion packed with ::quat_pack_smallest3_64 to
+//! `packed`.
+//! \note `packed` must have space for at least `count` elements.
+void quat_pack_smallest3_64(const quat* quats, index count, uint64_t* packed);
+
+//! Writes each unit quaternion unpacked with ::quat_unpack_smallest3_32 to
+//! `quats`.
+//! \note `quats` must have space for at least `count` elements.
+void quat_unpack_smallest3_32(
+  const uint32_t* packed, index count, quat* quats);
+
+//! Writes each unit quaternion unpacked with ::quat_unpack_smallest3_48 to
+//! `quats`.
+//! \note `quats` must have space for at least `count` elements.
+void quat_unpack_smallest3_48(
+  const uint64_t* packed, index count, quat* quats);
+
+//! Writes each unit quaternion unpacked with ::quat_unpack_smallest3_64 to
+//! `quats`.
+//! \note `quats` must have space for at least `count` elements.
+void quat_unpack_smallest3_64(
+  const uint64_t* packed, index count, quat* quats);
+
+//! Returns the unit vector packed into 16 bits (octahedral encoding).
+//! \note The vector is projected onto the octahedron `|x| + |y| + |z| = 1`
+//! and the lower half of the octahedron is folded over the upper half to map
+//! it to a square. The two coordinates of the square are stored in 8 bits
+//! each (`x` in the low bits).
+//! \note The direction of the unpacked vector differs from the original by at
+//! most `0.017` radians (0.95 degrees).
+//! \note The vector must be normalized.
+//! ref: Cigolle et al. (2014) A Survey of Efficient Representations for
+//! Independent Unit Vectors
+uint16_t vec3_pack_octahedral_16(const vec3& v);
+
+//! Returns the unit vector packed into the low 24 bits of the result
+//! (octahedral encoding with 12 bits per coordinate, see
+//! ::vec3_pack_octahedral_16).
+//! \note The direction of the unpacked vector differs from the original by at
+//! most `0.0011` radians (0.06 degrees).
+//! \note The vector must be normalized.
+uint32_t vec3_pack_octahedral_24(const vec3& v);
+
+//! Returns the unit vector packed into 32 bits (octahedral encoding with 16
+//! bits per coordinate, see ::vec3_pack_octahedral_16).
+//! \note The direction of the unpacked vector differs from the original by at
+//! most `0.00007` radians.
+//! \note The vector must be normalized.
+uint32_t vec3_pack_octahedral_32(const vec3& v);
+
+//! Returns the unit vector from a value packed with
+//! ::vec3_pack_octahedral_16.
+vec3 vec3_unpack_octahedral_16(uint16_t packed);
+
+//! Returns the unit vector from a value packed with
+//! ::vec3_pack_octahedral_24.
+vec3 vec3_unpack_octahedral_24(uint32_t packed);
+
+//! Returns the unit vector from a value packed with
+//! ::vec3_pack_octahedral_32.
+vec3 vec3_unpack_octahedral_32(uint32_t packed);
+
+//! Writes each unit vector packed with ::vec3_pack_octahedral_16 to `packed`.
+//! \note Each vector is packed with the same branch free code so the compiler
+//! can vectorize the loop.
+//! \note `packed` must have space for at least `count` elements.
+void vec3_pack_octahedral_16(const vec3* vs, index count, uint16_t* packed);
+
+//! Writes each unit vector packed with ::vec3_pack_octahedral_24 to `packed`.
+//! \note `packed` must have space for at least `count` elements.
+void vec3_pack_octahedral_24(const vec3* vs, index count, uint32_t* packed);
+
+//! Writes each unit vector packed with ::vec3_pack_octahedral_32 to `packed`.
+//! \note `packed` must have space for at least `count` elements.
+void vec3_pack_octahedral_32(const vec3* vs, index count, uint32_t* packed);
+
+//! Writes each unit vector unpacked with ::vec3_unpack_octahedral_16 to `vs`.
+//! \note `vs` must have space for at least `count` elements.
+void vec3_unpack_octahedral_16(const uint16_t* packed, index count, vec3* vs);
+
+//! Writes each unit vector unpacked with ::vec3_unpack_octahedral_24 to `vs`.
+//! \note `vs` must have space for at least `count` elements.
+void vec3_unpack_octahedral_24(const uint32_t* packed, index count, vec3* vs);
+
+//! Writes each unit vector unpacked with ::vec3_unpack_octahedral_32 to `vs`.
+//! \note `vs` must have space for at least `count` elements.
+void vec3_unpack_octahedral_32(const uint32_t* packed, index count, vec3* vs);
+
+} // namespace as
+
+#include "as-pack.inl"
@@ -0,0 +1,297 @@
+namespace as
+{
+
+namespace internal
+{
+
+// the smallest unsigned integer that holds the index of the largest component
+// and three components of Bits bits
+template<int Bits>
+using smallest3_t =
+  std::conditional_t<(Bits * 3 + 2 <= 32), uint32_t, uint64_t>;
+
+// returns the unit quaternion packed with the index of the largest component
+// in the low 2 bits and each of the other components in Bits bits (branch
+// free so it can be used in loops the compiler vectorizes)
+template<int Bits>
+AS_API inline smallest3_t<Bits> quat_pack_smallest3(const quat& q)
+{
+  using packed_t = smallest3_t<Bits>;
+  const real aw = std::abs(q.w);
+  const real ax = std::abs(q.x);
+  const real ay = std::abs(q.y);
+  const real az = std::abs(q.z);
+  // the index of the largest component from the larger of each pair
+  const auto x_larger = int32_t(ax > aw);
+  const auto z_larger = int32_t(az > ay);
+  const auto yz_larger = int32_t(std::max(ay, az) > std::max(aw, ax));
+  const int32_t largest =
+    yz_larger * (2 + z_larger) + (1 - yz_larger) * x_larger;
+  // one for the index of the largest component
+  const auto b0 = real(largest & 1);
+  const auto b1 = real(largest >> 1);
+  const real s0 = (1.0_r - b0) * (1.0_r - b1);
+  const real s1 = b0 * (1.0_r - b1);
+  const real s2 = (1.0_r - b0) * b1;
+  const real s3 = b0 * b1;
+  // negate so the largest component is positive
+  const real sign =
+    std::copysign(1.0_r, q.w * s0 + q.x * s1 + q.y * s2 + q.z * s3);
+  // components before the largest are in order, those after are shifted
+  const real a = q.w + (q.x - q.w) * s0;
+  const real b = q.x + (q.y - q.x) * (s0 + s1);
+  const real c = q.y + (q.z - q.y) * (1.0_r - s3);
+  // from [-1/sqrt(2), 1/sqrt(2)] to [0, 2^Bits - 1]
+  // (clamped as integers which the compiler can select without branches)
+  const real scale = std::sqrt(2.0_r) * 0.5_r * sign;
+  const auto quantize = [scale](const real component) {
+    constexpr int32_t max_value = (1 << Bits) - 1;
+    const auto quantized =
+      int32_t((component * scale + 0.5_r) * real(max_value) + 0.5_r);
+    return packed_t(std::min(std::max(quantized, 0), max_value));
+  };
+  return packed_t(largest) | quantize(a) << 2 | quantize(b) << (2 + Bits)
+       | quantize(c) << (2 + Bits * 2);
+}
+
+// returns the unit quaternion from the index of the largest component and the
+// other three components (branch free)
+AS_API inline quat quat_from_smallest3(
+  const int32_t largest, const real a, const real b, const real c)
+{
+  // one for the index of the largest component
+  const auto b0 = real(largest & 1);
+  const auto b1 = real(largest >> 1);
+  const real s0 = (1.0_r - b0) * (1.0_r - b1);
+  const real s1 = b0 * (1.0_r - b1);
+  const real s2 = (1.0_r - b0) * b1;
+  const real s3 = b0 * b1;
+  const real l = std::sqrt(std::max(0.0_r, 1.0_r - a * a - b * b - c * c));
+  // components before the largest are in order, those after are shifted
+  return quat(
+    a + (l - a) * s0, a * s0 + l * s1 + b * (s2 + s3),
+    b * (s0 + s1) + l * s2 + c * s3, c + (l - c) * s3);
+}
+
+// returns the component of a quaternion quantized to Bits bits by
+// quat_pack_smallest3
+template<int Bits>
+AS_API inline real quat_smallest3_component(const int32_t quantized)
+{
+  const real sqrt2 = std::sqrt(2.0_r);
+  return real(quantized) * (sqrt2 / real((1 << Bits) - 1)) - sqrt2 * 0.5_r;
+}
+
+// returns the unit quaternion packed with quat_pack_smallest3
+template<int Bits>
+AS_API inline quat quat_unpack_smallest3(const smallest3_t<Bits> packed)
+{
+  constexpr smallest3_t<Bits> mask = (smallest3_t<Bits>(1) << Bits) - 1;
+  return quat_from_smallest3(
+    int32_t(packed & 3),
+    quat_smallest3_component<Bits>(int32_t((packed >> 2) & mask)),
+    quat_smallest3_component<Bits>(int32_t((packed >> (2 + Bits)) & mask)),
+    quat_smallest3_component<Bits>(
+      int32_t((packed >> (2 + Bits * 2)) & mask)));
+}
+
+// returns the unit vector packed with each coordinate of its octahedral
+// projection in Bits bits (branch free)
+template<int Bits>
+AS_API inline uint32_t vec3_pack_octahedral(const vec3& v)
+{
+  const real inv_length =
+    1.0_r / (std::abs(v.x) + std::abs(v.y) + std::abs(v.z));
+  const real px = v.x * inv_length;
+  const real py = v.y * inv_length;
+  // fold the lower half of the octahedron over the upper half
+  const real lower = 0.5_r - std::copysign(0.5_r, v.z);
+  const real fx = (1.0_r - std::abs(py)) * std::copysign(1.0_r, px);
+  const real fy = (1.0_r - std::abs(px)) * std::copysign(1.0_r, py);
+  // from [-1, 1] to [0, 2^Bits - 1]
+  const auto quantize = [](const real coordinate) {
+    constexpr int32_t max_value = (1 << Bits) - 1;
+    const auto quantized =
+      int32_t((coordinate * 0.5_r + 0.5_r) * real(max_value) + 0.5_r);
+    return uint32_t(std::min(std::max(quantized, 0), max_value));
+  };
+  return quantize(px + (fx - px) * lower)
+       | quantize(py + (fy - py) * lower) << Bits;
+}
+
+// returns the unit vector packed with vec3_pack_octahedral (branch free)
+template<int Bits>
+AS_API inline vec3 vec3_unpack_octahedral(const uint32_t packed)
+{
+  constexpr uint32_t mask = (uint32_t(1) << Bits) - 1;
+  const real scale = 2.0_r / real(mask);
+  const real ox = real(int32_t(packed & mask)) * scale - 1.0_r;
+  const real oy = real(int32_t((packed >> Bits) & mask)) * scale - 1.0_r;
+  // unfold the lower half of the octahedron
+  const real z = 1.0_r - std::abs(ox) - std::abs(oy);
+  const real fold = std::max(-z, 0.0_r);
+  const real x = ox - std::copysign(fold, ox);
+  const real y = oy - std::copysign(fold, oy);
+  const real inv_length = 1.0_r / std::sqrt(x * x + y * y + z * z);
+  return vec3(x * inv_length, y * inv_length, z * inv_length);
+}
+
+} // namespace internal
+
+AS_API inline uint32_t quat_pack_smallest3_32(const quat& q)
+{
+  return internal::quat_pack_smallest3<10>(q);
+}
+
+AS_API inline uint64_t quat_pack_smallest3_48(const quat& q)
+{
+  return internal::quat_pack_smallest3<15>(q);
+}
+
+AS_API inline uint64_t quat_pack_smallest3_64(const quat& q)
+{
+  return internal::quat_pack_smallest3<20>(q);
+}
+
+AS_API inline quat quat_unpack_smallest3_32(const uint32_t packed)
+{
+  return internal::quat_unpack_smallest3<10>(packed);
+}
+
+AS_API inline quat quat_unpack_smallest3_48(const uint64_t packed)
+{
+  return internal::quat_unpack_smallest3<15>(packed);
+}
+
+AS_API inline quat quat_unpack_smallest3_64(const uint64_t packed)
+{
+  return internal::quat_unpack_smallest3<20>(packed);
+}
+
+AS_API inline void quat_pack_smallest3_32(
+  const quat* quats, const index count, uint32_t* packed)
+{
+  for (index i = 0; i < count; ++i) {
+    packed[i] = internal::quat_pack_smallest3<10>(quats[i]);
+  }
+}
+
+AS_API inline void quat_pack_smallest3_48(
+  const quat* quats, const index count, uint64_t* packed)
+{
+  for (index i = 0; i < count; ++i) {
+    packed[i] = internal::quat_pack_smallest3<15>(quats[i]);
+  }
+}
+
+AS_API inline void quat_pack_smallest3_64(
+  const quat* quats, const index count, uint64_t* packed)
+{
+  for (index i = 0; i < count; ++i) {
+    packed[i] = internal::quat_pack_smallest3<20>(quats[i]);
+  }
+}
+
+AS_API inline void quat_unpack_smallest3_32(
+  const uint32_t* packed, const index count, quat* quats)
+{
+  for (index i = 0; i < count; ++i) {
+    quats[i] = internal::quat_unpack_smallest3<10>(packed[i]);
+  }
+}
+
+AS_API inline void quat_unpack_smallest3_48(
+  const uint64_t* packed, const index count, quat* quats)
+{
+  for (index i = 0; i < count; ++i) {
+    quats[i] = internal::quat_unpack_smallest3<15>(packed[i]);
+  }
+}
+
+AS_API inline void quat_unpack_smallest3_64(
+  const uint64_t* packed, const index count, quat* quats)
+{
+  for (index i = 0; i < count; ++i) {
+    quats[i] = internal::quat_unpack_smallest3<20>(packed[i]);
+  }
+}
+
+AS_API inline uint16_t vec3_pack_octahedral_16(const vec3& v)
+{
+  return uint16_t(internal::vec3_pack_octahedral<8>(v));
+}
+
+AS_API inline uint32_t vec3_pack_octahedral_24(const vec3& v)
+{
+  return internal::vec3_pack_octahedral<12>(v);
+}
+
+AS_API inline uint32_t vec3_pack_octahedral_32(const vec3& v)
+{
+  return internal::vec3_pack_octahedral<16>(v);
+}
+
+AS_API inline vec3 vec3_unpack_octahedral_16(const uint16_t packed)
+{
+  return internal::vec3_unpack_octahedral<8>(packed);
+}
+
+AS_API inline vec3 vec3_unpack_octahedral_24(const uint32_t packed)
+{
+  return internal::vec3_unpack_octahedral<12>(packed);
+}
+
+AS_API inline vec3 vec3_unpack_octahedral_32(const uint32_t packed)
+{
+  return internal::vec3_unpack_octahedral<16>(packed);
+}
+
+AS_API inline void vec3_pack_octahedral_16(
+  const vec3* vs, const index count, uint16_t* packed)
+{
+  for (index i = 0; i < count; ++i) {
+    packed[i] = uint16_t(internal::vec3_pack_octahedral<8>(vs[i]));
+  }
+}
+
+AS_API inline void vec3_pack_octahedral_24(
+  const vec3* vs, const index count, uint32_t* packed)
+{
+  for (index i = 0; i < count; ++i) {
+    packed[i] = internal::vec3_pack_octahedral<12>(vs[i]);
+  }
+}
+
+AS_API inline void vec3_pack_octahedral_32(
+  const vec3* vs, const index count, uint32_t* packed)
+{
+  for (index i = 0; i < count; ++i) {
+    packed[i] = internal::vec3_pack_octahedral<16>(vs[i]);
+  }
+}
+
+AS_API inline void vec3_unpack_octahedral_16(
+  const uint16_t* packed, const index count, vec3* vs)
+{
+  for (index i = 0; i < count; ++i) {
+    vs[i] = internal::vec3_unpack_octahedral<8>(packed[i]);
+  }
+}
+
+AS_API inline void vec3_unpack_octahedral_24(
+  const uint32_t* packed, const index count, vec3* vs)
+{
+  for (index i = 0; i < count; ++i) {
+    vs[i] = internal::vec3_unpack_octahedral<12>(packed[i]);
+  }
+}
+
+AS_API inline void vec3_unpack_octahedral_32(
+  const uint32_t* packed, const index count, vec3* vs)
+{
+  for (index i = 0; i < count; ++i) {
+    vs[i] = internal::vec3_unpack_octahedral<16>(packed[i]);
+  }
+}
+
+} // namespace as
@@ -0,0 +1,104 @@
+//! \file
+//! `as-raster`
+
+#pragma once
+
+#include <vector>
+
+#include "as-clip.hpp"
+#include "as-executor.hpp"
+#include "as-math-ops.hpp"
+
+namespace as
+{
+
+//! The width and height in pixels of the tiles triangles are binned into.
+//! \note A multiple of ::k_raster_lane_count so every step within a tile is
+//! a whole group of pixels.
+constexpr index k_raster_tile_size = 64;
+
+//! The number of horizontally adjacent pixels evaluated together.
+constexpr index k_raster_lane_count = 8;
+
+//! The number of triangles processed by each chunk of triangle setup.
+constexpr index k_raster_chunk_size = 4096;
+
+//! The number of bits of sub-pixel precision screen positions are snapped to.
+//! \note Edge functions are then evaluated exactly with integers.
+constexpr int64_t k_raster_subpixel_bits = 8;
+
+//! The distance in pixels beyond the edges of the screen triangles are clipped
+//! to (keeps snapped screen positions within the range of exact integers).
+constexpr index k_raster_guard_band = 8192;
+
+//! The primitive id of a pixel no triangle has been drawn to.
+constexpr uint32_t k_raster_no_primitive = 0xffffffff;
+
+//! Represents a \ref raster_target (depth and primitive id buffers written to
+//! by ::rasterize_triangles).
+//! \note The depth of pixel `(x, y)` is at `y * stride + x` (`stride` is the
+//! width rounded up to a multiple of ::k_raster_lane_count so whole groups of
+//! pixels can always be written), pixel `(0, 0)` is the top left of the screen
+//! (matching ::world_to_screen).
+//! \note Depth is stored from 0 to 1 as it would be in a depth buffer (see
+//! ::depth_buffer_to_world).
+struct raster_target
+{
+  vec2i dimension; //!< The width and height in pixels.
+  index stride; //!< The number of elements between rows.
+  //! The depth range the projection maps to (see ::raster_target_create).
+  vec2 depth_range;
+  std::vector<float> depth; //!< The depth of the closest triangle.
+  //! The index of the closest triangle (or ::k_raster_no_primitive).
+  std::vector<uint32_t> primitive;
+};
+
+//! Returns a cleared \ref raster_target.
+//! \param dimension The width and height in pixels.
+//! \param depth_range The depth range of the projection depending on if depth
+//! is mapped from 0 to 1 or -1 to 1. Pass either {0, 1} or {-1, 1} (or {1, 0}
+//! when the projection has been passed to ::reverse_z, closer triangles then
+//! have a greater depth).
+raster_target raster_target_create(
+  const vec2i& dimension, const vec2& depth_range);
+
+//! Clears the depth buffer to the far plane and the primitive id buffer to
+//! ::k_raster_no_primitive.
+void raster_target_clear(raster_target& target);
+
+//! Draws indexed triangles to the depth and primitive id buffers of the
+//! target.
+//! \note Rendering is split into stages:
+//! - Setup (in chunks of ::k_raster_chunk_size triangles): triangles are
+//!   transformed to clip space and clipped against the view volume with the
+//!   left, right, bottom and top planes moved out to the guard band (see
+//!   ::clip_triangles and ::k_raster_guard_band). Positions are snapped to
+//!   ::k_raster_subpixel_bits of precision and the edge functions (see
+//!   ::vec2_wedge) and depth plane of each triangle are computed in screen
+//!   space.
+//! - Binning: each triangle is added to the bin of each tile of
+//!   ::k_raster_tile_size pixels its bounds overlap (bins keep the order of
+//!   the input triangles).
+//! - Rasterization (one tile at a time): triangles are rasterized in rows of
+//!   ::k_raster_lane_count pixels at a time (edge functions step with integer
+//!   adds and the depth test is a select, so every pixel in a row is
+//!   independent) and pixels passing the depth test are written.
+//! \note Triangles are drawn regardless of winding. Pixel centers exactly on
+//! an edge shared by two triangles are drawn once. When two triangles have the
+//! same depth at a pixel the first one in the input is kept.
+//! \param target The target to draw to.
+//! \param view_projection The view projection matrix (see ::view_projection).
+//! \param positions The world space vertex positions.
+//! \param indices Three vertex indices for each triangle.
+//! \param triangle_count The number of triangles.
+//! \param executor The executor to process chunks and tiles with (see
+//! ::serial_executor).
+template<typename Executor = serial_executor>
+void rasterize_triangles(
+  raster_target& target, const mat4& view_projection, const vec3* positions,
+  const uint32_t* indices, index triangle_count,
+  const Executor& executor = Executor{});
+
+} // namespace as
+
+#include "as-raster.inl"
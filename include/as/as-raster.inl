@@ -0,0 +1,328 @@
+namespace as
+{
+
+namespace internal
+{
+
+// a triangle ready to be rasterized (in screen space with pixel centers at
+// integer coordinates)
+struct raster_triangle
+{
+  // edge functions e(x, y) = a * x + b * y + c (a pixel is inside when all
+  // three are not negative), evaluated exactly in sub-pixel units
+  int64_t edge_a[3];
+  int64_t edge_b[3];
+  int64_t edge_c[3];
+  // depth(x, y) = depth_a * x + depth_b * y + depth_c
+  real depth_a;
+  real depth_b;
+  real depth_c;
+  // inclusive pixel bounds (clamped to the screen)
+  int32_t min_x;
+  int32_t min_y;
+  int32_t max_x;
+  int32_t max_y;
+  uint32_t primitive;
+};
+
+// projects a triangle (inside the view volume and guard band) to screen space
+// and appends it to triangles if it covers any pixel centers on screen
+AS_API inline void raster_setup(
+  const vec4& c0, const vec4& c1, const vec4& c2, const vec2i& dimension,
+  const vec2& depth_range, const uint32_t primitive,
+  std::vector<raster_triangle>& triangles)
+{
+  const vec2 size = vec2(real(dimension.x), real(dimension.y));
+  const real depth_min = std::min(depth_range.x, depth_range.y);
+  const real inv_depth_scale =
+    1.0_r / std::abs(depth_range.y - depth_range.x);
+  const auto subpixel_scale = real(int64_t(1) << k_raster_subpixel_bits);
+  // screen position snapped to sub-pixel precision (with pixel centers at
+  // integer coordinates) and depth
+  const auto project = [&](const vec4& clip, vec2l& fixed, real& depth) {
+    const real inv_w = 1.0_r / clip.w;
+    const vec2 screen = vec2(
+      (clip.x * inv_w + 1.0_r) * 0.5_r * size.x - 0.5_r,
+      (1.0_r - clip.y * inv_w) * 0.5_r * size.y - 0.5_r);
+    depth = (clip.z * inv_w - depth_min) * inv_depth_scale;
+    // rejects positions that are not finite (the guard band keeps the
+    // others well within range)
+    if (!std::isfinite(screen.x) || !std::isfinite(screen.y)) {
+      return false;
+    }
+    fixed = vec2l(
+      int64_t(std::round(screen.x * subpixel_scale)),
+      int64_t(std::round(screen.y * subpixel_scale)));
+    return true;
+  };
+
+  vec2l f[3];
+  real d[3];
+  if (
+    !project(c0, f[0], d[0]) || !project(c1, f[1], d[1])
+    || !project(c2, f[2], d[2])) {
+    return;
+  }
+
+  int64_t area = vec2_wedge(f[1] - f[0], f[2] - f[0]);
+  if (area < 0) {
+    std::swap(f[1], f[2]);
+    std::swap(d[1], d[2]);
+    area = -area;
+  }
+  if (area == 0) {
+    return;
+  }
+
+  // the first and last pixel centers within the bounds (rounding up and down)
+  const int64_t subpixel_step = int64_t(1) << k_raster_subpixel_bits;
+  const int64_t subpixel_mask = subpixel_step - 1;
+  const auto first_pixel = [subpixel_mask](const int64_t v) {
+    return int32_t((v + subpixel_mask) >> k_raster_subpixel_bits);
+  };
+  const auto last_pixel = [](const int64_t v) {
+    return int32_t(v >> k_raster_subpixel_bits);
+  };
+  raster_triangle triangle;
+  triangle.min_x =
+    std::max(first_pixel(std::min({f[0].x, f[1].x, f[2].x})), 0);
+  triangle.min_y =
+    std::max(first_pixel(std::min({f[0].y, f[1].y, f[2].y})), 0);
+  triangle.max_x = std::min(
+    last_pixel(std::max({f[0].x, f[1].x, f[2].x})), dimension.x - 1);
+  triangle.max_y = std::min(
+    last_pixel(std::max({f[0].y, f[1].y, f[2].y})), dimension.y - 1);
+  if (triangle.min_x > triangle.max_x || triangle.min_y > triangle.max_y) {
+    return;
+  }
+
+  for (index i = 0; i < 3; ++i) {
+    // the edge opposite vertex i
+    const vec2l& a = f[(i + 1) % 3];
+    const vec2l& b = f[(i + 2) % 3];
+    // e(p) = wedge(b - a, p - a), the edge seen from the neighboring triangle
+    // is exactly negated so with the fill rule exactly one of them includes
+    // pixel centers on the edge
+    const int64_t edge_a = a.y - b.y;
+    const int64_t edge_b = b.x - a.x;
+    const bool inclusive = edge_a > 0 || (edge_a == 0 && edge_b > 0);
+    // pixel centers are at whole pixels (multiples of the sub-pixel scale)
+    triangle.edge_a[i] = edge_a * subpixel_step;
+    triangle.edge_b[i] = edge_b * subpixel_step;
+    // bias exclusive edges so a pixel is inside when e(x, y) >= 0
+    triangle.edge_c[i] = vec2_wedge(a, b) - (inclusive ? 0 : 1);
+  }
+
+  vec2 s[3];
+  for (index i = 0; i < 3; ++i) {
+    s[i] = vec2(real(f[i].x), real(f[i].y)) / subpixel_scale;
+  }
+  const vec2 e1 = s[1] - s[0];
+  const vec2 e2 = s[2] - s[0];
+  const real inv_area = 1.0_r / vec2_wedge(e1, e2);
+  triangle.depth_a = ((d[1] - d[0]) * e2.y - (d[2] - d[0]) * e1.y) * inv_area;
+  triangle.depth_b = ((d[2] - d[0]) * e1.x - (d[1] - d[0]) * e2.x) * inv_area;
+  triangle.depth_c =
+    d[0] - triangle.depth_a * s[0].x - triangle.depth_b * s[0].y;
+  triangle.primitive = primitive;
+  triangles.push_back(triangle);
+}
+
+// rasterizes the rows [min_y, max_y] and columns [min_x, max_x] of the
+// triangle (min_x must be a multiple of k_raster_lane_count)
+AS_API inline void raster_triangle_rows(
+  const raster_triangle& triangle, const int32_t min_x, const int32_t max_x,
+  const int32_t min_y, const int32_t max_y, const real depth_sign,
+  raster_target& target)
+{
+  // copy to locals so they are not reloaded after every store
+  const int64_t a0 = triangle.edge_a[0];
+  const int64_t a1 = triangle.edge_a[1];
+  const int64_t a2 = triangle.edge_a[2];
+  const real depth_a = triangle.depth_a;
+  const uint32_t primitive = triangle.primitive;
+  const auto sign = float(depth_sign);
+
+  // the edge function offsets of each lane (avoids a 64 bit multiply per
+  // pixel)
+  int64_t lane0[k_raster_lane_count];
+  int64_t lane1[k_raster_lane_count];
+  int64_t lane2[k_raster_lane_count];
+  for (index lane = 0; lane < k_raster_lane_count; ++lane) {
+    lane0[lane] = a0 * lane;
+    lane1[lane] = a1 * lane;
+    lane2[lane] = a2 * lane;
+  }
+
+  for (int32_t y = min_y; y <= max_y; ++y) {
+    int64_t row0 = triangle.edge_b[0] * y + triangle.edge_c[0] + a0 * min_x;
+    int64_t row1 = triangle.edge_b[1] * y + triangle.edge_c[1] + a1 * min_x;
+    int64_t row2 = triangle.edge_b[2] * y + triangle.edge_c[2] + a2 * min_x;
+    const real depth_row = triangle.depth_b * real(y) + triangle.depth_c;
+    for (int32_t x = min_x; x <= max_x;
+         x += int32_t(k_raster_lane_count)) {
+      float* depth = target.depth.data() + y * target.stride + x;
+      uint32_t* ids = target.primitive.data() + y * target.stride + x;
+      for (index lane = 0; lane < k_raster_lane_count; ++lane) {
+        const bool inside = ((row0 + lane0[lane]) >= 0)
+                          & ((row1 + lane1[lane]) >= 0)
+                          & ((row2 + lane2[lane]) >= 0);
+        const real depth_lane = depth_a * real(x + int32_t(lane)) + depth_row;
+        const auto d = float(depth_lane);
+        const bool pass = inside & (d >= 0.0f) & (d <= 1.0f)
+                        & (d * sign < depth[lane] * sign);
+        depth[lane] = pass ? d : depth[lane];
+        ids[lane] = pass ? primitive : ids[lane];
+      }
+      row0 += a0 * k_raster_lane_count;
+      row1 += a1 * k_raster_lane_count;
+      row2 += a2 * k_raster_lane_count;
+    }
+  }
+}
+
+} // namespace internal
+
+AS_API inline raster_target raster_target_create(
+  const vec2i& dimension, const vec2& depth_range)
+{
+  raster_target target;
+  target.dimension = dimension;
+  target.stride =
+    chunk_count(dimension.x, k_raster_lane_count) * k_raster_lane_count;
+  target.depth_range = depth_range;
+  target.depth.resize(target.stride * dimension.y);
+  target.primitive.resize(target.stride * dimension.y);
+  raster_target_clear(target);
+  return target;
+}
+
+AS_API inline void raster_target_clear(raster_target& target)
+{
+  // the far plane is at depth 0 if depth is reversed
+  const float far_depth =
+    target.depth_range.y > target.depth_range.x ? 1.0f : 0.0f;
+  std::fill(target.depth.begin(), target.depth.end(), far_depth);
+  std::fill(
+    target.primitive.begin(), target.primitive.end(), k_raster_no_primitive);
+}
+
+template<typename Executor>
+AS_API void rasterize_triangles(
+  raster_target& target, const mat4& view_projection, const vec3* positions,
+  const uint32_t* indices, const index triangle_count,
+  const Executor& executor)
+{
+  const vec2i dimension = target.dimension;
+  const vec2 depth_range = target.depth_range;
+  const index tiles_x = chunk_count(dimension.x, k_raster_tile_size);
+  const index tiles_y = chunk_count(dimension.y, k_raster_tile_size);
+  const index tile_count = tiles_x * tiles_y;
+  const index chunks = chunk_count(triangle_count, k_raster_chunk_size);
+
+  const auto for_each_tile = [&](
+                               const internal::raster_triangle& triangle,
+                               const auto& fn) {
+    for (index ty = triangle.min_y / k_raster_tile_size;
+         ty <= triangle.max_y / k_raster_tile_size; ++ty) {
+      for (index tx = triangle.min_x / k_raster_tile_size;
+           tx <= triangle.max_x / k_raster_tile_size; ++tx) {
+        fn(ty * tiles_x + tx);
+      }
+    }
+  };
+
+  // the guard band in normalized device coordinates
+  const vec2 guard_band = vec2(
+    1.0_r + real(k_raster_guard_band) * 2.0_r / real(dimension.x),
+    1.0_r + real(k_raster_guard_band) * 2.0_r / real(dimension.y));
+
+  // setup and count the triangles in each tile per chunk
+  std::vector<std::vector<internal::raster_triangle>> chunk_triangles(chunks);
+  std::vector<index> bin_offsets(chunks * tile_count, 0);
+  executor(chunks, [&](const index chunk) {
+    auto& triangles = chunk_triangles[chunk];
+    const index end = chunk_end(chunk, triangle_count, k_raster_chunk_size);
+    for (index i = chunk_begin(chunk, k_raster_chunk_size); i < end; ++i) {
+      const vec4 clip[3] = {
+        mat_mul(vec4_from_vec3(positions[indices[i * 3]], 1.0_r),
+                view_projection),
+        mat_mul(vec4_from_vec3(positions[indices[i * 3 + 1]], 1.0_r),
+                view_projection),
+        mat_mul(vec4_from_vec3(positions[indices[i * 3 + 2]], 1.0_r),
+                view_projection)};
+      vec4 clipped[k_clip_max_triangle_count * 3];
+      uint32_t clipped_triangles[k_clip_max_triangle_count];
+      const index clipped_count = clip_triangles(
+        clip, 1, depth_range, guard_band, clipped, clipped_triangles);
+      for (index t = 0; t < clipped_count; ++t) {
+        internal::raster_setup(
+          clipped[t * 3], clipped[t * 3 + 1], clipped[t * 3 + 2], dimension,
+          depth_range, uint32_t(i), triangles);
+      }
+    }
+    index* counts = bin_offsets.data() + chunk * tile_count;
+    for (const auto& triangle : triangles) {
+      for_each_tile(triangle, [counts](const index tile) { counts[tile]++; });
+    }
+  });
+
+  // gather the triangles of all chunks
+  std::vector<index> triangle_offsets(chunks + 1, 0);
+  for (index chunk = 0; chunk < chunks; ++chunk) {
+    triangle_offsets[chunk + 1] =
+      triangle_offsets[chunk] + index(chunk_triangles[chunk].size());
+  }
+  std::vector<internal::raster_triangle> triangles(triangle_offsets[chunks]);
+  executor(chunks, [&](const index chunk) {
+    std::copy(
+      chunk_triangles[chunk].begin(), chunk_triangles[chunk].end(),
+      triangles.begin() + triangle_offsets[chunk]);
+  });
+
+  // bins are ordered by tile then chunk so each tile sees its triangles in
+  // the order they were submitted
+  std::vector<index> tile_begin(tile_count + 1);
+  index bin_size = 0;
+  for (index tile = 0; tile < tile_count; ++tile) {
+    tile_begin[tile] = bin_size;
+    for (index chunk = 0; chunk < chunks; ++chunk) {
+      const index count = bin_offsets[chunk * tile_count + tile];
+      bin_offsets[chunk * tile_count + tile] = bin_size;
+      bin_size += count;
+    }
+  }
+  tile_begin[tile_count] = bin_size;
+
+  std::vector<int32_t> bins(bin_size);
+  executor(chunks, [&](const index chunk) {
+    index* offsets = bin_offsets.data() + chunk * tile_count;
+    for (index i = triangle_offsets[chunk]; i < triangle_offsets[chunk + 1];
+         ++i) {
+      for_each_tile(triangles[i], [&](const index tile) {
+        bins[offsets[tile]++] = int32_t(i);
+      });
+    }
+  });
+
+  const real depth_sign = depth_range.y > depth_range.x ? 1.0_r : -1.0_r;
+  executor(tile_count, [&](const index tile) {
+    const auto tile_min_x = int32_t((tile % tiles_x) * k_raster_tile_size);
+    const auto tile_min_y = int32_t((tile / tiles_x) * k_raster_tile_size);
+    const auto tile_max_x = int32_t(tile_min_x + k_raster_tile_size - 1);
+    const auto tile_max_y = int32_t(tile_min_y + k_raster_tile_size - 1);
+    for (index b = tile_begin[tile]; b < tile_begin[tile + 1]; ++b) {
+      const internal::raster_triangle& triangle = triangles[bins[b]];
+      // start at a whole group of lanes
+      const int32_t min_x = std::max(tile_min_x, triangle.min_x)
+                          / int32_t(k_raster_lane_count)
+                          * int32_t(k_raster_lane_count);
+      internal::raster_triangle_rows(
+        triangle, min_x, std::min(tile_max_x, triangle.max_x),
+        std::max(tile_min_y, triangle.min_y),
+        std::min(tile_max_y, triangle.max_y), depth_sign, target);
+    }
+  });
+}
+
+} // namespace as
@@ -0,0 +1,90 @@
+//! \file
+//! `as-ray-packet`
+
+#pragma once
+
+#include "as-math-ops.hpp"
+
+namespace as
+{
+
+//! Represents a \ref ray_packet (a group of rays stored as a structure of
+//! arrays).
+//! \note Each component is stored in its own array (one lane per ray) so the
+//! packet intersection functions apply each step to every lane with the same
+//! instructions (4, 8 or 16 lanes fill SSE, AVX and AVX-512 registers of type
+//! float).
+template<typename T, index N>
+struct ray_packet_t
+{
+  static_assert(
+    N == 4 || N == 8 || N == 16, "Ray packets support 4, 8 or 16 lanes");
+
+  //! Returns `N`.
+  constexpr static index size();
+
+  T origin_x[N]; //!< The x component of the origin of each ray.
+  T origin_y[N]; //!< The y component of the origin of each ray.
+  T origin_z[N]; //!< The z component of the origin of each ray.
+  T direction_x[N]; //!< The x component of the direction of each ray.
+  T direction_y[N]; //!< The y component of the direction of each ray.
+  T direction_z[N]; //!< The z component of the direction of each ray.
+  T inv_direction_x[N]; //!< The reciprocal of each x direction component.
+  T inv_direction_y[N]; //!< The reciprocal of each y direction component.
+  T inv_direction_z[N]; //!< The reciprocal of each z direction component.
+};
+
+//! Type alias for a ray packet of type ::real with 4 lanes.
+using ray_packet4 = ray_packet_t<real, 4>;
+//! Type alias for a ray packet of type ::real with 8 lanes.
+using ray_packet8 = ray_packet_t<real, 8>;
+//! Type alias for a ray packet of type ::real with 16 lanes.
+using ray_packet16 = ray_packet_t<real, 16>;
+
+//! Stores a \ref ray in a lane of the packet.
+template<typename T, index N>
+void ray_packet_set(ray_packet_t<T, N>& packet, index lane, const ray_t<T>& r);
+
+//! Returns the \ref ray stored in a lane of the packet.
+template<typename T, index N>
+ray_t<T> ray_packet_get(const ray_packet_t<T, N>& packet, index lane);
+
+//! Returns a packet of `N` rays read from an array of rays.
+template<index N, typename T>
+ray_packet_t<T, N> ray_packet_from_rays(const ray_t<T>* rays);
+
+//! Tests each ray in the packet against the \ref aabb and returns a bitmask
+//! of the lanes that hit it (bit `i` is set if lane `i` hit).
+//! \note Per lane equivalent of ::ray_intersect_aabb.
+//! \param packet The rays to test.
+//! \param bounds The box to test.
+//! \param max_distance The maximum distance to test for each lane.
+//! \param distance The distance each lane enters the box (only meaningful for
+//! lanes that hit).
+template<typename T, index N>
+uint32_t ray_packet_intersect_aabb(
+  const ray_packet_t<T, N>& packet, const aabb_t<T>& bounds,
+  const T (&max_distance)[N], T (&distance)[N]);
+
+//! Tests each ray in the packet against the triangle and returns a bitmask of
+//! the lanes that hit it no further than their current distance.
+//! \note Per lane equivalent of ::ray_intersect_triangle (the current distance
+//! of each lane is its `max_distance`). Designed for closest
+//! hit queries, `distance`, `u` and `v` are only written for lanes that hit so
+//! the function can be called for each candidate triangle in turn.
+//! \param packet The rays to test.
+//! \param v0 The first vertex of the triangle.
+//! \param v1 The second vertex of the triangle.
+//! \param v2 The third vertex of the triangle.
+//! \param distance The current closest distance of each lane, updated with the
+//! distance of the intersection for lanes that hit.
+//! \param u The barycentric weight of `v1` for lanes that hit.
+//! \param v The barycentric weight of `v2` for lanes that hit.
+template<typename T, index N>
+uint32_t ray_packet_intersect_triangle(
+  const ray_packet_t<T, N>& packet, const vec<T, 3>& v0, const vec<T, 3>& v1,
+  const vec<T, 3>& v2, T (&distance)[N], T (&u)[N], T (&v)[N]);
+
+} // namespace as
+
+#include "as-ray-packet.inl"
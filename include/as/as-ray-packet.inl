@@ -0,0 +1,135 @@
+namespace as
+{
+
+template<typename T, index N>
+AS_API constexpr index ray_packet_t<T, N>::size()
+{
+  return N;
+}
+
+template<typename T, index N>
+AS_API void ray_packet_set(
+  ray_packet_t<T, N>& packet, const index lane, const ray_t<T>& r)
+{
+  packet.origin_x[lane] = r.origin.x;
+  packet.origin_y[lane] = r.origin.y;
+  packet.origin_z[lane] = r.origin.z;
+  packet.direction_x[lane] = r.direction.x;
+  packet.direction_y[lane] = r.direction.y;
+  packet.direction_z[lane] = r.direction.z;
+  packet.inv_direction_x[lane] = r.inv_direction.x;
+  packet.inv_direction_y[lane] = r.inv_direction.y;
+  packet.inv_direction_z[lane] = r.inv_direction.z;
+}
+
+template<typename T, index N>
+AS_API ray_t<T> ray_packet_get(
+  const ray_packet_t<T, N>& packet, const index lane)
+{
+  ray_t<T> r;
+  r.origin = vec<T, 3>(
+    packet.origin_x[lane], packet.origin_y[lane], packet.origin_z[lane]);
+  r.direction = vec<T, 3>(
+    packet.direction_x[lane], packet.direction_y[lane],
+    packet.direction_z[lane]);
+  r.inv_direction = vec<T, 3>(
+    packet.inv_direction_x[lane], packet.inv_direction_y[lane],
+    packet.inv_direction_z[lane]);
+  return r;
+}
+
+template<index N, typename T>
+AS_API ray_packet_t<T, N> ray_packet_from_rays(const ray_t<T>* rays)
+{
+  ray_packet_t<T, N> packet;
+  for (index lane = 0; lane < N; ++lane) {
+    ray_packet_set(packet, lane, rays[lane]);
+  }
+  return packet;
+}
+
+template<typename T, index N>
+AS_API uint32_t ray_packet_intersect_aabb(
+  const ray_packet_t<T, N>& packet, const aabb_t<T>& bounds,
+  const T (&max_distance)[N], T (&distance)[N])
+{
+  uint32_t mask = 0;
+  for (index i = 0; i < N; ++i) {
+    const T ox = packet.origin_x[i];
+    const T oy = packet.origin_y[i];
+    const T oz = packet.origin_z[i];
+    const T tx0 = (bounds.min.x - ox) * packet.inv_direction_x[i];
+    const T tx1 = (bounds.max.x - ox) * packet.inv_direction_x[i];
+    const T ty0 = (bounds.min.y - oy) * packet.inv_direction_y[i];
+    const T ty1 = (bounds.max.y - oy) * packet.inv_direction_y[i];
+    const T tz0 = (bounds.min.z - oz) * packet.inv_direction_z[i];
+    const T tz1 = (bounds.max.z - oz) * packet.inv_direction_z[i];
+    const T entry = std::max(
+      std::max(std::min(tx0, tx1), std::min(ty0, ty1)),
+      std::max(std::min(tz0, tz1), T(0.0)));
+    const T exit = std::min(
+      std::min(std::max(tx0, tx1), std::max(ty0, ty1)),
+      std::min(std::max(tz0, tz1), max_distance[i]));
+    distance[i] = entry;
+    mask |= uint32_t(entry <= exit) << i;
+  }
+  return mask;
+}
+
+// ref: Tomas Moller, Ben Trumbore (1997) Fast, Minimum Storage Ray/Triangle
+// Intersection
+template<typename T, index N>
+AS_API uint32_t ray_packet_intersect_triangle(
+  const ray_packet_t<T, N>& packet, const vec<T, 3>& v0, const vec<T, 3>& v1,
+  const vec<T, 3>& v2, T (&distance)[N], T (&u)[N], T (&v)[N])
+{
+  const vec<T, 3> edge1 = v1 - v0;
+  const vec<T, 3> edge2 = v2 - v0;
+  // work on local copies as the outputs may alias (which prevents
+  // vectorization)
+  T closest[N];
+  T closest_u[N];
+  T closest_v[N];
+  std::copy(distance, distance + N, closest);
+  std::copy(u, u + N, closest_u);
+  std::copy(v, v + N, closest_v);
+  uint32_t mask = 0;
+  for (index i = 0; i < N; ++i) {
+    const T dx = packet.direction_x[i];
+    const T dy = packet.direction_y[i];
+    const T dz = packet.direction_z[i];
+    // p = direction x edge2
+    const T px = dy * edge2.z - dz * edge2.y;
+    const T py = dz * edge2.x - dx * edge2.z;
+    const T pz = dx * edge2.y - dy * edge2.x;
+    const T det = edge1.x * px + edge1.y * py + edge1.z * pz;
+    // avoid dividing by zero for rays parallel to the triangle (rejected below)
+    // without a select so the loop still vectorizes
+    const T inv_det = T(1.0) / (det + T(det == T(0.0)));
+    const T sx = packet.origin_x[i] - v0.x;
+    const T sy = packet.origin_y[i] - v0.y;
+    const T sz = packet.origin_z[i] - v0.z;
+    const T lane_u = (sx * px + sy * py + sz * pz) * inv_det;
+    // q = s x edge1
+    const T qx = sy * edge1.z - sz * edge1.y;
+    const T qy = sz * edge1.x - sx * edge1.z;
+    const T qz = sx * edge1.y - sy * edge1.x;
+    const T lane_v = (dx * qx + dy * qy + dz * qz) * inv_det;
+    const T lane_distance =
+      (edge2.x * qx + edge2.y * qy + edge2.z * qz) * inv_det;
+    // non short-circuiting & keeps the loop free of branches
+    const bool hit = (det != T(0.0)) & (lane_u >= T(0.0)) & (lane_v >= T(0.0))
+                   & (lane_u + lane_v <= T(1.0)) & (lane_distance >= T(0.0))
+                   & (lane_distance <= closest[i]);
+    closest[i] = hit ? lane_distance : closest[i];
+    closest_u[i] = hit ? lane_u : closest_u[i];
+    closest_v[i] = hit ? lane_v : closest_v[i];
+    mask |= uint32_t(hit) << i;
+  }
+  std::copy(closest, closest + N, distance);
+  std::copy(closest_u, closest_u + N, u);
+  std::copy(closest_v, closest_v + N, v);
+  return mask;
+}
+
+} // namespace as
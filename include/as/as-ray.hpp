@@ -0,0 +1,39 @@
+//! \file
+//! `as-ray`
+
+#pragma once
+
+#include "as-vec.hpp"
+
+namespace as
+{
+
+//! Represents a \ref ray (a half-line starting at an origin).
+//! \note The reciprocal of the direction is computed on construction as it is
+//! required by slab tests (see ::ray_intersect_aabb).
+template<typename T>
+struct ray_t
+{
+  ray_t() noexcept = default;
+
+  //! Constructs a ray with `(origin_, direction_)`
+  //! \note \p direction_ does not have to be normalized (intersection distances
+  //! are then in multiples of the length of the direction).
+  constexpr ray_t(const vec<T, 3>& origin_, const vec<T, 3>& direction_);
+
+  vec<T, 3> origin; //!< The origin of the ray.
+  vec<T, 3> direction; //!< The direction of the ray.
+  //! The reciprocal of each component of the direction.
+  vec<T, 3> inv_direction;
+};
+
+//! Type alias for a ray of type ::real.
+using ray = ray_t<real>;
+//! Type alias for a ray of type float.
+using rayf = ray_t<float>;
+//! Type alias for a ray of type double.
+using rayd = ray_t<double>;
+
+} // namespace as
+
+#include "as-ray.inl"
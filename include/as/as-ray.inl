@@ -0,0 +1,13 @@
+namespace as
+{
+
+template<typename T>
+AS_API constexpr ray_t<T>::ray_t(
+  const vec<T, 3>& origin_, const vec<T, 3>& direction_)
+  : origin(origin_),
+    direction(direction_),
+    inv_direction(vec<T, 3>(T(1.0)) / direction_)
+{
+}
+
+} // namespace as
@@ -0,0 +1,65 @@
+//! \file
+//! `as-reduce`
+
+#pragma once
+
+#include <limits>
+#include <tuple>
+#include <vector>
+
+#include "as-executor.hpp"
+#include "as-math-ops.hpp"
+
+namespace as
+{
+
+//! The number of vectors processed by each chunk of a chunked reduction.
+//! \note Chunks are combined in chunk order once all chunks have completed so
+//! results do not depend on the executor (or number of threads) used.
+constexpr index k_reduce_chunk_size = 8192;
+
+//! Returns the average of an array of vectors.
+//! \note Each chunk is summed with ::vec_average_compensated's compensated
+//! summation and the chunk sums are then combined (also compensated).
+//! \param vectors The vectors to average.
+//! \param count The number of vectors.
+//! \param executor The executor to process chunks with (see
+//! ::serial_executor).
+template<typename T, index d, typename Executor = serial_executor>
+vec<T, d> vec_average_chunked(
+  const vec<T, d>* vectors, index count,
+  const Executor& executor = Executor{});
+
+//! Returns the componentwise minimum and maximum of an array of vectors (the
+//! bounds of a set of points).
+//! \note Returns an empty range (the largest value for the minimum and the
+//! lowest value for the maximum) when `count` is zero.
+//! \param vectors The vectors to find the bounds of.
+//! \param count The number of vectors.
+//! \param executor The executor to process chunks with (see
+//! ::serial_executor).
+template<typename T, index d, typename Executor = serial_executor>
+std::tuple<vec<T, d>, vec<T, d>> vec_min_max_chunked(
+  const vec<T, d>* vectors, index count,
+  const Executor& executor = Executor{});
+
+//! Returns the (population) covariance matrix of an array of vectors.
+//! \note Each chunk computes its mean and the sum of outer products of
+//! deviations from that mean (a two pass approach over data already in cache),
+//! chunk results are then merged using the pairwise update of Chan et al.
+//! This avoids the catastrophic cancellation of accumulating `x * x^T`
+//! directly.
+//! \note Returns the zero matrix when `count` is zero.
+//! \note The matrix is symmetric so is the same for row and column major.
+//! \param vectors The vectors to find the covariance of.
+//! \param count The number of vectors.
+//! \param executor The executor to process chunks with (see
+//! ::serial_executor).
+template<typename T, index d, typename Executor = serial_executor>
+mat<T, d> vec_covariance_chunked(
+  const vec<T, d>* vectors, index count,
+  const Executor& executor = Executor{});
+
+} // namespace as
+
+#include "as-reduce.inl"
@@ -0,0 +1,143 @@
+namespace as
+{
+
+namespace internal
+{
+
+template<typename T, index d>
+struct compensated_sum_t
+{
+  vec<T, d> sum;
+  vec<T, d> compensation;
+};
+
+template<typename T, index d>
+struct moments_t
+{
+  index count;
+  vec<T, d> mean;
+  mat<T, d> comoment; // sum of (x - mean) * (x - mean)^T
+};
+
+// ref: Chan, T. F., Golub, G. H. & LeVeque, R. J. (1979) Updating Formulae
+// and a Pairwise Algorithm for Computing Sample Variances
+template<typename T, index d>
+AS_API moments_t<T, d> moments_merge(
+  const moments_t<T, d>& lhs, const moments_t<T, d>& rhs)
+{
+  const index count = lhs.count + rhs.count;
+  const vec<T, d> delta = rhs.mean - lhs.mean;
+  const T rhs_weight = T(rhs.count) / T(count);
+
+  moments_t<T, d> result;
+  result.count = count;
+  result.mean = lhs.mean + delta * rhs_weight;
+  for (index c = 0; c < d; ++c) {
+    for (index r = 0; r < d; ++r) {
+      const index i = mat_rc(r, c, d);
+      result.comoment[i] = lhs.comoment[i] + rhs.comoment[i]
+                         + delta[r] * delta[c] * T(lhs.count) * rhs_weight;
+    }
+  }
+  return result;
+}
+
+} // namespace internal
+
+template<typename T, index d, typename Executor>
+AS_API vec<T, d> vec_average_chunked(
+  const vec<T, d>* vectors, const index count, const Executor& executor)
+{
+  const index chunks = chunk_count(count, k_reduce_chunk_size);
+  std::vector<internal::compensated_sum_t<T, d>> chunk_sums(chunks);
+  executor(chunks, [&](const index chunk) {
+    const index begin = chunk_begin(chunk, k_reduce_chunk_size);
+    const index end = chunk_end(chunk, count, k_reduce_chunk_size);
+    auto& chunk_sum = chunk_sums[chunk];
+    chunk_sum.sum = vec<T, d>{};
+    chunk_sum.compensation = vec<T, d>{};
+    internal::neumaier_sum(
+      vectors + begin, end - begin, chunk_sum.sum, chunk_sum.compensation);
+  });
+
+  vec<T, d> sum = {};
+  vec<T, d> compensation = {};
+  for (const auto& chunk_sum : chunk_sums) {
+    internal::neumaier_add(sum, compensation, chunk_sum.sum);
+    internal::neumaier_add(sum, compensation, chunk_sum.compensation);
+  }
+  return vec<T, d>((sum + compensation) / T(count));
+}
+
+template<typename T, index d, typename Executor>
+AS_API std::tuple<vec<T, d>, vec<T, d>> vec_min_max_chunked(
+  const vec<T, d>* vectors, const index count, const Executor& executor)
+{
+  if (count <= 0) {
+    return std::make_tuple(
+      vec<T, d>(std::numeric_limits<T>::max()),
+      vec<T, d>(std::numeric_limits<T>::lowest()));
+  }
+
+  const index chunks = chunk_count(count, k_reduce_chunk_size);
+  std::vector<std::tuple<vec<T, d>, vec<T, d>>> chunk_bounds(chunks);
+  executor(chunks, [&](const index chunk) {
+    const index begin = chunk_begin(chunk, k_reduce_chunk_size);
+    const index end = chunk_end(chunk, count, k_reduce_chunk_size);
+    vec<T, d> min = vectors[begin];
+    vec<T, d> max = vectors[begin];
+    for (index i = begin + 1; i < end; ++i) {
+      min = vec_min(min, vectors[i]);
+      max = vec_max(max, vectors[i]);
+    }
+    chunk_bounds[chunk] = std::make_tuple(min, max);
+  });
+
+  auto [min, max] = chunk_bounds.front();
+  for (const auto& [chunk_min, chunk_max] : chunk_bounds) {
+    min = vec_min(min, chunk_min);
+    max = vec_max(max, chunk_max);
+  }
+  return std::make_tuple(min, max);
+}
+
+template<typename T, index d, typename Executor>
+AS_API mat<T, d> vec_covariance_chunked(
+  const vec<T, d>* vectors, const index count, const Executor& executor)
+{
+  if (count <= 0) {
+    return mat<T, d>{};
+  }
+
+  const index chunks = chunk_count(count, k_reduce_chunk_size);
+  std::vector<internal::moments_t<T, d>> chunk_moments(chunks);
+  executor(chunks, [&](const index chunk) {
+    const index begin = chunk_begin(chunk, k_reduce_chunk_size);
+    const index end = chunk_end(chunk, count, k_reduce_chunk_size);
+
+    vec<T, d> sum = {};
+    vec<T, d> compensation = {};
+    internal::neumaier_sum(vectors + begin, end - begin, sum, compensation);
+
+    auto& moments = chunk_moments[chunk];
+    moments.count = end - begin;
+    moments.mean = vec<T, d>((sum + compensation) / T(end - begin));
+    moments.comoment = mat<T, d>{};
+    for (index i = begin; i < end; ++i) {
+      const vec<T, d> deviation = vectors[i] - moments.mean;
+      for (index c = 0; c < d; ++c) {
+        for (index r = 0; r < d; ++r) {
+          moments.comoment[mat_rc(r, c, d)] += deviation[r] * deviation[c];
+        }
+      }
+    }
+  });
+
+  internal::moments_t<T, d> moments = chunk_moments.front();
+  for (index chunk = 1; chunk < chunks; ++chunk) {
+    moments = internal::moments_merge(moments, chunk_moments[chunk]);
+  }
+  return moments.comoment * (T(1.0) / T(count));
+}
+
+} // namespace as
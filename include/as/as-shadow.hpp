@@ -0,0 +1,88 @@
+//! \file
+//! `as-shadow`
+
+#pragma once
+
+#include "as-view.hpp"
+
+namespace as
+{
+
+//! The maximum number of cascades ::shadow_cascades fits at once.
+constexpr index k_shadow_max_cascades = 8;
+
+//! Represents a \ref shadow_cascade (the light view projection of one slice
+//! of the camera frustum).
+struct shadow_cascade
+{
+  //! The matrix transforming a position in world space to the clip space of
+  //! the shadow map.
+  mat4 view_projection;
+  vec3 center; //!< The center of the bounding sphere of the slice.
+  real radius; //!< The radius of the bounding sphere of the slice.
+};
+
+//! Writes the distances from the camera of the planes splitting the camera
+//! frustum into cascades.
+//! \note Uses the practical split scheme, a blend of logarithmic splits
+//! (which keep the ratio of texels to pixels constant) and uniform splits
+//! (which avoid over sampling close to the camera).
+//! \note `splits` must have space for `cascade_count + 1` elements, the first
+//! is the near plane and the last is the far plane.
+//! \param n The distance to the near plane of the camera.
+//! \param f The distance to the far plane of the camera.
+//! \param lambda The blend between uniform (0) and logarithmic (1) splits.
+//! \param cascade_count The number of cascades.
+//! \param splits The split distances to write to.
+void shadow_cascade_splits(
+  real n, real f, real lambda, index cascade_count, real* splits);
+
+//! Fits an orthographic projection around each slice of the camera frustum
+//! as seen from a directional light.
+//! \note The eight corners of the camera frustum are found once from the
+//! inverse view projection matrix, the corners of each slice are then
+//! interpolated between them (the same for every cascade so all are computed
+//! together in branch free loops).
+//! \note Each slice is bounded by the smallest sphere with a center on the
+//! axis of the slice. The sphere only depends on the shape of the slice so
+//! its size does not change as the camera rotates. The center of the sphere
+//! in light space is snapped to a whole shadow map texel (see ::vec_snap) so
+//! the shadow map does not shimmer as the camera moves.
+//! \note The radius of each sphere is rounded up to a multiple of at most one
+//! texel (a power of two divided by `shadow_map_size`) so rounding error
+//! does not change its size between frames.
+//! \note The depth range of each projection is centered on the sphere so
+//! the result is the same for left and right handed orthographic
+//! projections.
+//! \param inverse_view_projection The inverse view projection matrix of the
+//! camera (see ::inverse_view_projection), the far plane must be finite.
+//! \param depth_range The depth range of the camera projection. Pass either
+//! {0, 1} or {-1, 1} (or {1, 0} when the projection has been passed to
+//! ::reverse_z).
+//! \param n The distance to the near plane of the camera.
+//! \param f The distance to the far plane of the camera.
+//! \param splits The `cascade_count + 1` split distances (see
+//! ::shadow_cascade_splits).
+//! \param cascade_count The number of cascades (counts greater than
+//! ::k_shadow_max_cascades are clamped, only the first
+//! ::k_shadow_max_cascades cascades are written).
+//! \param light_view The light view matrix (transforming a position in world
+//! space to light space), only the rotation is used.
+//! \param shadow_map_size The width and height in texels of the shadow map
+//! of each cascade.
+//! \param caster_distance How far the depth range is extended toward and
+//! away from the light beyond the bounding sphere (so objects outside the
+//! slice still cast shadows into it).
+//! \param ortho The orthographic projection function to use (e.g.
+//! ::ortho_direct3d_lh), called as `ortho(l, r, b, t, n, f)`.
+//! \param cascades The cascades to write to.
+template<typename Ortho>
+void shadow_cascades(
+  const mat4& inverse_view_projection, const vec2& depth_range, real n,
+  real f, const real* splits, index cascade_count, const affine& light_view,
+  index shadow_map_size, real caster_distance, const Ortho& ortho,
+  shadow_cascade* cascades);
+
+} // namespace as
+
+#include "as-shadow.inl"
@@ -0,0 +1,126 @@
+namespace as
+{
+
+// ref: Fan Zhang, Hanqiu Sun, Leilei Xu, Lee Kit Lun (2006) Parallel-Split
+// Shadow Maps for Large-scale Virtual Environments
+AS_API inline void shadow_cascade_splits(
+  const real n, const real f, const real lambda, const index cascade_count,
+  real* splits)
+{
+  for (index i = 0; i <= cascade_count; ++i) {
+    const real fraction = real(i) / real(cascade_count);
+    const real logarithmic = n * std::pow(f / n, fraction);
+    const real uniform = n + (f - n) * fraction;
+    splits[i] = uniform + (logarithmic - uniform) * lambda;
+  }
+  // avoid rounding error at the ends
+  splits[0] = n;
+  splits[cascade_count] = f;
+}
+
+template<typename Ortho>
+AS_API void shadow_cascades(
+  const mat4& inverse_view_projection, const vec2& depth_range, const real n,
+  const real f, const real* splits, const index cascade_count,
+  const affine& light_view, const index shadow_map_size,
+  const real caster_distance, const Ortho& ortho, shadow_cascade* cascades)
+{
+  // the values of each slice are held in fixed size arrays on the stack
+  const index count = std::min(cascade_count, k_shadow_max_cascades);
+
+  // the corners of the camera frustum (positions on the same ray from the
+  // camera are linear in view space depth)
+  vec3 near_corners[4];
+  vec3 far_corners[4];
+  for (index i = 0; i < 4; ++i) {
+    const real x = (i & 1) != 0 ? 1.0_r : -1.0_r;
+    const real y = (i & 2) != 0 ? 1.0_r : -1.0_r;
+    const vec4 near_position = mat_mul(
+      vec4(x, y, depth_range.x, 1.0_r), inverse_view_projection);
+    const vec4 far_position = mat_mul(
+      vec4(x, y, depth_range.y, 1.0_r), inverse_view_projection);
+    near_corners[i] = vec3_from_vec4(near_position) / near_position.w;
+    far_corners[i] = vec3_from_vec4(far_position) / far_position.w;
+  }
+  const vec3 near_center = (near_corners[0] + near_corners[1]
+                            + near_corners[2] + near_corners[3])
+                         * 0.25_r;
+  const vec3 far_center =
+    (far_corners[0] + far_corners[1] + far_corners[2] + far_corners[3])
+    * 0.25_r;
+  const vec3 axis = far_center - near_center;
+  const real axis_length = vec_length(axis);
+
+  // where each slice begins and ends between the near and far plane
+  real begin[k_shadow_max_cascades];
+  real end[k_shadow_max_cascades];
+  for (index c = 0; c < count; ++c) {
+    begin[c] = (splits[c] - n) / (f - n);
+    end[c] = (splits[c + 1] - n) / (f - n);
+  }
+
+  // the squared distance from the center of the near and far face of each
+  // slice to its farthest corner
+  real begin_extent[k_shadow_max_cascades] = {};
+  real end_extent[k_shadow_max_cascades] = {};
+  for (index i = 0; i < 4; ++i) {
+    const vec3 near_offset = near_corners[i] - near_center;
+    const vec3 far_offset = far_corners[i] - far_center;
+    const vec3 change = far_offset - near_offset;
+    for (index c = 0; c < count; ++c) {
+      const vec3 begin_offset = near_offset + change * begin[c];
+      const vec3 end_offset = near_offset + change * end[c];
+      begin_extent[c] =
+        std::max(begin_extent[c], vec_dot(begin_offset, begin_offset));
+      end_extent[c] = std::max(end_extent[c], vec_dot(end_offset, end_offset));
+    }
+  }
+
+  // ref: Michal Valient (2008) Stable Rendering of Cascaded Shadow Maps
+  // the smallest sphere with a center on the axis of the slice (at distance
+  // x from the near face where the near and far corners are equally far)
+  real center_distance[k_shadow_max_cascades];
+  real radius[k_shadow_max_cascades];
+  for (index c = 0; c < count; ++c) {
+    const real length = axis_length * (end[c] - begin[c]);
+    const real x = std::min(
+      std::max(
+        (length * length + end_extent[c] - begin_extent[c])
+          / (2.0_r * length),
+        0.0_r),
+      length);
+    const real near_radius = x * x + begin_extent[c];
+    const real far_radius = (length - x) * (length - x) + end_extent[c];
+    center_distance[c] = axis_length * begin[c] + x;
+    // rounded up so rounding error does not change the size between frames,
+    // the step is the power of two at least the radius divided by the shadow
+    // map size (at most one texel, and only changes if the radius doubles)
+    const real exact_radius = std::max(
+      std::sqrt(std::max(near_radius, far_radius)),
+      std::numeric_limits<real>::min());
+    const real step = std::exp2(std::ceil(std::log2(exact_radius)))
+                    / real(shadow_map_size);
+    radius[c] = std::ceil(exact_radius / step) * step;
+  }
+
+  const vec3 direction = axis / axis_length;
+  for (index c = 0; c < count; ++c) {
+    const vec3 center = near_center + direction * center_distance[c];
+    const real texel_size = radius[c] * 2.0_r / real(shadow_map_size);
+    // the center in light space (ignoring the translation of the light)
+    const vec3 light_center = affine_transform_dir(light_view, center);
+    const vec2 snapped =
+      vec_snap(vec2(light_center.x, light_center.y), texel_size);
+    // move the center of the sphere to the origin of light space
+    const affine view = affine(
+      light_view.rotation, -vec3(snapped.x, snapped.y, light_center.z));
+    const real depth = radius[c] + caster_distance;
+    const mat4 projection =
+      ortho(-radius[c], radius[c], -radius[c], radius[c], -depth, depth);
+    cascades[c].view_projection = as::view_projection(view, projection);
+    cascades[c].center = center;
+    cascades[c].radius = radius[c];
+  }
+}
+
+} // namespace as
@@ -0,0 +1,97 @@
+//! \file
+//! `as-skeleton`
+
+#pragma once
+
+#include "as-executor.hpp"
+#include "as-math-ops.hpp"
+
+namespace as
+{
+
+//! Array of rigid transformations stored as a structure of arrays.
+//! \note Use `rigid_soa_t<const real>` for input and `rigid_soa_t<real>` for
+//! output.
+template<typename T>
+struct rigid_soa_t
+{
+  T* rotation_w; //!< The w component of the rotation of each transform.
+  T* rotation_x; //!< The x component of the rotation of each transform.
+  T* rotation_y; //!< The y component of the rotation of each transform.
+  T* rotation_z; //!< The z component of the rotation of each transform.
+  T* translation_x; //!< The x component of the translation of each transform.
+  T* translation_y; //!< The y component of the translation of each transform.
+  T* translation_z; //!< The z component of the translation of each transform.
+};
+
+//! Stores a \ref rigid in the structure of arrays at index `i`.
+template<typename T>
+void rigid_soa_set(const rigid_soa_t<T>& rigids, index i, const rigid& r);
+
+//! Returns the \ref rigid stored in the structure of arrays at index `i`.
+template<typename T>
+rigid rigid_soa_get(const rigid_soa_t<T>& rigids, index i);
+
+//! The number of skeleton instances processed by each chunk of
+//! ::skeleton_local_to_model.
+constexpr index k_skeleton_chunk_size = 64;
+
+//! Returns if the joints of a skeleton are sorted topologically (the parent
+//! of every joint comes before it).
+//! \param parents The index of the parent of each joint (`-1` for a root).
+//! \param joint_count The number of joints.
+bool skeleton_parents_sorted(const int32_t* parents, index joint_count);
+
+//! Transforms the local poses of many instances of a skeleton to model space.
+//! \note Poses are stored as a structure of arrays with the instances of each
+//! joint next to each other (the pose of joint `j` of instance `i` is at
+//! `j * instance_count + i`). Joints are visited in order and the instances
+//! of each joint are transformed together in a branch free loop (the parent
+//! is the same for every instance so each instance is one vector lane).
+//! \note The model pose of a joint is its local pose followed by the model
+//! pose of its parent (see ::rigid_mul).
+//! \param parents The index of the parent of each joint (`-1` for a root),
+//! sorted topologically (see ::skeleton_parents_sorted).
+//! \param joint_count The number of joints.
+//! \param local The local pose of each joint of each instance (relative to
+//! its parent).
+//! \param instance_count The number of instances.
+//! \param model The model pose of each joint of each instance to write to.
+//! \param executor The executor to process chunks of instances with (see
+//! ::serial_executor).
+template<typename Executor = serial_executor>
+void skeleton_local_to_model(
+  const int32_t* parents, index joint_count,
+  const rigid_soa_t<const real>& local, index instance_count,
+  const rigid_soa_t<real>& model, const Executor& executor = Executor{});
+
+//! Transforms the local poses of many instances of a skeleton to model space
+//! and writes the skinning palette of each instance (the inverse bind pose
+//! followed by the model pose of each joint, see ::skin_lbs).
+//! \note Performs the same work as ::skeleton_local_to_model, the palette is
+//! written as each joint is visited so no further pass over the poses is
+//! required.
+//! \param parents The index of the parent of each joint (`-1` for a root),
+//! sorted topologically (see ::skeleton_parents_sorted).
+//! \param joint_count The number of joints.
+//! \param local The local pose of each joint of each instance (relative to
+//! its parent).
+//! \param instance_count The number of instances.
+//! \param inverse_bind The inverse bind pose of each joint (transforming from
+//! model space to the space of the joint).
+//! \param model The model pose of each joint of each instance to write to.
+//! \param palette The skinning palette to write to, `joint_count` transforms
+//! for each instance (joint `j` of instance `i` is at
+//! `i * joint_count + j`).
+//! \param executor The executor to process chunks of instances with (see
+//! ::serial_executor).
+template<typename Executor = serial_executor>
+void skeleton_skinning_palette(
+  const int32_t* parents, index joint_count,
+  const rigid_soa_t<const real>& local, index instance_count,
+  const affine* inverse_bind, const rigid_soa_t<real>& model, affine* palette,
+  const Executor& executor = Executor{});
+
+} // namespace as
+
+#include "as-skeleton.inl"
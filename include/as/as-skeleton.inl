@@ -0,0 +1,194 @@
+namespace as
+{
+
+namespace internal
+{
+
+// transforms the local poses of the instances [begin, end) to model space and
+// optionally writes the skinning palette of each (when palette is not null)
+AS_API inline void skeleton_model_chunk(
+  const int32_t* parents, const index joint_count,
+  const rigid_soa_t<const real>& local, const index instance_count,
+  const index begin, const index end, const affine* inverse_bind,
+  const rigid_soa_t<real>& model, affine* palette)
+{
+  const index count = end - begin;
+  for (index j = 0; j < joint_count; ++j) {
+    const index row = j * instance_count + begin;
+    // the row of the parent is read from the same model arrays this row is
+    // written to, the pose is built on the stack and copied afterwards so
+    // the loop does not depend on the two rows being apart
+    real pose[7][k_skeleton_chunk_size];
+    if (parents[j] < 0) {
+      const auto copy_row = [count](const real* values, real* destination) {
+        std::copy(values, values + count, destination);
+      };
+      copy_row(local.rotation_w + row, pose[0]);
+      copy_row(local.rotation_x + row, pose[1]);
+      copy_row(local.rotation_y + row, pose[2]);
+      copy_row(local.rotation_z + row, pose[3]);
+      copy_row(local.translation_x + row, pose[4]);
+      copy_row(local.translation_y + row, pose[5]);
+      copy_row(local.translation_z + row, pose[6]);
+    } else {
+      const index parent_row = parents[j] * instance_count + begin;
+      for (index i = 0; i < count; ++i) {
+        const real lw = local.rotation_w[row + i];
+        const real lx = local.rotation_x[row + i];
+        const real ly = local.rotation_y[row + i];
+        const real lz = local.rotation_z[row + i];
+        const real tx = local.translation_x[row + i];
+        const real ty = local.translation_y[row + i];
+        const real tz = local.translation_z[row + i];
+        const real pw = model.rotation_w[parent_row + i];
+        const real px = model.rotation_x[parent_row + i];
+        const real py = model.rotation_y[parent_row + i];
+        const real pz = model.rotation_z[parent_row + i];
+        // the rotation of the parent followed by the local rotation
+        pose[0][i] = pw * lw - px * lx - py * ly - pz * lz;
+        pose[1][i] = pw * lx + px * lw + py * lz - pz * ly;
+        pose[2][i] = pw * ly + py * lw + pz * lx - px * lz;
+        pose[3][i] = pw * lz + pz * lw + px * ly - py * lx;
+        // the local translation rotated by the parent (t + w * c + v x c
+        // where c = 2 * v x t) and translated
+        const real cx = 2.0_r * (py * tz - pz * ty);
+        const real cy = 2.0_r * (pz * tx - px * tz);
+        const real cz = 2.0_r * (px * ty - py * tx);
+        pose[4][i] = tx + pw * cx + py * cz - pz * cy
+                   + model.translation_x[parent_row + i];
+        pose[5][i] = ty + pw * cy + pz * cx - px * cz
+                   + model.translation_y[parent_row + i];
+        pose[6][i] = tz + pw * cz + px * cy - py * cx
+                   + model.translation_z[parent_row + i];
+      }
+    }
+    std::copy(pose[0], pose[0] + count, model.rotation_w + row);
+    std::copy(pose[1], pose[1] + count, model.rotation_x + row);
+    std::copy(pose[2], pose[2] + count, model.rotation_y + row);
+    std::copy(pose[3], pose[3] + count, model.rotation_z + row);
+    std::copy(pose[4], pose[4] + count, model.translation_x + row);
+    std::copy(pose[5], pose[5] + count, model.translation_y + row);
+    std::copy(pose[6], pose[6] + count, model.translation_z + row);
+
+    if (palette == nullptr) {
+      continue;
+    }
+
+    // the inverse bind pose is the same for every instance (the elements of
+    // the rotation in the order they are stored and then the translation)
+    real bind[12];
+    std::copy(
+      mat_const_data(inverse_bind[j].rotation),
+      mat_const_data(inverse_bind[j].rotation) + 9, bind);
+    bind[9] = inverse_bind[j].translation.x;
+    bind[10] = inverse_bind[j].translation.y;
+    bind[11] = inverse_bind[j].translation.z;
+    real skinning[12][k_skeleton_chunk_size];
+    for (index i = 0; i < count; ++i) {
+      const real w = pose[0][i];
+      const real x = pose[1][i];
+      const real y = pose[2][i];
+      const real z = pose[3][i];
+      // the rotated axes (the columns of ::mat3_from_quat)
+      const real axes[9] = {
+        1.0_r - 2.0_r * (y * y + z * z), 2.0_r * (x * y + w * z),
+        2.0_r * (x * z - w * y),         2.0_r * (x * y - w * z),
+        1.0_r - 2.0_r * (x * x + z * z), 2.0_r * (y * z + w * x),
+        2.0_r * (x * z + w * y),         2.0_r * (y * z - w * x),
+        1.0_r - 2.0_r * (x * x + y * y)};
+      // the inverse bind pose followed by the model pose (see ::affine_mul)
+      for (index k = 0; k < 4; ++k) {
+        for (index e = 0; e < 3; ++e) {
+          skinning[k * 3 + e][i] = bind[k * 3] * axes[e]
+                                 + bind[k * 3 + 1] * axes[3 + e]
+                                 + bind[k * 3 + 2] * axes[6 + e];
+        }
+      }
+      skinning[9][i] += pose[4][i];
+      skinning[10][i] += pose[5][i];
+      skinning[11][i] += pose[6][i];
+    }
+    for (index i = 0; i < count; ++i) {
+      affine& skin = palette[(begin + i) * joint_count + j];
+      for (index e = 0; e < 9; ++e) {
+        skin.rotation[e] = skinning[e][i];
+      }
+      skin.translation =
+        vec3(skinning[9][i], skinning[10][i], skinning[11][i]);
+    }
+  }
+}
+
+} // namespace internal
+
+template<typename T>
+AS_API void rigid_soa_set(
+  const rigid_soa_t<T>& rigids, const index i, const rigid& r)
+{
+  rigids.rotation_w[i] = r.rotation.w;
+  rigids.rotation_x[i] = r.rotation.x;
+  rigids.rotation_y[i] = r.rotation.y;
+  rigids.rotation_z[i] = r.rotation.z;
+  rigids.translation_x[i] = r.translation.x;
+  rigids.translation_y[i] = r.translation.y;
+  rigids.translation_z[i] = r.translation.z;
+}
+
+template<typename T>
+AS_API rigid rigid_soa_get(const rigid_soa_t<T>& rigids, const index i)
+{
+  return rigid(
+    quat(
+      rigids.rotation_w[i], rigids.rotation_x[i], rigids.rotation_y[i],
+      rigids.rotation_z[i]),
+    vec3(rigids.translation_x[i], rigids.translation_y[i],
+         rigids.translation_z[i]));
+}
+
+AS_API inline bool skeleton_parents_sorted(
+  const int32_t* parents, const index joint_count)
+{
+  for (index j = 0; j < joint_count; ++j) {
+    if (parents[j] >= j) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template<typename Executor>
+AS_API void skeleton_local_to_model(
+  const int32_t* parents, const index joint_count,
+  const rigid_soa_t<const real>& local, const index instance_count,
+  const rigid_soa_t<real>& model, const Executor& executor)
+{
+  executor(
+    chunk_count(instance_count, k_skeleton_chunk_size),
+    [&](const index chunk) {
+      internal::skeleton_model_chunk(
+        parents, joint_count, local, instance_count,
+        chunk_begin(chunk, k_skeleton_chunk_size),
+        chunk_end(chunk, instance_count, k_skeleton_chunk_size), nullptr,
+        model, nullptr);
+    });
+}
+
+template<typename Executor>
+AS_API void skeleton_skinning_palette(
+  const int32_t* parents, const index joint_count,
+  const rigid_soa_t<const real>& local, const index instance_count,
+  const affine* inverse_bind, const rigid_soa_t<real>& model, affine* palette,
+  const Executor& executor)
+{
+  executor(
+    chunk_count(instance_count, k_skeleton_chunk_size),
+    [&](const index chunk) {
+      internal::skeleton_model_chunk(
+        parents, joint_count, local, instance_count,
+        chunk_begin(chunk, k_skeleton_chunk_size),
+        chunk_end(chunk, instance_count, k_skeleton_chunk_size),
+        inverse_bind, model, palette);
+    });
+}
+
+} // namespace as
@@ -0,0 +1,110 @@
+//! \file
+//! `as-skin`
+
+#pragma once
+
+#include "as-dual-quat.hpp"
+#include "as-executor.hpp"
+
+namespace as
+{
+
+//! Array of three component vectors stored as a structure of arrays.
+//! \note Use `vec3_soa_t<const real>` for input and `vec3_soa_t<real>` for
+//! output.
+template<typename T>
+struct vec3_soa_t
+{
+  T* x; //!< The x component of each vector.
+  T* y; //!< The y component of each vector.
+  T* z; //!< The z component of each vector.
+};
+
+//! The number of vertices processed by each chunk of a skinning kernel.
+constexpr index k_skin_chunk_size = 4096;
+
+//! Skins an array of vertices with a palette of \ref dual_quat bone
+//! transforms (dual quaternion skinning).
+//! \note The dual quaternions of the bones influencing each vertex are
+//! blended with a weighted sum, normalized and applied to the position and
+//! normal. Unlike blending matrices the result is always a rigid
+//! transformation, so joints do not collapse when bones twist.
+//! \note Influences with a real part on the opposite hemisphere to the first
+//! influence of the vertex are negated before blending (both represent the
+//! same transformation) so the blend takes the shortest path.
+//! \note Vertices are processed in blocks, first the weighted palette entries
+//! of every vertex in the block are summed and then the blended transforms
+//! are normalized and applied, each in a loop over the vertices of the block
+//! (unused influences have a weight of zero and are summed rather than
+//! skipped).
+//! \tparam N The number of influences per vertex (4 or 8), unused influences
+//! must have a weight of zero.
+//! \param palette The transform of each bone (usually the inverse bind pose
+//! multiplied by the animated pose, see ::dual_quat_mul).
+//! \param bones `N` bone indices for each vertex (influence `j` of vertex `i`
+//! is at `i * N + j`), either `uint8_t` or `uint16_t`.
+//! \param weights `N` weights for each vertex, stored the same as `bones`.
+//! Either ::real or quantized as `uint8_t` or `uint16_t` (where the largest
+//! value of the type is a weight of one).
+//! \param positions The position of each vertex.
+//! \param normals The normal of each vertex (pass `nullptr` for every member
+//! to skip skinning normals).
+//! \param count The number of vertices.
+//! \param skinned_positions The skinned positions to write to.
+//! \param skinned_normals The skinned normals to write to (ignored when
+//! `normals` is skipped).
+//! \param executor The executor to process chunks with (see
+//! ::serial_executor).
+template<
+  index N, typename Bone, typename Weight, typename Executor = serial_executor>
+void skin_dual_quat(
+  const dual_quat* palette, const Bone* bones, const Weight* weights,
+  const vec3_soa_t<const real>& positions,
+  const vec3_soa_t<const real>& normals, index count,
+  const vec3_soa_t<real>& skinned_positions,
+  const vec3_soa_t<real>& skinned_normals,
+  const Executor& executor = Executor{});
+
+//! Skins an array of vertices with a palette of \ref affine bone transforms
+//! (linear blend skinning).
+//! \note The transforms of the bones influencing each vertex are blended with
+//! a weighted sum and applied to the position and normal. The skinned normal
+//! is renormalized with a fast reciprocal square root (an estimate refined by
+//! two Newton-Raphson steps, with a relative error of at most `5e-6`).
+//! \note Normals are transformed by the blended ::mat3 directly, which is
+//! only correct for rotation and uniform scale.
+//! \note Vertices are processed in blocks, first the weighted palette entries
+//! of every vertex in the block are summed and then the blended transforms
+//! are applied, each in a branch free loop (structured so the compiler can
+//! vectorize it across vertices).
+//! \tparam N The number of influences per vertex (4 or 8), unused influences
+//! must have a weight of zero and the weights of each vertex must sum to one.
+//! \param palette The transform of each bone (usually the inverse bind pose
+//! multiplied by the animated pose, see ::affine_mul).
+//! \param bones `N` bone indices for each vertex (influence `j` of vertex `i`
+//! is at `i * N + j`), either `uint8_t` or `uint16_t`.
+//! \param weights `N` weights for each vertex, stored the same as `bones`.
+//! Either ::real or quantized as `uint8_t` or `uint16_t` (where the largest
+//! value of the type is a weight of one).
+//! \param positions The position of each vertex.
+//! \param normals The normal of each vertex (pass `nullptr` for every member
+//! to skip skinning normals).
+//! \param count The number of vertices.
+//! \param skinned_positions The skinned positions to write to.
+//! \param skinned_normals The skinned normals to write to (ignored when
+//! `normals` is skipped).
+//! \param executor The executor to process chunks with (see
+//! ::serial_executor).
+template<
+  index N, typename Bone, typename Weight, typename Executor = serial_executor>
+void skin_lbs(
+  const affine* palette, const Bone* bones, const Weight* weights,
+  const vec3_soa_t<const real>& positions,
+  const vec3_soa_t<const real>& normals, index count,
+  const vec3_soa_t<real>& skinned_positions,
+  const vec3_soa_t<real>& skinned_normals,
+  const Executor& executor = Executor{});
+
+} // namespace as
+
+#include "as-skin.inl"
@@ -0,0 +1,303 @@
+namespace as
+{
+
+namespace internal
+{
+
+// the number of vertices blended and transformed together (bounds the size of
+// the temporary arrays on the stack)
+constexpr index k_skin_block_size = 256;
+
+// returns the value to multiply a weight by so the largest value of a
+// quantized weight is one
+template<typename Weight>
+AS_API constexpr real skin_weight_scale()
+{
+  return std::numeric_limits<Weight>::is_integer
+         ? 1.0_r / real(std::numeric_limits<Weight>::max())
+         : 1.0_r;
+}
+
+// ref: Chris Lomont (2003) Fast Inverse Square Root
+// returns an estimate of 1 / sqrt(x) (a relative error of at most 0.035)
+AS_API inline float rsqrt_estimate(const float x)
+{
+  // copied as bytes (the only portable way to reinterpret the bits)
+  uint32_t bits;
+  std::copy_n(
+    reinterpret_cast<const unsigned char*>(&x), sizeof(x),
+    reinterpret_cast<unsigned char*>(&bits));
+  bits = 0x5f375a86u - (bits >> 1);
+  float estimate;
+  std::copy_n(
+    reinterpret_cast<const unsigned char*>(&bits), sizeof(bits),
+    reinterpret_cast<unsigned char*>(&estimate));
+  return estimate;
+}
+
+AS_API inline double rsqrt_estimate(const double x)
+{
+  uint64_t bits;
+  std::copy_n(
+    reinterpret_cast<const unsigned char*>(&x), sizeof(x),
+    reinterpret_cast<unsigned char*>(&bits));
+  bits = 0x5fe6eb50c7b537a9ull - (bits >> 1);
+  double estimate;
+  std::copy_n(
+    reinterpret_cast<const unsigned char*>(&bits), sizeof(bits),
+    reinterpret_cast<unsigned char*>(&estimate));
+  return estimate;
+}
+
+// returns 1 / sqrt(x) refined with two Newton-Raphson steps (a relative error
+// of at most 5e-6, zero is mapped to a large finite value)
+AS_API inline real rsqrt_fast(const real x)
+{
+  real estimate = rsqrt_estimate(x);
+  estimate = estimate * (1.5_r - 0.5_r * x * estimate * estimate);
+  return estimate * (1.5_r - 0.5_r * x * estimate * estimate);
+}
+
+// blends and applies the dual quaternions influencing each vertex in
+// [begin, end)
+template<index N, typename Bone, typename Weight>
+AS_API void skin_dual_quat_block(
+  const dual_quat* palette, const Bone* bones, const Weight* weights,
+  const vec3_soa_t<const real>& positions,
+  const vec3_soa_t<const real>& normals, const index begin, const index end,
+  const vec3_soa_t<real>& skinned_positions,
+  const vec3_soa_t<real>& skinned_normals)
+{
+  const index count = end - begin;
+  const real weight_scale = skin_weight_scale<Weight>();
+
+  // sum the weighted dual quaternions, the real parts (w, x, y, z) and then
+  // the dual parts (the first influence decides the hemisphere of the blend)
+  real blend[8][k_skin_block_size];
+  real pivot[4][k_skin_block_size];
+  for (index i = 0; i < count; ++i) {
+    const index influence = (begin + i) * N;
+    const dual_quat& dq = palette[bones[influence]];
+    const real weight = real(weights[influence]) * weight_scale;
+    pivot[0][i] = dq.real_part.w;
+    pivot[1][i] = dq.real_part.x;
+    pivot[2][i] = dq.real_part.y;
+    pivot[3][i] = dq.real_part.z;
+    blend[0][i] = dq.real_part.w * weight;
+    blend[1][i] = dq.real_part.x * weight;
+    blend[2][i] = dq.real_part.y * weight;
+    blend[3][i] = dq.real_part.z * weight;
+    blend[4][i] = dq.dual_part.w * weight;
+    blend[5][i] = dq.dual_part.x * weight;
+    blend[6][i] = dq.dual_part.y * weight;
+    blend[7][i] = dq.dual_part.z * weight;
+  }
+  for (index j = 1; j < N; ++j) {
+    for (index i = 0; i < count; ++i) {
+      const index influence = (begin + i) * N + j;
+      const dual_quat& dq = palette[bones[influence]];
+      const real alignment =
+        dq.real_part.w * pivot[0][i] + dq.real_part.x * pivot[1][i]
+        + dq.real_part.y * pivot[2][i] + dq.real_part.z * pivot[3][i];
+      // negate influences on the opposite hemisphere
+      const real weight = real(weights[influence]) * weight_scale
+                        * (1.0_r - 2.0_r * real(alignment < 0.0_r));
+      blend[0][i] += dq.real_part.w * weight;
+      blend[1][i] += dq.real_part.x * weight;
+      blend[2][i] += dq.real_part.y * weight;
+      blend[3][i] += dq.real_part.z * weight;
+      blend[4][i] += dq.dual_part.w * weight;
+      blend[5][i] += dq.dual_part.x * weight;
+      blend[6][i] += dq.dual_part.y * weight;
+      blend[7][i] += dq.dual_part.z * weight;
+    }
+  }
+
+  // normalize and apply the blended dual quaternions (results are written to
+  // the stack first so the compiler does not have to check if the output
+  // overlaps the input)
+  real skinned[3][k_skin_block_size];
+  for (index i = 0; i < count; ++i) {
+    const real inv_length = 1.0_r
+                          / std::sqrt(
+                              blend[0][i] * blend[0][i]
+                              + blend[1][i] * blend[1][i]
+                              + blend[2][i] * blend[2][i]
+                              + blend[3][i] * blend[3][i]);
+    const real rw = blend[0][i] * inv_length;
+    const real rx = blend[1][i] * inv_length;
+    const real ry = blend[2][i] * inv_length;
+    const real rz = blend[3][i] * inv_length;
+    const real dw = blend[4][i] * inv_length;
+    const real dx = blend[5][i] * inv_length;
+    const real dy = blend[6][i] * inv_length;
+    const real dz = blend[7][i] * inv_length;
+    // the normalized rotation is kept for the normals
+    blend[0][i] = rw;
+    blend[1][i] = rx;
+    blend[2][i] = ry;
+    blend[3][i] = rz;
+    // the translation (the vector part of 2 * d * conjugate(r))
+    const real tx = 2.0_r * (rw * dx - dw * rx + ry * dz - rz * dy);
+    const real ty = 2.0_r * (rw * dy - dw * ry + rz * dx - rx * dz);
+    const real tz = 2.0_r * (rw * dz - dw * rz + rx * dy - ry * dx);
+    // rotate (p + w * c + v x c where c = 2 * v x p) and translate
+    const real px = positions.x[begin + i];
+    const real py = positions.y[begin + i];
+    const real pz = positions.z[begin + i];
+    const real cx = 2.0_r * (ry * pz - rz * py);
+    const real cy = 2.0_r * (rz * px - rx * pz);
+    const real cz = 2.0_r * (rx * py - ry * px);
+    skinned[0][i] = px + rw * cx + ry * cz - rz * cy + tx;
+    skinned[1][i] = py + rw * cy + rz * cx - rx * cz + ty;
+    skinned[2][i] = pz + rw * cz + rx * cy - ry * cx + tz;
+  }
+  std::copy(skinned[0], skinned[0] + count, skinned_positions.x + begin);
+  std::copy(skinned[1], skinned[1] + count, skinned_positions.y + begin);
+  std::copy(skinned[2], skinned[2] + count, skinned_positions.z + begin);
+
+  if (normals.x == nullptr) {
+    return;
+  }
+  for (index i = 0; i < count; ++i) {
+    const real rw = blend[0][i];
+    const real rx = blend[1][i];
+    const real ry = blend[2][i];
+    const real rz = blend[3][i];
+    const real nx = normals.x[begin + i];
+    const real ny = normals.y[begin + i];
+    const real nz = normals.z[begin + i];
+    const real cx = 2.0_r * (ry * nz - rz * ny);
+    const real cy = 2.0_r * (rz * nx - rx * nz);
+    const real cz = 2.0_r * (rx * ny - ry * nx);
+    skinned[0][i] = nx + rw * cx + ry * cz - rz * cy;
+    skinned[1][i] = ny + rw * cy + rz * cx - rx * cz;
+    skinned[2][i] = nz + rw * cz + rx * cy - ry * cx;
+  }
+  std::copy(skinned[0], skinned[0] + count, skinned_normals.x + begin);
+  std::copy(skinned[1], skinned[1] + count, skinned_normals.y + begin);
+  std::copy(skinned[2], skinned[2] + count, skinned_normals.z + begin);
+}
+
+// blends and applies the affine transforms influencing each vertex in
+// [begin, end)
+template<index N, typename Bone, typename Weight>
+AS_API void skin_lbs_block(
+  const affine* palette, const Bone* bones, const Weight* weights,
+  const vec3_soa_t<const real>& positions,
+  const vec3_soa_t<const real>& normals, const index begin, const index end,
+  const vec3_soa_t<real>& skinned_positions,
+  const vec3_soa_t<real>& skinned_normals)
+{
+  const index count = end - begin;
+  const real weight_scale = skin_weight_scale<Weight>();
+
+  // sum the weighted transforms, the elements of the rotation (in the order
+  // they are stored) and then the translation
+  real blend[12][k_skin_block_size] = {};
+  for (index j = 0; j < N; ++j) {
+    for (index i = 0; i < count; ++i) {
+      const index influence = (begin + i) * N + j;
+      const affine& a = palette[bones[influence]];
+      const real weight = real(weights[influence]) * weight_scale;
+      for (index e = 0; e < 9; ++e) {
+        blend[e][i] += a.rotation[e] * weight;
+      }
+      blend[9][i] += a.translation.x * weight;
+      blend[10][i] += a.translation.y * weight;
+      blend[11][i] += a.translation.z * weight;
+    }
+  }
+
+  // apply the blended transforms (the same for row and column major, see
+  // ::affine_transform_pos), skinned positions may be written over the input
+  // positions so the block is finished on the stack before it is copied
+  real skinned[3][k_skin_block_size];
+  for (index i = 0; i < count; ++i) {
+    const real px = positions.x[begin + i];
+    const real py = positions.y[begin + i];
+    const real pz = positions.z[begin + i];
+    skinned[0][i] =
+      px * blend[0][i] + py * blend[3][i] + pz * blend[6][i] + blend[9][i];
+    skinned[1][i] =
+      px * blend[1][i] + py * blend[4][i] + pz * blend[7][i] + blend[10][i];
+    skinned[2][i] =
+      px * blend[2][i] + py * blend[5][i] + pz * blend[8][i] + blend[11][i];
+  }
+  std::copy(skinned[0], skinned[0] + count, skinned_positions.x + begin);
+  std::copy(skinned[1], skinned[1] + count, skinned_positions.y + begin);
+  std::copy(skinned[2], skinned[2] + count, skinned_positions.z + begin);
+
+  if (normals.x == nullptr) {
+    return;
+  }
+  for (index i = 0; i < count; ++i) {
+    const real nx = normals.x[begin + i];
+    const real ny = normals.y[begin + i];
+    const real nz = normals.z[begin + i];
+    const real x = nx * blend[0][i] + ny * blend[3][i] + nz * blend[6][i];
+    const real y = nx * blend[1][i] + ny * blend[4][i] + nz * blend[7][i];
+    const real z = nx * blend[2][i] + ny * blend[5][i] + nz * blend[8][i];
+    const real inv_length = rsqrt_fast(x * x + y * y + z * z);
+    skinned[0][i] = x * inv_length;
+    skinned[1][i] = y * inv_length;
+    skinned[2][i] = z * inv_length;
+  }
+  std::copy(skinned[0], skinned[0] + count, skinned_normals.x + begin);
+  std::copy(skinned[1], skinned[1] + count, skinned_normals.y + begin);
+  std::copy(skinned[2], skinned[2] + count, skinned_normals.z + begin);
+}
+
+} // namespace internal
+
+template<index N, typename Bone, typename Weight, typename Executor>
+AS_API void skin_dual_quat(
+  const dual_quat* palette, const Bone* bones, const Weight* weights,
+  const vec3_soa_t<const real>& positions,
+  const vec3_soa_t<const real>& normals, const index count,
+  const vec3_soa_t<real>& skinned_positions,
+  const vec3_soa_t<real>& skinned_normals, const Executor& executor)
+{
+  static_assert(N == 4 || N == 8, "Vertices support 4 or 8 influences");
+  static_assert(
+    std::is_same<Bone, uint8_t>::value || std::is_same<Bone, uint16_t>::value,
+    "Bone indices must be uint8_t or uint16_t");
+  executor(chunk_count(count, k_skin_chunk_size), [&](const index chunk) {
+    const index begin = chunk_begin(chunk, k_skin_chunk_size);
+    const index end = chunk_end(chunk, count, k_skin_chunk_size);
+    for (index block = begin; block < end;
+         block += internal::k_skin_block_size) {
+      internal::skin_dual_quat_block<N, Bone, Weight>(
+        palette, bones, weights, positions, normals, block,
+        std::min(block + internal::k_skin_block_size, end), skinned_positions,
+        skinned_normals);
+    }
+  });
+}
+
+template<index N, typename Bone, typename Weight, typename Executor>
+AS_API void skin_lbs(
+  const affine* palette, const Bone* bones, const Weight* weights,
+  const vec3_soa_t<const real>& positions,
+  const vec3_soa_t<const real>& normals, const index count,
+  const vec3_soa_t<real>& skinned_positions,
+  const vec3_soa_t<real>& skinned_normals, const Executor& executor)
+{
+  static_assert(N == 4 || N == 8, "Vertices support 4 or 8 influences");
+  static_assert(
+    std::is_same<Bone, uint8_t>::value || std::is_same<Bone, uint16_t>::value,
+    "Bone indices must be uint8_t or uint16_t");
+  executor(chunk_count(count, k_skin_chunk_size), [&](const index chunk) {
+    const index begin = chunk_begin(chunk, k_skin_chunk_size);
+    const index end = chunk_end(chunk, count, k_skin_chunk_size);
+    for (index block = begin; block < end;
+         block += internal::k_skin_block_size) {
+      internal::skin_lbs_block<N, Bone, Weight>(
+        palette, bones, weights, positions, normals, block,
+        std::min(block + internal::k_skin_block_size, end), skinned_positions,
+        skinned_normals);
+    }
+  });
+}
+
+} // namespace as
@@ -0,0 +1,92 @@
+//! \file
+//! `as-spline`
+
+#pragma once
+
+#include <vector>
+
+#include "as-math-ops.hpp"
+
+namespace as
+{
+
+//! Represents a \ref quat_spline_segment (the values of one segment of a
+//! \ref quat_spline that do not depend on the sampled position).
+//! \note The angle between the keys and between the tangents and the inverse
+//! of their sines are computed once when the spline is built so sampling only
+//! needs the sines of the interpolated angles.
+struct quat_spline_segment
+{
+  quat key0; //!< The key at the start of the segment.
+  quat key1; //!< The key at the end of the segment (in the same hemisphere).
+  quat tangent0; //!< The intermediate quaternion of the start key.
+  //! The intermediate quaternion of the end key (in the same hemisphere as
+  //! `tangent0`).
+  quat tangent1;
+  real key_angle; //!< The angle between `key0` and `key1`.
+  real key_inv_sin; //!< One over the sine of `key_angle`.
+  real tangent_angle; //!< The angle between `tangent0` and `tangent1`.
+  real tangent_inv_sin; //!< One over the sine of `tangent_angle`.
+};
+
+//! Represents a \ref quat_spline (a C1 continuous rotation through a
+//! sequence of keys built from SQUAD segments).
+//! \note Create with ::quat_spline_build and sample with
+//! ::quat_spline_sample.
+struct quat_spline
+{
+  //! The segment between each pair of consecutive keys.
+  std::vector<quat_spline_segment> segments;
+};
+
+//! Returns the intermediate (tangent) quaternion of a key for spherical
+//! quadrangle interpolation (see ::quat_squad).
+//! \note The intermediate quaternion is chosen so the angular velocity of
+//! the segments before and after the key are the same at the key.
+//! \param prev The key before.
+//! \param key The key to compute the intermediate quaternion of.
+//! \param next The key after.
+//! \note The keys must be normalized and `prev` and `next` in the same
+//! hemisphere as `key` (e.g. `quat_dot(prev, key) >= 0`).
+//! ref: Shoemake (1987) Quaternion Calculus and Fast Animation
+quat quat_squad_tangent(const quat& prev, const quat& key, const quat& next);
+
+//! Returns the result of a spherical quadrangle interpolation (SQUAD) between
+//! two keys by ratio `t`.
+//! \note `slerp(slerp(q0, q1, t), slerp(s0, s1, t), 2t(1 - t))`.
+//! \param q0 The key at the start.
+//! \param q1 The key at the end.
+//! \param s0 The intermediate quaternion of `q0` (see ::quat_squad_tangent).
+//! \param s1 The intermediate quaternion of `q1`.
+//! \param t The ratio in the range `[0-1]`.
+quat quat_squad(
+  const quat& q0, const quat& q1, const quat& s0, const quat& s1, real t);
+
+//! Returns a \ref quat_spline passing through the keys.
+//! \note Each key is negated if needed to be in the same hemisphere as the
+//! key before it, the intermediate quaternions of the first and last key are
+//! the keys themselves.
+//! \param keys The keys (these must be normalized).
+//! \param count The number of keys (a spline with one key has one segment
+//! that does not rotate, a spline with no keys has no segments).
+quat_spline quat_spline_build(const quat* keys, index count);
+
+//! Returns the rotation of the \ref quat_spline at `t`.
+//! \note Key `k` is at `t = k`, `t` is clamped to the range
+//! `[0, segments.size()]`.
+//! \note Returns quaternion identity when the spline has no segments.
+//! \note Each sample is found with the precomputed values of its segment (see
+//! \ref quat_spline_segment), the only transcendental functions evaluated
+//! per sample are the sines of the interpolated angles and the angle between
+//! the two inner interpolations.
+quat quat_spline_sample(const quat_spline& spline, real t);
+
+//! Writes the rotation of the \ref quat_spline at each `t` to `quats`.
+//! \note See ::quat_spline_sample.
+//! \note `quats` must have space for at least `count` elements.
+void quat_spline_sample(
+  const quat_spline& spline, const real* ts, index count, quat* quats);
+
+} // namespace as
+
+#include "as-spline.inl"
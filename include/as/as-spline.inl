@@ -0,0 +1,132 @@
+namespace as
+{
+
+namespace internal
+{
+
+// the smallest angle used to interpolate (the sine of a smaller angle is too
+// close to zero to divide by, the interpolation is linear for angles this
+// small)
+constexpr real k_quat_spline_min_angle = 1e-4_r;
+
+// returns the angle between two unit quaternions in the same hemisphere
+// (the half angle from atan2 is accurate for small angles unlike acos)
+AS_API inline real quat_spline_angle(const quat& q0, const quat& q1)
+{
+  return std::max(
+    2.0_r * std::atan2(quat_length(q1 - q0), quat_length(q1 + q0)),
+    k_quat_spline_min_angle);
+}
+
+// returns the spherical interpolation between q0 and q1 by t with the angle
+// between them and one over its sine
+AS_API inline quat quat_spline_slerp(
+  const quat& q0, const quat& q1, const real angle, const real inv_sin,
+  const real t)
+{
+  return q0 * (std::sin((1.0_r - t) * angle) * inv_sin)
+       + q1 * (std::sin(t * angle) * inv_sin);
+}
+
+// returns the rotation of the segment at t in the range [0-1]
+AS_API inline quat quat_spline_segment_sample(
+  const quat_spline_segment& segment, const real t)
+{
+  const quat key = quat_spline_slerp(
+    segment.key0, segment.key1, segment.key_angle, segment.key_inv_sin, t);
+  const quat tangent_key = quat_spline_slerp(
+    segment.tangent0, segment.tangent1, segment.tangent_angle,
+    segment.tangent_inv_sin, t);
+  // the angle between the inner interpolations changes with t
+  const quat tangent =
+    tangent_key * std::copysign(1.0_r, quat_dot(key, tangent_key));
+  const real angle = quat_spline_angle(key, tangent);
+  return quat_spline_slerp(
+    key, tangent, angle, 1.0_r / std::sin(angle), 2.0_r * t * (1.0_r - t));
+}
+
+} // namespace internal
+
+AS_API inline quat quat_squad_tangent(
+  const quat& prev, const quat& key, const quat& next)
+{
+  const quat key_inv = quat_conjugate(key);
+  return key
+       * quat_exp(
+           (quat_log(key_inv * next) + quat_log(key_inv * prev)) * -0.25_r);
+}
+
+AS_API inline quat quat_squad(
+  const quat& q0, const quat& q1, const quat& s0, const quat& s1,
+  const real t)
+{
+  return quat_slerp(
+    quat_slerp(q0, q1, t), quat_slerp(s0, s1, t), 2.0_r * t * (1.0_r - t));
+}
+
+AS_API inline quat_spline quat_spline_build(const quat* keys, const index count)
+{
+  if (count <= 0) {
+    return quat_spline{};
+  }
+
+  // keep each key in the same hemisphere as the one before it
+  std::vector<quat> aligned(keys, keys + count);
+  for (index k = 1; k < count; ++k) {
+    if (quat_dot(aligned[k - 1], aligned[k]) < 0.0_r) {
+      aligned[k] = -aligned[k];
+    }
+  }
+
+  std::vector<quat> tangents(count);
+  tangents.front() = aligned.front();
+  tangents.back() = aligned.back();
+  for (index k = 1; k < count - 1; ++k) {
+    tangents[k] =
+      quat_squad_tangent(aligned[k - 1], aligned[k], aligned[k + 1]);
+  }
+
+  quat_spline spline;
+  const index segment_count = std::max(count - 1, index(1));
+  spline.segments.reserve(segment_count);
+  for (index s = 0; s < segment_count; ++s) {
+    const index next = std::min(s + 1, count - 1);
+    quat_spline_segment segment;
+    segment.key0 = aligned[s];
+    segment.key1 = aligned[next];
+    segment.tangent0 = tangents[s];
+    segment.tangent1 =
+      tangents[next]
+      * std::copysign(1.0_r, quat_dot(tangents[s], tangents[next]));
+    segment.key_angle =
+      internal::quat_spline_angle(segment.key0, segment.key1);
+    segment.key_inv_sin = 1.0_r / std::sin(segment.key_angle);
+    segment.tangent_angle =
+      internal::quat_spline_angle(segment.tangent0, segment.tangent1);
+    segment.tangent_inv_sin = 1.0_r / std::sin(segment.tangent_angle);
+    spline.segments.push_back(segment);
+  }
+  return spline;
+}
+
+AS_API inline quat quat_spline_sample(const quat_spline& spline, const real t)
+{
+  const auto segment_count = index(spline.segments.size());
+  if (segment_count == 0) {
+    return quat::identity();
+  }
+  const real clamped = clamp(t, 0.0_r, real(segment_count));
+  const index segment = std::min(index(clamped), segment_count - 1);
+  return internal::quat_spline_segment_sample(
+    spline.segments[segment], clamped - real(segment));
+}
+
+AS_API inline void quat_spline_sample(
+  const quat_spline& spline, const real* ts, const index count, quat* quats)
+{
+  for (index i = 0; i < count; ++i) {
+    quats[i] = quat_spline_sample(spline, ts[i]);
+  }
+}
+
+} // namespace as
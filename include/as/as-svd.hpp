@@ -0,0 +1,70 @@
+//! \file
+//! `as-svd`
+
+#pragma once
+
+#include <limits>
+#include <tuple>
+
+#include "as-math-ops.hpp"
+
+namespace as
+{
+
+//! Returns the singular value decomposition of a ::mat3 as `(u, sigma, v)`
+//! where the matrix is `u * mat3_scale(sigma) * transpose(v)` (applied to
+//! the basis vectors, `v` transposed first).
+//! \note `u` and `v` are rotations (their determinant is one), the singular
+//! values are sorted by decreasing magnitude and only the last may be
+//! negative (when the matrix is a reflection).
+//! \note The rotation that diagonalizes `transpose(m) * m` is found with a
+//! fixed number of Jacobi sweeps of approximate Givens rotations (no
+//! trigonometric functions and no branches, conditions are selects) and `u`
+//! with a QR decomposition by Givens rotations. Rotations are accumulated as
+//! quaternions.
+//! ref: McAdams et al. (2011) Computing the Singular Value Decomposition of
+//! 3x3 matrices with minimal branching and elementary floating point
+//! operations
+std::tuple<mat3, vec3, mat3> mat3_svd(const mat3& m);
+
+//! Returns the singular value decomposition of a ::mat3 with `u` and `v` as
+//! quaternions (see ::mat3_svd).
+std::tuple<quat, vec3, quat> mat3_svd_quat(const mat3& m);
+
+//! Writes the singular value decomposition of each ::mat3 to `us`, `sigmas`
+//! and `vs` (see ::mat3_svd_quat).
+//! \note Matrices are copied to a structure of arrays in blocks and every
+//! block is decomposed with the same branch free code so the compiler can
+//! vectorize across matrices.
+//! \note `us`, `sigmas` and `vs` must have space for at least `count`
+//! elements.
+void mat3_svd(
+  const mat3* ms, index count, quat* us, vec3* sigmas, quat* vs);
+
+//! Returns the polar decomposition of a ::mat3 as `(rotation, stretch)`
+//! where the matrix is `rotation * stretch` (applied to the basis vectors,
+//! the stretch first).
+//! \note The stretch is symmetric, a reflection (negative determinant) is
+//! represented by a negative stretch so the rotation is always a rotation.
+//! \note Found from the singular value decomposition (see ::mat3_svd), the
+//! rotation is `u * transpose(v)` and the stretch
+//! `v * mat3_scale(sigma) * transpose(v)`.
+//! \note The rotation of the polar decomposition of the cross covariance
+//! matrix of two point sets is the rotation that best aligns them (used by
+//! shape matching and the Kabsch algorithm).
+std::tuple<mat3, mat3> mat3_polar(const mat3& m);
+
+//! Returns the polar decomposition of a ::mat3 with the rotation as a
+//! quaternion (see ::mat3_polar).
+std::tuple<quat, mat3> mat3_polar_quat(const mat3& m);
+
+//! Writes the rotation of the polar decomposition of each ::mat3 to
+//! `rotations` (see ::mat3_polar).
+//! \note Decomposed in blocks that the compiler can vectorize (see
+//! ::mat3_svd).
+//! \note `rotations` must have space for at least `count` elements.
+void mat3_polar(const mat3* ms, index count, quat* rotations);
+
+} // namespace as
+
+#include "as-svd.inl"
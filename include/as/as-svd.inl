@@ -0,0 +1,364 @@
+namespace as
+{
+
+namespace internal
+{
+
+// the number of Jacobi sweeps (each rotates every pair of axes once, fewer
+// leave some matrices unconverged)
+constexpr int k_svd_sweeps = 6;
+
+// the number of matrices decomposed together by the batch functions
+constexpr index k_svd_block_size = 16;
+
+// the singular value decomposition of a matrix (see mat3_svd_quat)
+struct svd_t
+{
+  quat u;
+  vec3 sigma;
+  quat v;
+};
+
+// returns one if lhs is less than rhs and zero otherwise (from the sign of
+// the difference, a comparison converted to real becomes a branch)
+AS_API inline real svd_less_than(const real lhs, const real rhs)
+{
+  return 0.5_r - std::copysign(0.5_r, lhs - rhs);
+}
+
+// returns a if the condition is one and b if it is zero (exact for finite
+// values, arithmetic so it can be vectorized without branches)
+AS_API inline real svd_select(const real condition, const real a, const real b)
+{
+  return a * condition + b * (1.0_r - condition);
+}
+
+// writes the quaternion (cosine and sine of the half angle) of the
+// approximate Givens rotation that reduces s21 of the symmetric matrix
+// (s11, s21, s22), the rotation is pi / 4 when the angle would be larger
+AS_API inline void svd_approximate_givens(
+  const real s11, const real s21, const real s22, real& ch, real& sh)
+{
+  // 3 + 2 * sqrt(2), cos(pi / 8) and sin(pi / 8)
+  constexpr real gamma = 5.828427124746190_r;
+  constexpr real cos_pi_8 = 0.9238795325112867_r;
+  constexpr real sin_pi_8 = 0.3826834323650898_r;
+  const real c = 2.0_r * (s11 - s22);
+  const real exact = svd_less_than(gamma * s21 * s21, c * c);
+  // (kept finite for a zero matrix)
+  const real w = 1.0_r
+               / std::sqrt(
+                 c * c + s21 * s21 + std::numeric_limits<real>::min());
+  ch = svd_select(exact, w * c, cos_pi_8);
+  sh = svd_select(exact, w * s21, sin_pi_8);
+}
+
+// rotates the symmetric matrix to reduce s21 and accumulates the rotation in
+// q (x, y, z, w) where X, Y and Z are the axes of s11, s22 and s33, the
+// matrix is then permuted so the next call reduces the next pair
+template<int X, int Y, int Z>
+AS_API inline void svd_jacobi_conjugate(
+  real& s11, real& s21, real& s22, real& s31, real& s32, real& s33,
+  real (&q)[4])
+{
+  // values too small to change the result are flushed to zero (their
+  // products would be denormal which is slow to compute with)
+  constexpr real epsilon_sq =
+    std::numeric_limits<real>::epsilon() * std::numeric_limits<real>::epsilon();
+  s21 *= svd_less_than(
+    epsilon_sq * (std::abs(s11) + std::abs(s22)), std::abs(s21));
+
+  real ch;
+  real sh;
+  svd_approximate_givens(s11, s21, s22, ch, sh);
+  const real a = ch * ch - sh * sh;
+  const real b = 2.0_r * sh * ch;
+
+  // transpose(rotation) * s * rotation
+  const real r11 = a * (a * s11 + b * s21) + b * (a * s21 + b * s22);
+  const real r21 = a * (a * s21 - b * s11) + b * (a * s22 - b * s21);
+  const real r22 = a * (a * s22 - b * s21) - b * (a * s21 - b * s11);
+  const real r31 = a * s31 + b * s32;
+  const real r32 = a * s32 - b * s31;
+
+  const real t[] = {q[0] * sh, q[1] * sh, q[2] * sh};
+  const real w = q[3] * sh;
+  for (real& component : q) {
+    component *= ch;
+  }
+  q[Z] += w;
+  q[3] -= t[Z];
+  q[X] += t[Y];
+  q[Y] -= t[X];
+
+  // the pair (s22, s33) is reduced next
+  const real r33 = s33;
+  s11 = r22;
+  s21 = r32;
+  s22 = r33;
+  s31 = r21;
+  s32 = r31;
+  s33 = r11;
+}
+
+// performs Sweeps Jacobi sweeps (unrolled so the loops of the batch functions
+// have no control flow)
+template<int Sweeps>
+AS_API inline void svd_jacobi_sweeps(
+  real& s11, real& s21, real& s22, real& s31, real& s32, real& s33,
+  real (&q)[4])
+{
+  if constexpr (Sweeps > 0) {
+    svd_jacobi_conjugate<0, 1, 2>(s11, s21, s22, s31, s32, s33, q);
+    svd_jacobi_conjugate<1, 2, 0>(s11, s21, s22, s31, s32, s33, q);
+    svd_jacobi_conjugate<2, 0, 1>(s11, s21, s22, s31, s32, s33, q);
+    svd_jacobi_sweeps<Sweeps - 1>(s11, s21, s22, s31, s32, s33, q);
+  }
+}
+
+// swaps the columns of the matrix negating the one moved to the second
+// column (a rotation of pi / 2) if the condition is one
+AS_API inline void svd_swap_columns(
+  const real condition, real (&b)[9], const index first, const index second)
+{
+  for (index r = 0; r < 3; ++r) {
+    const real lhs = b[first * 3 + r];
+    const real rhs = b[second * 3 + r];
+    b[first * 3 + r] = svd_select(condition, rhs, lhs);
+    b[second * 3 + r] = svd_select(condition, -lhs, rhs);
+  }
+}
+
+// returns q multiplied by the rotation if the condition is one
+AS_API inline quat svd_rotate(
+  const real condition, const quat& q, const quat& rotation)
+{
+  const quat rotated = q * rotation;
+  return quat(
+    svd_select(condition, rotated.w, q.w),
+    svd_select(condition, rotated.x, q.x),
+    svd_select(condition, rotated.y, q.y),
+    svd_select(condition, rotated.z, q.z));
+}
+
+// writes the quaternion (cosine and sine of the half angle) of the Givens
+// rotation that zeroes a2 below the pivot a1
+AS_API inline void svd_qr_givens(
+  const real a1, const real a2, real& ch, real& sh)
+{
+  constexpr real epsilon = std::numeric_limits<real>::epsilon() * 8.0_r;
+  const real rho = std::sqrt(a1 * a1 + a2 * a2);
+  const real s = a2 * svd_less_than(epsilon, rho);
+  const real c = std::abs(a1) + std::max(rho, epsilon);
+  const real negative = svd_less_than(a1, 0.0_r);
+  const real w = 1.0_r / std::sqrt(c * c + s * s);
+  ch = svd_select(negative, s, c) * w;
+  sh = svd_select(negative, c, s) * w;
+}
+
+// applies the transpose of the Givens rotation of the rows to the matrix
+AS_API inline void svd_rotate_rows(
+  real (&b)[9], const index first, const index second, const real ch,
+  const real sh)
+{
+  const real a = 1.0_r - 2.0_r * sh * sh;
+  const real s = 2.0_r * ch * sh;
+  for (index c = 0; c < 3; ++c) {
+    const real lhs = b[c * 3 + first];
+    const real rhs = b[c * 3 + second];
+    b[c * 3 + first] = a * lhs + s * rhs;
+    b[c * 3 + second] = a * rhs - s * lhs;
+  }
+}
+
+// returns the singular value decomposition of the matrix (branch free and
+// always inlined so it can be used in loops the compiler vectorizes)
+AS_API AS_FORCE_INLINE svd_t svd_decompose(const mat3& m)
+{
+  // the element at row r and column c is m[c * 3 + r] (the basis vectors
+  // are the columns)
+  // transpose(m) * m (symmetric)
+  const auto dot_columns = [&m](const index lhs, const index rhs) {
+    return m[lhs * 3] * m[rhs * 3] + m[lhs * 3 + 1] * m[rhs * 3 + 1]
+         + m[lhs * 3 + 2] * m[rhs * 3 + 2];
+  };
+  real s11 = dot_columns(0, 0);
+  real s21 = dot_columns(0, 1);
+  real s22 = dot_columns(1, 1);
+  real s31 = dot_columns(0, 2);
+  real s32 = dot_columns(1, 2);
+  real s33 = dot_columns(2, 2);
+
+  // the rotation that diagonalizes transpose(m) * m
+  real q[] = {0.0_r, 0.0_r, 0.0_r, 1.0_r};
+  svd_jacobi_sweeps<k_svd_sweeps>(s11, s21, s22, s31, s32, s33, q);
+  quat v = quat(q[3], q[0], q[1], q[2]);
+
+  // m * v
+  const mat3 vm = mat3_from_quat(v);
+  real b[9];
+  for (index c = 0; c < 3; ++c) {
+    for (index r = 0; r < 3; ++r) {
+      b[c * 3 + r] = m[r] * vm[c * 3] + m[3 + r] * vm[c * 3 + 1]
+                   + m[6 + r] * vm[c * 3 + 2];
+    }
+  }
+
+  // sort the columns by decreasing length (rotating v to match)
+  const auto length_sq = [&b](const index c) {
+    return b[c * 3] * b[c * 3] + b[c * 3 + 1] * b[c * 3 + 1]
+         + b[c * 3 + 2] * b[c * 3 + 2];
+  };
+  constexpr real half_sqrt2 = 0.7071067811865476_r;
+  real rho1 = length_sq(0);
+  real rho2 = length_sq(1);
+  real rho3 = length_sq(2);
+  const real swap12 = svd_less_than(rho1, rho2);
+  svd_swap_columns(swap12, b, 0, 1);
+  v = svd_rotate(swap12, v, quat(half_sqrt2, 0.0_r, 0.0_r, half_sqrt2));
+  const real rho12 = rho1;
+  rho1 = svd_select(swap12, rho2, rho1);
+  rho2 = svd_select(swap12, rho12, rho2);
+  const real swap13 = svd_less_than(rho1, rho3);
+  svd_swap_columns(swap13, b, 0, 2);
+  v = svd_rotate(swap13, v, quat(half_sqrt2, 0.0_r, -half_sqrt2, 0.0_r));
+  rho3 = svd_select(swap13, rho1, rho3);
+  const real swap23 = svd_less_than(rho2, rho3);
+  svd_swap_columns(swap23, b, 1, 2);
+  v = svd_rotate(swap23, v, quat(half_sqrt2, half_sqrt2, 0.0_r, 0.0_r));
+
+  // QR decomposition of m * v (r is the diagonal of singular values)
+  real ch1;
+  real sh1;
+  svd_qr_givens(b[0], b[1], ch1, sh1);
+  svd_rotate_rows(b, 0, 1, ch1, sh1);
+  real ch2;
+  real sh2;
+  svd_qr_givens(b[0], b[2], ch2, sh2);
+  svd_rotate_rows(b, 0, 2, ch2, sh2);
+  real ch3;
+  real sh3;
+  svd_qr_givens(b[4], b[5], ch3, sh3);
+  svd_rotate_rows(b, 1, 2, ch3, sh3);
+  const quat u = quat(ch1, 0.0_r, 0.0_r, sh1) * quat(ch2, 0.0_r, -sh2, 0.0_r)
+               * quat(ch3, sh3, 0.0_r, 0.0_r);
+
+  return {u, vec3(b[0], b[4], b[8]), v};
+}
+
+// returns the stretch of the polar decomposition, v * sigma * transpose(v)
+AS_API inline mat3 svd_stretch(const svd_t& svd)
+{
+  const mat3 v = mat3_from_quat(svd.v);
+  const real sigma[] = {svd.sigma.x, svd.sigma.y, svd.sigma.z};
+  mat3 stretch;
+  for (index c = 0; c < 3; ++c) {
+    for (index r = 0; r < 3; ++r) {
+      stretch[c * 3 + r] = v[r] * sigma[0] * v[c]
+                         + v[3 + r] * sigma[1] * v[3 + c]
+                         + v[6 + r] * sigma[2] * v[6 + c];
+    }
+  }
+  return stretch;
+}
+
+} // namespace internal
+
+AS_API inline std::tuple<mat3, vec3, mat3> mat3_svd(const mat3& m)
+{
+  const internal::svd_t svd = internal::svd_decompose(m);
+  return {mat3_from_quat(svd.u), svd.sigma, mat3_from_quat(svd.v)};
+}
+
+AS_API inline std::tuple<quat, vec3, quat> mat3_svd_quat(const mat3& m)
+{
+  const internal::svd_t svd = internal::svd_decompose(m);
+  return {svd.u, svd.sigma, svd.v};
+}
+
+AS_API inline void mat3_svd(
+  const mat3* ms, const index count, quat* us, vec3* sigmas, quat* vs)
+{
+  using internal::k_svd_block_size;
+  for (index begin = 0; begin < count; begin += k_svd_block_size) {
+    const index size = std::min(count - begin, k_svd_block_size);
+    // matrices as a structure of arrays (unused lanes are zero)
+    real elements[9][k_svd_block_size] = {};
+    for (index i = 0; i < size; ++i) {
+      for (index e = 0; e < 9; ++e) {
+        elements[e][i] = ms[begin + i][e];
+      }
+    }
+    real values[11][k_svd_block_size];
+    for (index i = 0; i < k_svd_block_size; ++i) {
+      const internal::svd_t svd = internal::svd_decompose(mat3(
+        elements[0][i], elements[1][i], elements[2][i], elements[3][i],
+        elements[4][i], elements[5][i], elements[6][i], elements[7][i],
+        elements[8][i]));
+      values[0][i] = svd.u.w;
+      values[1][i] = svd.u.x;
+      values[2][i] = svd.u.y;
+      values[3][i] = svd.u.z;
+      values[4][i] = svd.sigma.x;
+      values[5][i] = svd.sigma.y;
+      values[6][i] = svd.sigma.z;
+      values[7][i] = svd.v.w;
+      values[8][i] = svd.v.x;
+      values[9][i] = svd.v.y;
+      values[10][i] = svd.v.z;
+    }
+    for (index i = 0; i < size; ++i) {
+      us[begin + i] =
+        quat(values[0][i], values[1][i], values[2][i], values[3][i]);
+      sigmas[begin + i] = vec3(values[4][i], values[5][i], values[6][i]);
+      vs[begin + i] =
+        quat(values[7][i], values[8][i], values[9][i], values[10][i]);
+    }
+  }
+}
+
+AS_API inline std::tuple<mat3, mat3> mat3_polar(const mat3& m)
+{
+  const internal::svd_t svd = internal::svd_decompose(m);
+  return {
+    mat3_from_quat(svd.u * quat_conjugate(svd.v)), internal::svd_stretch(svd)};
+}
+
+AS_API inline std::tuple<quat, mat3> mat3_polar_quat(const mat3& m)
+{
+  const internal::svd_t svd = internal::svd_decompose(m);
+  return {svd.u * quat_conjugate(svd.v), internal::svd_stretch(svd)};
+}
+
+AS_API inline void mat3_polar(
+  const mat3* ms, const index count, quat* rotations)
+{
+  using internal::k_svd_block_size;
+  for (index begin = 0; begin < count; begin += k_svd_block_size) {
+    const index size = std::min(count - begin, k_svd_block_size);
+    real elements[9][k_svd_block_size] = {};
+    for (index i = 0; i < size; ++i) {
+      for (index e = 0; e < 9; ++e) {
+        elements[e][i] = ms[begin + i][e];
+      }
+    }
+    real values[4][k_svd_block_size];
+    for (index i = 0; i < k_svd_block_size; ++i) {
+      const internal::svd_t svd = internal::svd_decompose(mat3(
+        elements[0][i], elements[1][i], elements[2][i], elements[3][i],
+        elements[4][i], elements[5][i], elements[6][i], elements[7][i],
+        elements[8][i]));
+      const quat rotation = svd.u * quat_conjugate(svd.v);
+      values[0][i] = rotation.w;
+      values[1][i] = rotation.x;
+      values[2][i] = rotation.y;
+      values[3][i] = rotation.z;
+    }
+    for (index i = 0; i < size; ++i) {
+      rotations[begin + i] =
+        quat(values[0][i], values[1][i], values[2][i], values[3][i]);
+    }
+  }
+}
+
+} // namespace as
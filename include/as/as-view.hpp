@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "as-executor.hpp"
 #include "as-math-ops.hpp"
 
 namespace as
@@ -160,6 +161,28 @@ mat4 ortho_vulkan_rh(real l, real r, real b, real t, real n, real f);
 //! \param f The far plane of the clipping volume.
 mat4 ortho_vulkan_lh(real l, real r, real b, real t, real n, real f);
 
+//! Returns the combined view projection matrix (transforming a position in
+//! world space to clip space).
+//! \param view The camera view matrix (stored as an affine transformation due
+//! to axis orthogonality).
+//! \param projection The camera projection matrix.
+mat4 view_projection(const affine& view, const mat4& projection);
+
+//! Returns the inverse of the combined view projection matrix (transforming a
+//! position in clip space to world space).
+//! \note The view is inverted as an affine transformation which is cheaper
+//! and more accurate than inverting the view projection matrix.
+//! \param view The camera view matrix (stored as an affine transformation due
+//! to axis orthogonality).
+//! \param projection The camera projection matrix.
+mat4 inverse_view_projection(const affine& view, const mat4& projection);
+
+//! The number of positions processed by each chunk of a batched
+//! ::world_to_screen.
+//! \note A multiple of 32 so each chunk writes whole words of the clipped
+//! bitmask.
+constexpr index k_world_to_screen_chunk_size = 1024;
+
 //! Takes a position in world space and transforms it to screen coordinates.
 //! \param world_position The position in world space.
 //! \param projection The camera projection matrix.
@@ -170,6 +193,47 @@ vec2i world_to_screen(
   const vec3& world_position, const mat4& projection, const affine& view,
   const vec2i& screen_dimension);
 
+//! Takes a position in world space and transforms it to screen coordinates.
+//! \note The position must be in front of the camera, geometry crossing the
+//! near plane should be clipped first (see ::clip_triangles).
+//! \param world_position The position in world space.
+//! \param view_projection The camera view projection matrix (see
+//! ::view_projection).
+//! \param screen_dimension The size of the screen/viewport.
+vec2i world_to_screen(
+  const vec3& world_position, const mat4& view_projection,
+  const vec2i& screen_dimension);
+
+//! Takes an array of positions in world space (stored as a structure of
+//! arrays) and transforms them to screen coordinates.
+//! \note Screen positions are rounded in the same way as the single position
+//! version of ::world_to_screen. The view projection matrix is computed once
+//! by the caller (see ::view_projection) and each chunk is projected to
+//! temporary arrays first (a division and clamp per position with no
+//! branches) before being rounded.
+//! \note Bit `i % 32` of `clipped[i / 32]` is set if position `i` is behind
+//! the camera (its clip space w is not positive), the screen position of a
+//! clipped position should be ignored. `clipped` must have space for
+//! `chunk_count(count, 32)` elements.
+//! \note Screen positions far outside the screen are clamped to `+/-2^30` so
+//! they remain representable as `int32_t`.
+//! \param x The x component of each position in world space.
+//! \param y The y component of each position in world space.
+//! \param z The z component of each position in world space.
+//! \param count The number of positions.
+//! \param view_projection The camera view projection matrix.
+//! \param screen_dimension The size of the screen/viewport.
+//! \param screen_positions The screen positions to write to.
+//! \param clipped The bitmask of clipped positions to write to.
+//! \param executor The executor to process chunks with (see
+//! ::serial_executor).
+template<typename Executor = serial_executor>
+void world_to_screen(
+  const real* x, const real* y, const real* z, index count,
+  const mat4& view_projection, const vec2i& screen_dimension,
+  vec2i* screen_positions, uint32_t* clipped,
+  const Executor& executor = Executor{});
+
 //! Takes a position in screen space and returns it in world space aligned to
 //! the near clip plane of the camera.
 //! \param screen_position The position in screen space.
@@ -178,11 +242,133 @@ vec2i world_to_screen(
 //! to axis orthogonality).
 //! \param screen_dimension The size of the screen/viewport.
 //! \param depth_range The depth range depending on if depth is mapped from
-//! 0 to 1 or -1 to 1. Pass either {0, 1} or {-1, 1}.
+//! 0 to 1 or -1 to 1. Pass either {0, 1} or {-1, 1} (or {1, 0} when the
+//! projection has been passed to ::reverse_z).
 vec3 screen_to_world(
   const vec2i& screen_position, const mat4& projection, const affine& view,
   const vec2i& screen_dimension, const vec2& depth_range);
 
+//! Takes a position in screen space and returns it in world space aligned to
+//! the near clip plane of the camera.
+//! \param screen_position The position in screen space.
+//! \param inverse_view_projection The inverse of the camera view projection
+//! matrix (see ::inverse_view_projection).
+//! \param screen_dimension The size of the screen/viewport.
+//! \param depth_range The depth range depending on if depth is mapped from
+//! 0 to 1 or -1 to 1. Pass either {0, 1} or {-1, 1} (or {1, 0} when the
+//! projection has been passed to ::reverse_z).
+vec3 screen_to_world(
+  const vec2i& screen_position, const mat4& inverse_view_projection,
+  const vec2i& screen_dimension, const vec2& depth_range);
+
+//! The homogeneous world space positions of a ray through the center of the
+//! top left pixel of the screen and the change in those positions per pixel.
+//! \note The clip space position of a pixel is linear in screen space so the
+//! positions for pixel `(x, y)` are `near_position + delta_x * x + delta_y *
+//! y` (and similarly for `far_position`).
+struct pixel_ray_deltas
+{
+  vec4 near_position; //!< The position on the near clip plane.
+  vec4 far_position; //!< The position halfway through the depth range.
+  vec4 delta_x; //!< The change in position per pixel to the right.
+  vec4 delta_y; //!< The change in position per pixel down.
+};
+
+//! Returns the \ref pixel_ray_deltas of a camera.
+//! \param inverse_view_projection The inverse of the camera view projection
+//! matrix (see ::inverse_view_projection).
+//! \param screen_dimension The size of the screen/viewport.
+//! \param depth_range The depth range depending on if depth is mapped from
+//! 0 to 1 or -1 to 1. Pass either {0, 1} or {-1, 1} (or {1, 0} when the
+//! projection has been passed to ::reverse_z).
+pixel_ray_deltas pixel_ray_deltas_from_mat4(
+  const mat4& inverse_view_projection, const vec2i& screen_dimension,
+  const vec2& depth_range);
+
+//! The width and height in pixels of the tiles ::camera_rays splits the
+//! screen into.
+constexpr index k_camera_rays_tile_size = 32;
+
+//! Generates a ray through the center of each pixel of the screen.
+//! \note Rays are written in row major order (the ray for pixel `(x, y)` is at
+//! `y * screen_dimension.x + x`), pixel `(0, 0)` is the top left of the screen
+//! (matching ::screen_to_world).
+//! \note Each origin lies on the near clip plane and each direction is
+//! normalized. The clip space position of a pixel is linear along a scanline
+//! so the inverse view projection is applied once per scanline, the
+//! homogeneous position of each pixel is then the start of the scanline plus a
+//! multiple of a per pixel delta (only the perspective divide and normalize
+//! remain per pixel). Scanlines are processed in a branch free loop (GCC
+//! and Clang require `-fno-math-errno` to vectorize the square root of the
+//! normalize).
+//! \note The screen is split into tiles of ::k_camera_rays_tile_size pixels
+//! and each tile is passed to the executor.
+//! \param inverse_view_projection The inverse of the camera view projection
+//! matrix (see ::view_projection).
+//! \param screen_dimension The size of the screen/viewport.
+//! \param depth_range The depth range depending on if depth is mapped from
+//! 0 to 1 or -1 to 1. Pass either {0, 1} or {-1, 1} (or {1, 0} when the
+//! projection has been passed to ::reverse_z).
+//! \param origin_x The x component of each ray origin to write to.
+//! \param origin_y The y component of each ray origin to write to.
+//! \param origin_z The z component of each ray origin to write to.
+//! \param direction_x The x component of each ray direction to write to.
+//! \param direction_y The y component of each ray direction to write to.
+//! \param direction_z The z component of each ray direction to write to.
+//! \param executor The executor to process tiles with (see
+//! ::serial_executor).
+template<typename Executor = serial_executor>
+void camera_rays(
+  const mat4& inverse_view_projection, const vec2i& screen_dimension,
+  const vec2& depth_range, real* origin_x, real* origin_y, real* origin_z,
+  real* direction_x, real* direction_y, real* direction_z,
+  const Executor& executor = Executor{});
+
+//! Generates a ray through the center of each pixel of the screen from
+//! precomputed \ref pixel_ray_deltas.
+//! \note See ::camera_rays(const mat4&, const vec2i&, const vec2&, real*,
+//! real*, real*, real*, real*, real*, const Executor&) for details.
+template<typename Executor = serial_executor>
+void camera_rays(
+  const pixel_ray_deltas& deltas, const vec2i& screen_dimension,
+  real* origin_x, real* origin_y, real* origin_z, real* direction_x,
+  real* direction_y, real* direction_z, const Executor& executor = Executor{});
+
+//! Takes a depth buffer and writes the world space position of the center of
+//! each pixel.
+//! \note Depth values are as stored in the depth buffer (from 0 to 1), the
+//! normalized device coordinate depth is found from `depth_range` (so the
+//! value of a pixel on the near plane is 0 for OpenGL and Direct3D and 1 for a
+//! projection passed to ::reverse_z).
+//! \note Pixels are in row major order (the depth of pixel `(x, y)` is at
+//! `y * screen_dimension.x + x`), pixel `(0, 0)` is the top left of the screen
+//! (matching ::screen_to_world).
+//! \note The inverse view projection is computed once and applied once per
+//! scanline, each pixel then only adds a multiple of the per pixel and per
+//! depth deltas before the perspective divide. Every pixel of a scanline is
+//! independent of the others and scanlines are passed to the executor.
+//! \note Positions at the far plane of a projection with an infinite far
+//! plane are not finite.
+//! \param depth The depth of each pixel.
+//! \param screen_dimension The size of the screen/viewport (and depth
+//! buffer).
+//! \param projection The camera projection matrix.
+//! \param view The camera view matrix (stored as an affine transformation due
+//! to axis orthogonality).
+//! \param depth_range The depth range depending on if depth is mapped from
+//! 0 to 1 or -1 to 1. Pass either {0, 1} or {-1, 1} (or {1, 0} when the
+//! projection has been passed to ::reverse_z).
+//! \param x The x component of each world space position to write to.
+//! \param y The y component of each world space position to write to.
+//! \param z The z component of each world space position to write to.
+//! \param executor The executor to process scanlines with (see
+//! ::serial_executor).
+template<typename Executor = serial_executor>
+void depth_buffer_to_world(
+  const float* depth, const vec2i& screen_dimension, const mat4& projection,
+  const affine& view, const vec2& depth_range, real* x, real* y, real* z,
+  const Executor& executor = Executor{});
+
 //! Returns a vec2 `(real, real)` from two `int32_t`s.
 constexpr vec2 vec2_from_ints(int32_t x, int32_t y);
 
@@ -176,13 +176,32 @@ AS_API inline mat4 ortho_vulkan_lh(
   return as::mat_mul(ortho_opengl_lh(l, r, b, t, n, f), vulkan_clip);
 }
 
+AS_API inline mat4 view_projection(const affine& view, const mat4& projection)
+{
+  return mat_mul(mat4_from_affine(view), projection);
+}
+
+AS_API inline mat4 inverse_view_projection(
+  const affine& view, const mat4& projection)
+{
+  return mat_mul(
+    mat_inverse(projection), mat4_from_affine(affine_inverse(view)));
+}
+
 AS_API inline vec2i world_to_screen(
   const vec3& world_position, const mat4& projection, const affine& view,
   const vec2i& screen_dimension)
 {
-  const vec4 clip = mat_mul(
-    vec4_from_vec3(world_position, 1.0_r),
-    mat_mul(mat4_from_affine(view), projection));
+  return world_to_screen(
+    world_position, view_projection(view, projection), screen_dimension);
+}
+
+AS_API inline vec2i world_to_screen(
+  const vec3& world_position, const mat4& view_projection,
+  const vec2i& screen_dimension)
+{
+  const vec4 clip =
+    mat_mul(vec4_from_vec3(world_position, 1.0_r), view_projection);
   const vec3 ndc = vec3_from_vec4(clip / clip.w);
   const vec2 screen = (vec2_from_vec3(ndc) + vec2::one()) * 0.5_r;
   return vec2i(
@@ -192,21 +211,248 @@ AS_API inline vec2i world_to_screen(
       std::round((1.0_r - screen.y) * vec2::value_type(screen_dimension.y))));
 }
 
+template<typename Executor>
+AS_API void world_to_screen(
+  const real* x, const real* y, const real* z, const index count,
+  const mat4& view_projection, const vec2i& screen_dimension,
+  vec2i* screen_positions, uint32_t* clipped, const Executor& executor)
+{
+  // coefficients mapping a position to each component of its clip space
+  // position (mat_mul(vec4, mat4) reads memory the same way for row and
+  // column major)
+  const mat4& m = view_projection;
+  const vec4 cx(m[0], m[4], m[8], m[12]);
+  const vec4 cy(m[1], m[5], m[9], m[13]);
+  const vec4 cw(m[3], m[7], m[11], m[15]);
+  const vec2 dimension = vec2_from_vec2i(screen_dimension);
+  // largest screen coordinate (exactly representable as a float)
+  constexpr real limit = real(1 << 30);
+
+  executor(
+    chunk_count(count, k_world_to_screen_chunk_size), [&](const index chunk) {
+      const index begin = chunk_begin(chunk, k_world_to_screen_chunk_size);
+      const index end = chunk_end(chunk, count, k_world_to_screen_chunk_size);
+
+      real screen_x[k_world_to_screen_chunk_size];
+      real screen_y[k_world_to_screen_chunk_size];
+      real w[k_world_to_screen_chunk_size];
+      for (index i = begin; i < end; ++i) {
+        const index local = i - begin;
+        const real clip_x = x[i] * cx.x + y[i] * cx.y + z[i] * cx.z + cx.w;
+        const real clip_y = x[i] * cy.x + y[i] * cy.y + z[i] * cy.z + cy.w;
+        const real clip_w = x[i] * cw.x + y[i] * cw.y + z[i] * cw.z + cw.w;
+        // avoid dividing by zero for positions on the camera plane
+        const real inv_w = 1.0_r / (clip_w + real(clip_w == 0.0_r));
+        const real sx = (clip_x * inv_w + 1.0_r) * 0.5_r;
+        const real sy = (clip_y * inv_w + 1.0_r) * 0.5_r;
+        screen_x[local] = std::min(std::max(sx * dimension.x, -limit), limit);
+        screen_y[local] =
+          std::min(std::max((1.0_r - sy) * dimension.y, -limit), limit);
+        w[local] = clip_w;
+      }
+
+      for (index word_begin = begin; word_begin < end; word_begin += 32) {
+        const index word_end = std::min(word_begin + 32, end);
+        uint32_t bits = 0;
+        for (index i = word_begin; i < word_end; ++i) {
+          const index local = i - begin;
+          screen_positions[i] = vec2i(
+            vec2i::value_type(std::round(screen_x[local])),
+            vec2i::value_type(std::round(screen_y[local])));
+          bits |= uint32_t(w[local] <= 0.0_r) << uint32_t(i - word_begin);
+        }
+        clipped[word_begin / 32] = bits;
+      }
+    });
+}
+
 AS_API inline vec3 screen_to_world(
   const vec2i& screen_position, const mat4& projection, const affine& view,
   const vec2i& screen_dimension, const vec2& depth_range)
+{
+  return screen_to_world(
+    screen_position, inverse_view_projection(view, projection),
+    screen_dimension, depth_range);
+}
+
+AS_API inline vec3 screen_to_world(
+  const vec2i& screen_position, const mat4& inverse_view_projection,
+  const vec2i& screen_dimension, const vec2& depth_range)
 {
   const vec2 normalized_screen =
     vec2_from_ints(screen_position.x, screen_dimension.y - screen_position.y)
     / vec2_from_vec2i(screen_dimension);
   const vec2 ndc = (normalized_screen * 2.0_r) - vec2::one();
+  // the near plane is at the first depth of the range
   vec4 world_position = mat_mul(
-    vec4(ndc.x, ndc.y, depth_range.x, depth_range.y),
-    mat_mul(mat_inverse(projection), mat4_from_affine(affine_inverse(view))));
+    vec4(ndc.x, ndc.y, depth_range.x, 1.0_r), inverse_view_projection);
   world_position /= world_position.w;
   return vec3_from_vec4(world_position);
 }
 
+namespace internal
+{
+
+// writes the rays of pixels [begin, end) of a scanline given the homogeneous
+// near and far positions of the first pixel and the change per pixel
+// (end - begin must not be greater than k_camera_rays_tile_size)
+AS_API inline void camera_rays_scanline(
+  const vec4& near_h, const vec4& far_h, const vec4& delta, const index begin,
+  const index end, real* origin_x, real* origin_y, real* origin_z,
+  real* direction_x, real* direction_y, real* direction_z)
+{
+  // rays are written to locals first as the outputs may alias (too many
+  // pointers for the compiler to check them all before vectorizing)
+  real ox[k_camera_rays_tile_size];
+  real oy[k_camera_rays_tile_size];
+  real oz[k_camera_rays_tile_size];
+  real dx[k_camera_rays_tile_size];
+  real dy[k_camera_rays_tile_size];
+  real dz[k_camera_rays_tile_size];
+  const index count = end - begin;
+  for (index i = 0; i < count; ++i) {
+    const real step = real(int32_t(begin + i));
+    const real inv_near_w = 1.0_r / (near_h.w + delta.w * step);
+    const real inv_far_w = 1.0_r / (far_h.w + delta.w * step);
+    const real x = (near_h.x + delta.x * step) * inv_near_w;
+    const real y = (near_h.y + delta.y * step) * inv_near_w;
+    const real z = (near_h.z + delta.z * step) * inv_near_w;
+    const real to_far_x = (far_h.x + delta.x * step) * inv_far_w - x;
+    const real to_far_y = (far_h.y + delta.y * step) * inv_far_w - y;
+    const real to_far_z = (far_h.z + delta.z * step) * inv_far_w - z;
+    const real inv_length = 1.0_r
+                          / std::sqrt(
+                              to_far_x * to_far_x + to_far_y * to_far_y
+                              + to_far_z * to_far_z);
+    ox[i] = x;
+    oy[i] = y;
+    oz[i] = z;
+    dx[i] = to_far_x * inv_length;
+    dy[i] = to_far_y * inv_length;
+    dz[i] = to_far_z * inv_length;
+  }
+  std::copy(ox, ox + count, origin_x + begin);
+  std::copy(oy, oy + count, origin_y + begin);
+  std::copy(oz, oz + count, origin_z + begin);
+  std::copy(dx, dx + count, direction_x + begin);
+  std::copy(dy, dy + count, direction_y + begin);
+  std::copy(dz, dz + count, direction_z + begin);
+}
+
+} // namespace internal
+
+AS_API inline pixel_ray_deltas pixel_ray_deltas_from_mat4(
+  const mat4& inverse_view_projection, const vec2i& screen_dimension,
+  const vec2& depth_range)
+{
+  // the homogeneous world position of a normalized device coordinate is
+  // ndc.x * m0 + ndc.y * m1 + depth * m2 + m3 (where mi are the elements
+  // mat_mul(vec4, mat4) multiplies component i by)
+  const mat4& m = inverse_view_projection;
+  const vec4 m0(m[0], m[1], m[2], m[3]);
+  const vec4 m1(m[4], m[5], m[6], m[7]);
+  const vec4 m2(m[8], m[9], m[10], m[11]);
+  const vec4 m3(m[12], m[13], m[14], m[15]);
+  const vec2 dimension = vec2_from_vec2i(screen_dimension);
+  // ndc of the center of the top left pixel
+  const vec4 first = m0 * (1.0_r / dimension.x - 1.0_r)
+                   + m1 * (1.0_r - 1.0_r / dimension.y) + m3;
+  // the far position is taken halfway through the depth range so it remains
+  // finite for an infinite far plane
+  const real far_depth = (depth_range.x + depth_range.y) * 0.5_r;
+  return {
+    first + m2 * depth_range.x, first + m2 * far_depth,
+    m0 * (2.0_r / dimension.x), m1 * (-2.0_r / dimension.y)};
+}
+
+template<typename Executor>
+AS_API void camera_rays(
+  const mat4& inverse_view_projection, const vec2i& screen_dimension,
+  const vec2& depth_range, real* origin_x, real* origin_y, real* origin_z,
+  real* direction_x, real* direction_y, real* direction_z,
+  const Executor& executor)
+{
+  camera_rays(
+    pixel_ray_deltas_from_mat4(
+      inverse_view_projection, screen_dimension, depth_range),
+    screen_dimension, origin_x, origin_y, origin_z, direction_x, direction_y,
+    direction_z, executor);
+}
+
+template<typename Executor>
+AS_API void camera_rays(
+  const pixel_ray_deltas& deltas, const vec2i& screen_dimension,
+  real* origin_x, real* origin_y, real* origin_z, real* direction_x,
+  real* direction_y, real* direction_z, const Executor& executor)
+{
+  const index width = screen_dimension.x;
+  const index height = screen_dimension.y;
+  const index tiles_x = chunk_count(width, k_camera_rays_tile_size);
+  const index tiles_y = chunk_count(height, k_camera_rays_tile_size);
+
+  executor(tiles_x * tiles_y, [&](const index tile) {
+    const index tile_x = tile % tiles_x;
+    const index tile_y = tile / tiles_x;
+    const index begin_x = chunk_begin(tile_x, k_camera_rays_tile_size);
+    const index end_x = chunk_end(tile_x, width, k_camera_rays_tile_size);
+    const index begin_y = chunk_begin(tile_y, k_camera_rays_tile_size);
+    const index end_y = chunk_end(tile_y, height, k_camera_rays_tile_size);
+
+    for (index y = begin_y; y < end_y; ++y) {
+      const vec4 row = deltas.delta_y * real(y);
+      const index offset = y * width;
+      internal::camera_rays_scanline(
+        deltas.near_position + row, deltas.far_position + row, deltas.delta_x,
+        begin_x, end_x, origin_x + offset, origin_y + offset,
+        origin_z + offset, direction_x + offset, direction_y + offset,
+        direction_z + offset);
+    }
+  });
+}
+
+template<typename Executor>
+AS_API void depth_buffer_to_world(
+  const float* depth, const vec2i& screen_dimension, const mat4& projection,
+  const affine& view, const vec2& depth_range, real* x, real* y, real* z,
+  const Executor& executor)
+{
+  const index width = screen_dimension.x;
+  const index height = screen_dimension.y;
+
+  const mat4 m = inverse_view_projection(view, projection);
+  const vec4 m0(m[0], m[1], m[2], m[3]);
+  const vec4 m1(m[4], m[5], m[6], m[7]);
+  const vec4 m2(m[8], m[9], m[10], m[11]);
+  const vec4 m3(m[12], m[13], m[14], m[15]);
+  // stored depth (0 to 1) to normalized device coordinate depth
+  const real depth_min = std::min(depth_range.x, depth_range.y);
+  const real depth_scale = std::abs(depth_range.y - depth_range.x);
+  const vec4 delta_x = m0 * (2.0_r / real(width));
+  const vec4 delta_depth = m2 * depth_scale;
+  const real first_x = 1.0_r / real(width) - 1.0_r;
+
+  executor(height, [&](const index row) {
+    const real ndc_y = 1.0_r - (real(row) + 0.5_r) * (2.0_r / real(height));
+    const vec4 start = m0 * first_x + m1 * ndc_y + m2 * depth_min + m3;
+    const real start_x = start.x, start_y = start.y;
+    const real start_z = start.z, start_w = start.w;
+    const index offset = row * width;
+    const float* row_depth = depth + offset;
+    real* row_x = x + offset;
+    real* row_y = y + offset;
+    real* row_z = z + offset;
+    for (index i = 0; i < width; ++i) {
+      const real step = real(int32_t(i));
+      const real d = real(row_depth[i]);
+      const real inv_w =
+        1.0_r / (start_w + delta_x.w * step + delta_depth.w * d);
+      row_x[i] = (start_x + delta_x.x * step + delta_depth.x * d) * inv_w;
+      row_y[i] = (start_y + delta_x.y * step + delta_depth.y * d) * inv_w;
+      row_z[i] = (start_z + delta_x.z * step + delta_depth.z * d) * inv_w;
+    }
+  });
+}
+
 AS_API constexpr vec2 vec2_from_ints(const int32_t x, const int32_t y)
 {
   return {vec2::value_type(x), vec2::value_type(y)};
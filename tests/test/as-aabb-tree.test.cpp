@@ -0,0 +1,224 @@
+#include "as-helpers.test.hpp"
+#include "as/as-aabb-tree.hpp"
+#include "catch-matchers.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace unit_test
+{
+
+// types
+using as::aabb;
+using as::aabb_tree;
+using as::index;
+using as::real;
+using as::vec3;
+
+// functions
+using as::operator""_r;
+
+using proxy_pair = std::pair<int32_t, int32_t>;
+
+static aabb make_box(std::mt19937& gen)
+{
+  std::uniform_real_distribution<real> position(-50.0_r, 50.0_r);
+  std::uniform_real_distribution<real> size(0.5_r, 3.0_r);
+  const vec3 min(position(gen), position(gen), position(gen));
+  return aabb(min, min + vec3(size(gen), size(gen), size(gen)));
+}
+
+// validates links, heights, balance and bounds and returns the leaf count
+static index check_tree(const aabb_tree& tree, const int32_t node)
+{
+  const auto& current = tree.nodes[node];
+  if (current.child1 == as::k_aabb_tree_null) {
+    CHECK(current.height == 0);
+    return 1;
+  }
+  const auto& child1 = tree.nodes[current.child1];
+  const auto& child2 = tree.nodes[current.child2];
+  CHECK(child1.parent == node);
+  CHECK(child2.parent == node);
+  CHECK(current.height == 1 + std::max(child1.height, child2.height));
+  CHECK(std::abs(child1.height - child2.height) <= 1);
+  CHECK(as::aabb_contains(current.bounds, child1.bounds));
+  CHECK(as::aabb_contains(current.bounds, child2.bounds));
+  return check_tree(tree, current.child1) + check_tree(tree, current.child2);
+}
+
+static std::vector<int32_t> query(const aabb_tree& tree, const aabb& bounds)
+{
+  std::vector<int32_t> found;
+  as::aabb_tree_query(
+    tree, bounds, [&found](const int32_t proxy) { found.push_back(proxy); });
+  std::sort(found.begin(), found.end());
+  return found;
+}
+
+TEST_CASE("aabb_tree_insert", "[as_aabb_tree]")
+{
+  aabb_tree tree;
+  CHECK(query(tree, aabb(vec3(-100.0_r), vec3(100.0_r))).empty());
+
+  std::mt19937 gen(5);
+  std::vector<int32_t> proxies;
+  for (index i = 0; i < 1000; ++i) {
+    proxies.push_back(as::aabb_tree_insert(tree, make_box(gen), int32_t(i)));
+  }
+
+  REQUIRE(tree.root != as::k_aabb_tree_null);
+  CHECK(tree.nodes[tree.root].parent == as::k_aabb_tree_null);
+  CHECK(check_tree(tree, tree.root) == 1000);
+  // height balanced
+  CHECK(tree.nodes[tree.root].height <= 15);
+  CHECK(tree.moved.size() == 1000);
+  for (index i = 0; i < 1000; ++i) {
+    CHECK(tree.nodes[proxies[i]].user_data == i);
+  }
+}
+
+TEST_CASE("aabb_tree_query", "[as_aabb_tree]")
+{
+  aabb_tree tree;
+  std::mt19937 gen(11);
+  std::vector<int32_t> proxies;
+  for (index i = 0; i < 1000; ++i) {
+    proxies.push_back(as::aabb_tree_insert(tree, make_box(gen)));
+  }
+
+  for (index i = 0; i < 50; ++i) {
+    const aabb bounds = make_box(gen);
+    std::vector<int32_t> expected;
+    for (const int32_t proxy : proxies) {
+      if (as::aabb_overlaps(tree.nodes[proxy].bounds, bounds)) {
+        expected.push_back(proxy);
+      }
+    }
+    std::sort(expected.begin(), expected.end());
+    CHECK(query(tree, bounds) == expected);
+  }
+}
+
+TEST_CASE("aabb_tree_remove", "[as_aabb_tree]")
+{
+  aabb_tree tree;
+  std::mt19937 gen(3);
+  std::vector<int32_t> proxies;
+  for (index i = 0; i < 200; ++i) {
+    proxies.push_back(as::aabb_tree_insert(tree, make_box(gen)));
+  }
+
+  // remove every other proxy
+  for (index i = 0; i < 200; i += 2) {
+    as::aabb_tree_remove(tree, proxies[i]);
+  }
+  CHECK(check_tree(tree, tree.root) == 100);
+  CHECK(tree.moved.size() == 100);
+
+  const auto everything = query(tree, aabb(vec3(-100.0_r), vec3(100.0_r)));
+  CHECK(everything.size() == 100);
+  for (index i = 1; i < 200; i += 2) {
+    CHECK(std::binary_search(everything.begin(), everything.end(), proxies[i]));
+  }
+
+  // nodes are reused from the free list
+  const auto node_count = tree.nodes.size();
+  as::aabb_tree_insert(tree, make_box(gen));
+  CHECK(tree.nodes.size() == node_count);
+
+  for (index i = 1; i < 200; i += 2) {
+    as::aabb_tree_remove(tree, proxies[i]);
+  }
+  CHECK(check_tree(tree, tree.root) == 1);
+}
+
+TEST_CASE("aabb_tree_move", "[as_aabb_tree]")
+{
+  aabb_tree tree;
+  tree.margin = 0.5_r;
+  const aabb bounds(vec3(0.0_r), vec3(1.0_r));
+  const int32_t proxy = as::aabb_tree_insert(tree, bounds);
+  as::aabb_tree_insert(tree, aabb(vec3(10.0_r), vec3(11.0_r)));
+  as::aabb_tree_query_pairs(tree, [](int32_t, int32_t) {});
+  CHECK(tree.moved.empty());
+
+  CHECK_THAT(
+    arr(-0.5_r, -0.5_r, -0.5_r),
+    elements_are_array(tree.nodes[proxy].bounds.min));
+
+  // small movements stay within the fattened bounds
+  CHECK(!as::aabb_tree_move(
+    tree, proxy, aabb(vec3(0.25_r), vec3(1.25_r))));
+  CHECK(tree.moved.empty());
+
+  CHECK(as::aabb_tree_move(tree, proxy, aabb(vec3(5.0_r), vec3(6.0_r))));
+  CHECK(tree.moved.size() == 1);
+  CHECK_THAT(
+    arr(4.5_r, 4.5_r, 4.5_r),
+    elements_are_array(tree.nodes[proxy].bounds.min));
+  CHECK(check_tree(tree, tree.root) == 2);
+}
+
+TEST_CASE("aabb_tree_query_pairs", "[as_aabb_tree]")
+{
+  aabb_tree tree;
+  std::mt19937 gen(21);
+  std::vector<int32_t> proxies;
+  std::vector<aabb> boxes;
+  for (index i = 0; i < 500; ++i) {
+    boxes.push_back(make_box(gen));
+    proxies.push_back(as::aabb_tree_insert(tree, boxes.back()));
+  }
+
+  const auto brute_force_pairs = [&](const std::vector<bool>& moved) {
+    std::vector<proxy_pair> pairs;
+    for (index i = 0; i < index(proxies.size()); ++i) {
+      for (index j = i + 1; j < index(proxies.size()); ++j) {
+        if (
+          (moved[i] || moved[j])
+          && as::aabb_overlaps(
+            tree.nodes[proxies[i]].bounds, tree.nodes[proxies[j]].bounds)) {
+          pairs.emplace_back(
+            std::min(proxies[i], proxies[j]), std::max(proxies[i], proxies[j]));
+        }
+      }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+  };
+
+  const auto tree_pairs = [&tree] {
+    std::vector<proxy_pair> pairs;
+    as::aabb_tree_query_pairs(tree, [&pairs](const int32_t a, const int32_t b) {
+      CHECK(a < b);
+      pairs.emplace_back(a, b);
+    });
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+  };
+
+  // everything is new
+  const auto expected_all = brute_force_pairs(std::vector<bool>(500, true));
+  CHECK(!expected_all.empty());
+  CHECK(tree_pairs() == expected_all);
+  CHECK(tree.moved.empty());
+
+  // move a subset
+  std::vector<bool> moved(500, false);
+  for (index i = 0; i < 500; i += 7) {
+    boxes[i] = make_box(gen);
+    moved[i] = as::aabb_tree_move(tree, proxies[i], boxes[i]);
+  }
+  const auto moved_count = std::count(moved.begin(), moved.end(), true);
+  CHECK(tree.moved.size() == size_t(moved_count));
+  CHECK(tree_pairs() == brute_force_pairs(moved));
+
+  // nothing moved
+  CHECK(tree_pairs().empty());
+}
+
+} // namespace unit_test
@@ -0,0 +1,79 @@
+#include "as-helpers.test.hpp"
+#include "as/as-math-ops.hpp"
+#include "catch-matchers.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+namespace unit_test
+{
+
+// testing
+using Catch::Approx;
+
+// types
+using as::aabb;
+using as::real;
+using as::vec3;
+
+// functions
+using as::operator""_r;
+
+[[maybe_unused]] constexpr auto aabb_type_check =
+  unit_test::trivial_standard_layout_check<aabb>();
+
+TEST_CASE("aabb_constructor", "[as_aabb]")
+{
+  const aabb bounds(vec3(-1.0_r, -2.0_r, -3.0_r), vec3(1.0_r, 2.0_r, 3.0_r));
+  CHECK_THAT(arr(-1.0_r, -2.0_r, -3.0_r), elements_are_array(bounds.min));
+  CHECK_THAT(arr(1.0_r, 2.0_r, 3.0_r), elements_are_array(bounds.max));
+  CHECK(aabb::size() == 6);
+}
+
+TEST_CASE("aabb_merge", "[as_aabb]")
+{
+  const aabb lhs(vec3(-1.0_r, 0.0_r, 0.0_r), vec3(1.0_r, 1.0_r, 1.0_r));
+  const aabb rhs(vec3(0.0_r, -2.0_r, 0.5_r), vec3(0.5_r, 0.5_r, 4.0_r));
+
+  const aabb merged = as::aabb_merge(lhs, rhs);
+  CHECK_THAT(arr(-1.0_r, -2.0_r, 0.0_r), elements_are_array(merged.min));
+  CHECK_THAT(arr(1.0_r, 1.0_r, 4.0_r), elements_are_array(merged.max));
+
+  const aabb point_merged =
+    as::aabb_merge(aabb::empty(), vec3(1.0_r, 2.0_r, 3.0_r));
+  CHECK_THAT(arr(1.0_r, 2.0_r, 3.0_r), elements_are_array(point_merged.min));
+  CHECK_THAT(arr(1.0_r, 2.0_r, 3.0_r), elements_are_array(point_merged.max));
+
+  const aabb empty_merged = as::aabb_merge(aabb::empty(), lhs);
+  CHECK_THAT(arr(-1.0_r, 0.0_r, 0.0_r), elements_are_array(empty_merged.min));
+  CHECK_THAT(arr(1.0_r, 1.0_r, 1.0_r), elements_are_array(empty_merged.max));
+}
+
+TEST_CASE("aabb_center_extent_area", "[as_aabb]")
+{
+  const aabb bounds(vec3(-1.0_r, 0.0_r, 2.0_r), vec3(1.0_r, 3.0_r, 6.0_r));
+  CHECK_THAT(
+    arr(0.0_r, 1.5_r, 4.0_r), elements_are_array(as::aabb_center(bounds)));
+  CHECK_THAT(
+    arr(2.0_r, 3.0_r, 4.0_r), elements_are_array(as::aabb_extent(bounds)));
+  CHECK(as::aabb_surface_area(bounds) == Approx(52.0_r));
+}
+
+TEST_CASE("aabb_overlaps_contains", "[as_aabb]")
+{
+  const aabb outer(vec3(0.0_r), vec3(4.0_r));
+  const aabb inner(vec3(1.0_r), vec3(2.0_r));
+  const aabb touching(vec3(4.0_r, 0.0_r, 0.0_r), vec3(5.0_r, 1.0_r, 1.0_r));
+  const aabb separate(vec3(0.0_r, 5.0_r, 0.0_r), vec3(1.0_r, 6.0_r, 1.0_r));
+
+  CHECK(as::aabb_overlaps(outer, inner));
+  CHECK(as::aabb_overlaps(inner, outer));
+  CHECK(as::aabb_overlaps(outer, touching));
+  CHECK(!as::aabb_overlaps(outer, separate));
+  CHECK(!as::aabb_overlaps(inner, touching));
+
+  CHECK(as::aabb_contains(outer, inner));
+  CHECK(as::aabb_contains(outer, outer));
+  CHECK(!as::aabb_contains(inner, outer));
+  CHECK(!as::aabb_contains(outer, touching));
+}
+
+} // namespace unit_test
@@ -0,0 +1,267 @@
+#include "as-helpers.test.hpp"
+#include "as/as-anim.hpp"
+#include "catch-matchers.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <vector>
+
+namespace unit_test
+{
+
+// testing
+using Catch::Approx;
+
+// types
+using as::index;
+using as::quat;
+using as::real;
+using as::vec3;
+
+// functions
+using as::operator""_r;
+
+// the angle between two rotations
+static real rotation_angle(const quat& lhs, const quat& rhs)
+{
+  const quat difference = as::quat_conjugate(lhs) * rhs;
+  return 2.0_r
+       * std::atan2(
+           std::sqrt(
+             difference.x * difference.x + difference.y * difference.y
+             + difference.z * difference.z),
+           std::abs(difference.w));
+}
+
+// the sampled pose of every joint stored as arrays
+struct anim_pose
+{
+  explicit anim_pose(const index joint_count)
+    : rotation_w(joint_count), rotation_x(joint_count),
+      rotation_y(joint_count), rotation_z(joint_count),
+      translation_x(joint_count), translation_y(joint_count),
+      translation_z(joint_count), scale_x(joint_count), scale_y(joint_count),
+      scale_z(joint_count)
+  {
+  }
+
+  std::vector<real> rotation_w, rotation_x, rotation_y, rotation_z;
+  std::vector<real> translation_x, translation_y, translation_z;
+  std::vector<real> scale_x, scale_y, scale_z;
+
+  as::rigid_soa_t<real> pose()
+  {
+    return {rotation_w.data(),    rotation_x.data(),    rotation_y.data(),
+            rotation_z.data(),    translation_x.data(), translation_y.data(),
+            translation_z.data()};
+  }
+
+  as::vec3_soa_t<real> scale()
+  {
+    return {scale_x.data(), scale_y.data(), scale_z.data()};
+  }
+
+  quat rotation(const index j) const
+  {
+    return quat(rotation_w[j], rotation_x[j], rotation_y[j], rotation_z[j]);
+  }
+
+  vec3 translation(const index j) const
+  {
+    return vec3(translation_x[j], translation_y[j], translation_z[j]);
+  }
+
+  vec3 scaling(const index j) const
+  {
+    return vec3(scale_x[j], scale_y[j], scale_z[j]);
+  }
+};
+
+// samples of a clip with slow and fast moving joints, fixed offsets and a
+// scaled joint
+struct anim_source
+{
+  static constexpr index joint_count = 24;
+  static constexpr index frame_count = 121;
+  static constexpr real frame_rate = 30.0_r;
+
+  anim_source()
+  {
+    for (index f = 0; f < frame_count; ++f) {
+      const real time = real(f) / frame_rate;
+      for (index j = 0; j < joint_count; ++j) {
+        const real speed = 1.0_r + real(j % 4) * 0.5_r;
+        const real phase = real(j) * 0.7_r;
+        rotations.push_back(as::quat_rotation_xyz(
+          0.5_r * std::sin(time * speed + phase),
+          0.3_r * std::cos(time * speed * 0.5_r + phase),
+          real(j % 3) * 0.2_r));
+        // bones have a fixed length except the root which moves
+        translations.push_back(
+          j == 0 ? vec3(std::sin(time) * 2.0_r, 1.0_r, time * 0.5_r)
+                 : vec3(0.0_r, real(j) * 0.1_r, 0.0_r));
+        scales.push_back(
+          j == 5 ? vec3(1.0_r + 0.2_r * std::sin(time), 1.0_r, 1.0_r)
+                 : vec3::one());
+      }
+    }
+  }
+
+  as::anim_clip build() const
+  {
+    return as::anim_clip_build(
+      rotations.data(), translations.data(), scales.data(), joint_count,
+      frame_count, frame_rate, rotation_tolerance, translation_tolerance,
+      scale_tolerance);
+  }
+
+  quat rotation(const index f, const index j) const
+  {
+    return rotations[f * joint_count + j];
+  }
+
+  vec3 translation(const index f, const index j) const
+  {
+    return translations[f * joint_count + j];
+  }
+
+  vec3 scale(const index f, const index j) const
+  {
+    return scales[f * joint_count + j];
+  }
+
+  static constexpr real rotation_tolerance = 0.01_r;
+  static constexpr real translation_tolerance = 0.001_r;
+  static constexpr real scale_tolerance = 0.001_r;
+
+  std::vector<quat> rotations;
+  std::vector<vec3> translations;
+  std::vector<vec3> scales;
+};
+
+TEST_CASE("anim_clip_build", "[as_anim]")
+{
+  const anim_source source;
+  const as::anim_clip clip = source.build();
+
+  CHECK(clip.joint_count == anim_source::joint_count);
+  CHECK(clip.frame_count == anim_source::frame_count);
+  CHECK(as::anim_clip_duration(clip) == Approx(4.0_r));
+
+  // every track keeps at least its first and last frame, constant tracks
+  // keep nothing else
+  CHECK(clip.scales.frames.size() > 2 * anim_source::joint_count);
+  CHECK(clip.translations.frames.size() > 2 * anim_source::joint_count);
+  CHECK(clip.translation_extent[3] == vec3::zero());
+  CHECK(as::vec_near(clip.translation_min[3], vec3(0.0_r, 0.3_r, 0.0_r)));
+
+  // keys are sorted by the frame of the key before them in their track
+  std::vector<index> last_frame;
+  for (index j = 0; j < anim_source::joint_count; ++j) {
+    last_frame.push_back(clip.rotations.frames[j * 2 + 1]);
+  }
+  index previous = 0;
+  for (size_t k = 2 * anim_source::joint_count;
+       k < clip.rotations.frames.size(); ++k) {
+    const index track = clip.rotations.tracks[k];
+    CHECK(last_frame[track] >= previous);
+    previous = last_frame[track];
+    last_frame[track] = clip.rotations.frames[k];
+  }
+
+  // at least four times smaller than storing every sample of a float pose
+  const auto raw_size_bytes = index(
+    anim_source::joint_count * anim_source::frame_count * sizeof(float) * 10);
+  CHECK(as::anim_clip_size_bytes(clip) * 4 < raw_size_bytes);
+}
+
+TEST_CASE("anim_clip_sample", "[as_anim]")
+{
+  const anim_source source;
+  const as::anim_clip clip = source.build();
+  const index joint_count = anim_source::joint_count;
+
+  as::anim_sampler sampler;
+  anim_pose sampled(joint_count);
+
+  // samples match the source within the tolerance (and quantization error)
+  for (index f = 0; f < anim_source::frame_count; ++f) {
+    as::anim_clip_sample(
+      clip, sampler, real(f) / anim_source::frame_rate, sampled.pose(),
+      sampled.scale());
+    for (index j = 0; j < joint_count; ++j) {
+      CHECK(
+        rotation_angle(sampled.rotation(j), source.rotation(f, j))
+        < anim_source::rotation_tolerance + 0.0002_r);
+      CHECK(
+        as::vec_distance(sampled.translation(j), source.translation(f, j))
+        < anim_source::translation_tolerance + 0.0002_r);
+      CHECK(
+        as::vec_max_elem(
+          as::vec_abs(sampled.scaling(j) - source.scale(f, j)))
+        < anim_source::scale_tolerance + 0.0001_r);
+    }
+  }
+
+  // between frames the pose is interpolated
+  as::anim_sampler between;
+  for (index f = 0; f < anim_source::frame_count - 1; f += 7) {
+    as::anim_clip_sample(
+      clip, between, (real(f) + 0.5_r) / anim_source::frame_rate,
+      sampled.pose(), sampled.scale());
+    for (index j = 0; j < joint_count; ++j) {
+      const quat expected = as::quat_nlerp(
+        source.rotation(f, j), source.rotation(f + 1, j), 0.5_r);
+      CHECK(
+        rotation_angle(sampled.rotation(j), expected)
+        < anim_source::rotation_tolerance * 2.0_r);
+    }
+  }
+
+  // sampling backward in time gives the same pose as a new sampler
+  anim_pose backward(joint_count);
+  as::anim_clip_sample(
+    clip, sampler, 1.234_r, backward.pose(), backward.scale());
+  as::anim_sampler fresh;
+  as::anim_clip_sample(clip, fresh, 1.234_r, sampled.pose(), sampled.scale());
+  CHECK(backward.rotation_x == sampled.rotation_x);
+  CHECK(backward.translation_z == sampled.translation_z);
+  CHECK(backward.scale_x == sampled.scale_x);
+
+  // time is clamped to the length of the clip
+  as::anim_clip_sample(clip, fresh, 100.0_r, sampled.pose(), sampled.scale());
+  as::anim_clip_sample(
+    clip, sampler, as::anim_clip_duration(clip), backward.pose(),
+    backward.scale());
+  CHECK(backward.rotation_w == sampled.rotation_w);
+  CHECK(backward.translation_x == sampled.translation_x);
+  as::anim_clip_sample(clip, fresh, -1.0_r, sampled.pose(), sampled.scale());
+  CHECK(
+    rotation_angle(sampled.rotation(1), source.rotation(0, 1))
+    < anim_source::rotation_tolerance);
+}
+
+TEST_CASE("anim_clip_sample_single_frame", "[as_anim]")
+{
+  const quat rotations[] = {
+    as::quat_rotation_axis(vec3::axis_y(), 0.5_r), quat::identity()};
+  const vec3 translations[] = {vec3(1.0_r, 2.0_r, 3.0_r), vec3::zero()};
+  const vec3 scales[] = {vec3::one(), vec3(2.0_r)};
+  const as::anim_clip clip = as::anim_clip_build(
+    rotations, translations, scales, 2, 1, 30.0_r, 0.01_r, 0.001_r, 0.001_r);
+  CHECK(as::anim_clip_duration(clip) == Approx(0.0_r));
+
+  // scale is not written when the output is null
+  anim_pose sampled(2);
+  as::anim_sampler sampler;
+  as::anim_clip_sample(
+    clip, sampler, 0.5_r, sampled.pose(),
+    as::vec3_soa_t<real>{nullptr, nullptr, nullptr});
+  CHECK(rotation_angle(sampled.rotation(0), rotations[0]) < 0.0002_r);
+  CHECK(as::vec_near(sampled.translation(0), translations[0]));
+  CHECK(sampled.scale_x[1] == 0.0_r);
+
+  as::anim_clip_sample(clip, sampler, 0.5_r, sampled.pose(), sampled.scale());
+  CHECK(as::vec_near(sampled.scaling(1), vec3(2.0_r)));
+}
+
+} // namespace unit_test
@@ -0,0 +1,251 @@
+#include "as-helpers.test.hpp"
+#include "as/as-bvh.hpp"
+#include "catch-matchers.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace unit_test
+{
+
+// types
+using as::aabb;
+using as::bvh;
+using as::index;
+using as::real;
+using as::vec3;
+
+// functions
+using as::operator""_r;
+
+static std::vector<aabb> make_boxes(const index count)
+{
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<real> position(-100.0_r, 100.0_r);
+  std::uniform_real_distribution<real> size(0.1_r, 2.0_r);
+  std::vector<aabb> boxes(count);
+  for (auto& box : boxes) {
+    const vec3 min(position(gen), position(gen), position(gen));
+    box = aabb(min, min + vec3(size(gen), size(gen), size(gen)));
+  }
+  return boxes;
+}
+
+// brute force ray/box test returning the entry distance (or max_distance)
+static real ray_box(
+  const aabb& box, const vec3& origin, const vec3& inv_direction,
+  const real max_distance)
+{
+  const vec3 t0 = (box.min - origin) * inv_direction;
+  const vec3 t1 = (box.max - origin) * inv_direction;
+  const vec3 t_near = as::vec_min(t0, t1);
+  const vec3 t_far = as::vec_max(t0, t1);
+  const real entry = std::max({t_near.x, t_near.y, t_near.z, 0.0_r});
+  const real exit = std::min({t_far.x, t_far.y, t_far.z, max_distance});
+  return entry <= exit ? entry : max_distance;
+}
+
+static void check_node(
+  const bvh& hierarchy, const std::vector<aabb>& boxes, const int32_t node,
+  const index depth, index& primitive_count)
+{
+  REQUIRE(depth < as::k_bvh_stack_size);
+  const auto& current = hierarchy.nodes[node];
+  if (current.count > 0) {
+    for (int32_t i = current.offset; i < current.offset + current.count; ++i) {
+      CHECK(as::aabb_contains(current.bounds, boxes[hierarchy.primitives[i]]));
+    }
+    primitive_count += current.count;
+    return;
+  }
+  const int32_t first = node + 1;
+  const int32_t second = current.offset;
+  CHECK(second > first);
+  CHECK(as::aabb_contains(current.bounds, hierarchy.nodes[first].bounds));
+  CHECK(as::aabb_contains(current.bounds, hierarchy.nodes[second].bounds));
+  check_node(hierarchy, boxes, first, depth + 1, primitive_count);
+  check_node(hierarchy, boxes, second, depth + 1, primitive_count);
+}
+
+TEST_CASE("bvh_build_empty", "[as_bvh]")
+{
+  const bvh hierarchy = as::bvh_build<real>(nullptr, 0);
+  CHECK(hierarchy.nodes.empty());
+  CHECK(hierarchy.primitives.empty());
+
+  bool visited = false;
+  as::bvh_query_aabb(
+    hierarchy, aabb(vec3::zero(), vec3::one()),
+    [&visited](int32_t) { visited = true; });
+  CHECK(!visited);
+}
+
+TEST_CASE("bvh_build_single", "[as_bvh]")
+{
+  const aabb box(vec3::zero(), vec3::one());
+  const bvh hierarchy = as::bvh_build(&box, 1);
+  REQUIRE(hierarchy.nodes.size() == 1);
+  CHECK(hierarchy.nodes[0].count == 1);
+  CHECK(hierarchy.primitives[0] == 0);
+}
+
+TEST_CASE("bvh_build", "[as_bvh]")
+{
+  // large enough to be split into several subtrees
+  const index count = as::k_bvh_subtree_size * 3 + 17;
+  const std::vector<aabb> boxes = make_boxes(count);
+
+  const bvh hierarchy = as::bvh_build(boxes.data(), count, 4);
+
+  std::vector<int32_t> primitives = hierarchy.primitives;
+  std::sort(primitives.begin(), primitives.end());
+  bool permutation = true;
+  for (index i = 0; i < count; ++i) {
+    permutation = permutation && primitives[i] == i;
+  }
+  CHECK(permutation);
+
+  for (const auto& node : hierarchy.nodes) {
+    CHECK(node.count <= 4);
+  }
+
+  index primitive_count = 0;
+  check_node(hierarchy, boxes, 0, 0, primitive_count);
+  CHECK(primitive_count == count);
+
+  const bvh reversed =
+    as::bvh_build(boxes.data(), count, 4, reverse_executor{});
+  REQUIRE(reversed.nodes.size() == hierarchy.nodes.size());
+  CHECK(reversed.primitives == hierarchy.primitives);
+  bool identical = true;
+  for (index i = 0; i < index(hierarchy.nodes.size()); ++i) {
+    identical = identical
+             && reversed.nodes[i].offset == hierarchy.nodes[i].offset
+             && reversed.nodes[i].count == hierarchy.nodes[i].count;
+  }
+  CHECK(identical);
+}
+
+TEST_CASE("bvh_build_identical", "[as_bvh]")
+{
+  // identical centroids produce identical Morton codes
+  const index count = 1000;
+  const std::vector<aabb> boxes(count, aabb(vec3::zero(), vec3::one()));
+  const bvh hierarchy = as::bvh_build(boxes.data(), count, 1);
+  CHECK(hierarchy.nodes.size() == count * 2 - 1);
+  index primitive_count = 0;
+  check_node(hierarchy, boxes, 0, 0, primitive_count);
+  CHECK(primitive_count == count);
+}
+
+TEST_CASE("bvh_build_planar", "[as_bvh]")
+{
+  // centroids with no extent along y are still sorted along x and z
+  std::vector<aabb> boxes = make_boxes(500);
+  for (auto& box : boxes) {
+    box.min.y = -1.0_r;
+    box.max.y = 1.0_r;
+  }
+  const index count = index(boxes.size());
+  const bvh hierarchy = as::bvh_build(boxes.data(), count, 4);
+  index primitive_count = 0;
+  check_node(hierarchy, boxes, 0, 0, primitive_count);
+  CHECK(primitive_count == count);
+  // the two children of the root divide the boxes spatially
+  const real area = as::aabb_surface_area(hierarchy.nodes[0].bounds);
+  const aabb& first = hierarchy.nodes[1].bounds;
+  const aabb& second = hierarchy.nodes[hierarchy.nodes[0].offset].bounds;
+  CHECK(as::aabb_surface_area(first) < area * 0.75_r);
+  CHECK(as::aabb_surface_area(second) < area * 0.75_r);
+}
+
+TEST_CASE("bvh_query_aabb", "[as_bvh]")
+{
+  const index count = 5000;
+  const std::vector<aabb> boxes = make_boxes(count);
+  const bvh hierarchy = as::bvh_build(boxes.data(), count);
+
+  std::mt19937 gen(99);
+  std::uniform_real_distribution<real> position(-100.0_r, 100.0_r);
+  for (index query = 0; query < 50; ++query) {
+    const vec3 min(position(gen), position(gen), position(gen));
+    const aabb bounds(min, min + vec3(10.0_r));
+
+    std::vector<int32_t> expected;
+    for (index i = 0; i < count; ++i) {
+      if (as::aabb_overlaps(boxes[i], bounds)) {
+        expected.push_back(int32_t(i));
+      }
+    }
+
+    std::vector<int32_t> found;
+    as::bvh_query_aabb(hierarchy, bounds, [&](const int32_t primitive) {
+      if (as::aabb_overlaps(boxes[primitive], bounds)) {
+        found.push_back(primitive);
+      }
+    });
+    std::sort(found.begin(), found.end());
+
+    CHECK(found == expected);
+  }
+}
+
+TEST_CASE("bvh_intersect_ray", "[as_bvh]")
+{
+  const index count = 5000;
+  const std::vector<aabb> boxes = make_boxes(count);
+  const bvh hierarchy = as::bvh_build(boxes.data(), count);
+
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<real> position(-120.0_r, 120.0_r);
+  for (index ray = 0; ray < 200; ++ray) {
+    const vec3 origin(position(gen), position(gen), position(gen));
+    const vec3 target(position(gen) * 0.5_r, position(gen) * 0.5_r, 0.0_r);
+    const vec3 direction = as::vec_normalize(target - origin);
+    const vec3 inv_direction = vec3::one() / direction;
+    const real max_distance = 500.0_r;
+
+    real expected = max_distance;
+    int32_t expected_primitive = -1;
+    for (index i = 0; i < count; ++i) {
+      const real hit = ray_box(boxes[i], origin, inv_direction, expected);
+      if (hit < expected) {
+        expected = hit;
+        expected_primitive = int32_t(i);
+      }
+    }
+
+    int32_t closest_primitive = -1;
+    as::bvh_intersect_ray(
+      hierarchy, origin, inv_direction, max_distance,
+      [&](const int32_t primitive, const real distance) {
+        const real hit =
+          ray_box(boxes[primitive], origin, inv_direction, distance);
+        if (hit < distance) {
+          closest_primitive = primitive;
+        }
+        return hit;
+      });
+
+    CHECK(closest_primitive == expected_primitive);
+
+    int32_t ray_closest_primitive = -1;
+    as::bvh_intersect_ray(
+      hierarchy, as::ray(origin, direction), max_distance,
+      [&](const int32_t primitive, const real distance) {
+        const auto [hit, entry] = as::ray_intersect_aabb(
+          as::ray(origin, direction), boxes[primitive], distance);
+        if (hit && entry < distance) {
+          ray_closest_primitive = primitive;
+          return entry;
+        }
+        return distance;
+      });
+
+    CHECK(ray_closest_primitive == expected_primitive);
+  }
+}
+
+} // namespace unit_test
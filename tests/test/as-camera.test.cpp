@@ -0,0 +1,199 @@
+#include "as-helpers.test.hpp"
+#include "as/as-camera.hpp"
+#include "catch-matchers.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <vector>
+
+namespace unit_test
+{
+
+// testing
+using Catch::Approx;
+
+// types
+using as::affine;
+using as::index;
+using as::mat4;
+using as::real;
+using as::vec2;
+using as::vec2i;
+using as::vec3;
+
+// functions
+using as::radians;
+using as::operator""_r;
+
+static bool matrices_equal(const mat4& lhs, const mat4& rhs)
+{
+  for (index i = 0; i < mat4::size(); ++i) {
+    if (lhs[i] != rhs[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool frustums_equal(const as::frustum& lhs, const as::frustum& rhs)
+{
+  for (index i = 0; i < as::frustum::size(); ++i) {
+    for (index j = 0; j < 4; ++j) {
+      if (lhs.planes[i][j] != rhs.planes[i][j]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+TEST_CASE("camera_default", "[as_camera]")
+{
+  const as::camera camera;
+  CHECK(matrices_equal(camera.projection(), mat4::identity()));
+  CHECK(matrices_equal(camera.view_projection(), mat4::identity()));
+  CHECK(matrices_equal(camera.inverse_view_projection(), mat4::identity()));
+}
+
+TEST_CASE("camera_matches_free_functions", "[as_camera]")
+{
+  const mat4 projection =
+    as::perspective_vulkan_rh(radians(60.0_r), 16.0_r / 9.0_r, 0.1_r, 100.0_r);
+  const affine view = as::affine_inverse(
+    affine(as::mat3_rotation_y(radians(20.0_r)), vec3(1.0_r, 2.0_r, 8.0_r)));
+  const vec2i screen_dimension = vec2i(640, 360);
+  const vec2 depth_range = vec2(0.0_r, 1.0_r);
+
+  const as::camera camera(projection, view, screen_dimension, depth_range);
+
+  const mat4 view_projection = as::view_projection(view, projection);
+  const mat4 inverse_view_projection =
+    as::inverse_view_projection(view, projection);
+  CHECK(matrices_equal(camera.view_projection(), view_projection));
+  CHECK(
+    matrices_equal(camera.inverse_view_projection(), inverse_view_projection));
+  CHECK(frustums_equal(
+    camera.view_frustum(),
+    as::frustum_from_mat4(view_projection, depth_range)));
+
+  const vec3 world_position = vec3(-3.0_r, 1.0_r, -4.0_r);
+  const vec2i screen_position =
+    as::world_to_screen(world_position, projection, view, screen_dimension);
+  CHECK(camera.world_to_screen(world_position) == screen_position);
+
+  const vec3 expected_world_position = as::screen_to_world(
+    vec2i(100, 200), projection, view, screen_dimension, depth_range);
+  const vec3 returned_world_position = camera.screen_to_world(vec2i(100, 200));
+  CHECK(returned_world_position.x == expected_world_position.x);
+  CHECK(returned_world_position.y == expected_world_position.y);
+  CHECK(returned_world_position.z == expected_world_position.z);
+}
+
+TEST_CASE("camera_screen_to_world_reverse_z", "[as_camera]")
+{
+  const mat4 projection = as::perspective_direct3d_rh(
+    radians(60.0_r), 16.0_r / 9.0_r, 0.1_r, 100.0_r);
+  const vec2i screen_dimension = vec2i(640, 360);
+
+  const as::camera camera(
+    projection, affine::identity(), screen_dimension, vec2(0.0_r, 1.0_r));
+  const as::camera reversed_camera(
+    as::reverse_z(projection), affine::identity(), screen_dimension,
+    vec2(1.0_r, 0.0_r));
+
+  // both return the position on the near clip plane
+  const vec3 world_position = camera.screen_to_world(vec2i(100, 50));
+  const vec3 reversed_world_position =
+    reversed_camera.screen_to_world(vec2i(100, 50));
+  CHECK(world_position.z == Approx(-0.1_r).epsilon(1e-5_r));
+  CHECK(as::vec_near(reversed_world_position, world_position, 1e-5_r));
+
+  // and match the free function exactly
+  const vec3 expected_world_position = as::screen_to_world(
+    vec2i(100, 50), as::reverse_z(projection), affine::identity(),
+    screen_dimension, vec2(1.0_r, 0.0_r));
+  CHECK(reversed_world_position.x == expected_world_position.x);
+  CHECK(reversed_world_position.y == expected_world_position.y);
+  CHECK(reversed_world_position.z == expected_world_position.z);
+}
+
+TEST_CASE("camera_rays_from_deltas", "[as_camera]")
+{
+  const mat4 projection =
+    as::perspective_opengl_rh(radians(90.0_r), 4.0_r / 3.0_r, 0.1_r, 100.0_r);
+  const affine view = as::affine_inverse(
+    affine(as::mat3_rotation_x(radians(-10.0_r)), vec3(0.0_r, 3.0_r, 5.0_r)));
+  const vec2i screen_dimension = vec2i(40, 30);
+  const vec2 depth_range = vec2(-1.0_r, 1.0_r);
+  const as::camera camera(projection, view, screen_dimension, depth_range);
+
+  const index count = index(screen_dimension.x) * screen_dimension.y;
+  std::vector<real> expected(count * 6);
+  std::vector<real> returned(count * 6);
+  const auto rays = [count](std::vector<real>& r, const index i) {
+    return r.data() + count * i;
+  };
+
+  as::camera_rays(
+    camera.inverse_view_projection(), screen_dimension, depth_range,
+    rays(expected, 0), rays(expected, 1), rays(expected, 2),
+    rays(expected, 3), rays(expected, 4), rays(expected, 5));
+  as::camera_rays(
+    camera.ray_deltas(), camera.screen_dimension(), rays(returned, 0),
+    rays(returned, 1), rays(returned, 2), rays(returned, 3),
+    rays(returned, 4), rays(returned, 5));
+
+  CHECK(expected == returned);
+}
+
+TEST_CASE("camera_invalidation", "[as_camera]")
+{
+  const mat4 projection =
+    as::perspective_direct3d_lh(radians(60.0_r), 1.0_r, 0.1_r, 100.0_r);
+  const vec2 depth_range = vec2(0.0_r, 1.0_r);
+  as::camera camera(
+    projection, affine::identity(), vec2i(100, 100), depth_range);
+
+  const mat4 view_projection = camera.view_projection();
+  const as::pixel_ray_deltas deltas = camera.ray_deltas();
+
+  SECTION("screen dimension only changes the pixel ray deltas")
+  {
+    camera.set_screen_dimension(vec2i(200, 100));
+    CHECK(matrices_equal(camera.view_projection(), view_projection));
+    CHECK(camera.ray_deltas().delta_x.x != deltas.delta_x.x);
+    const as::pixel_ray_deltas expected = as::pixel_ray_deltas_from_mat4(
+      camera.inverse_view_projection(), vec2i(200, 100), depth_range);
+    CHECK(camera.ray_deltas().delta_x.x == expected.delta_x.x);
+    CHECK(camera.ray_deltas().delta_y.y == expected.delta_y.y);
+  }
+
+  SECTION("view changes every derived value")
+  {
+    const affine view = affine(vec3(0.0_r, 0.0_r, -5.0_r));
+    camera.set_view(view);
+    CHECK(matrices_equal(
+      camera.view_projection(), as::view_projection(view, projection)));
+    CHECK(matrices_equal(
+      camera.inverse_view_projection(),
+      as::inverse_view_projection(view, projection)));
+    CHECK(frustums_equal(
+      camera.view_frustum(),
+      as::frustum_from_mat4(camera.view_projection(), depth_range)));
+    CHECK(camera.ray_deltas().near_position.z != deltas.near_position.z);
+  }
+
+  SECTION("projection changes every derived value")
+  {
+    const mat4 reversed = as::reverse_z(projection);
+    camera.set_projection(reversed, vec2(1.0_r, 0.0_r));
+    CHECK(camera.depth_range().x == 1.0_r);
+    CHECK(matrices_equal(
+      camera.view_projection(),
+      as::view_projection(affine::identity(), reversed)));
+    CHECK(frustums_equal(
+      camera.view_frustum(),
+      as::frustum_from_mat4(camera.view_projection(), vec2(1.0_r, 0.0_r))));
+  }
+}
+
+} // namespace unit_test
@@ -0,0 +1,241 @@
+#include "as-helpers.test.hpp"
+#include "as/as-clip.hpp"
+#include "as/as-view.hpp"
+#include "catch-matchers.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <vector>
+
+namespace unit_test
+{
+
+// testing
+using Catch::Approx;
+
+// types
+using as::index;
+using as::mat4;
+using as::real;
+using as::vec2;
+using as::vec3;
+using as::vec4;
+
+// functions
+using as::radians;
+using as::operator""_r;
+
+// returns if the clip space position is inside every plane (allowing for
+// rounding error)
+static bool clip_inside(
+  const vec4& clip, const vec2& depth_range, const vec2& guard_band)
+{
+  const real e = 1e-4_r * std::abs(clip.w);
+  const real lo = std::min(depth_range.x, depth_range.y);
+  const real hi = std::max(depth_range.x, depth_range.y);
+  return clip.x >= -guard_band.x * clip.w - e
+      && clip.x <= guard_band.x * clip.w + e
+      && clip.y >= -guard_band.y * clip.w - e
+      && clip.y <= guard_band.y * clip.w + e && clip.z >= lo * clip.w - e
+      && clip.z <= hi * clip.w + e;
+}
+
+TEST_CASE("clip_outcode", "[as_clip]")
+{
+  const vec2 opengl = vec2(-1.0_r, 1.0_r);
+  const vec2 direct3d = vec2(0.0_r, 1.0_r);
+  const vec2 reversed = vec2(1.0_r, 0.0_r);
+
+  CHECK(as::clip_outcode(vec4(0.0_r, 0.0_r, 0.5_r, 1.0_r), opengl) == 0);
+  CHECK(as::clip_outcode(vec4(0.0_r, 0.0_r, 0.5_r, 1.0_r), direct3d) == 0);
+  CHECK(as::clip_outcode(vec4(0.0_r, 0.0_r, 0.5_r, 1.0_r), reversed) == 0);
+
+  CHECK(
+    as::clip_outcode(vec4(-2.0_r, 0.0_r, 0.5_r, 1.0_r), direct3d)
+    == as::clip_left);
+  CHECK(
+    as::clip_outcode(vec4(2.0_r, 3.0_r, 0.5_r, 1.0_r), direct3d)
+    == (as::clip_right | as::clip_top));
+  CHECK(
+    as::clip_outcode(vec4(0.0_r, -2.0_r, 0.5_r, 1.0_r), direct3d)
+    == as::clip_bottom);
+
+  // depth between -1 and 0 is only inside for OpenGL
+  const vec4 shallow = vec4(0.0_r, 0.0_r, -0.5_r, 1.0_r);
+  CHECK(as::clip_outcode(shallow, opengl) == 0);
+  CHECK(as::clip_outcode(shallow, direct3d) == as::clip_near);
+  // with reversed depth the near plane is at 1 and the far plane at 0
+  CHECK(as::clip_outcode(shallow, reversed) == as::clip_far);
+  CHECK(
+    as::clip_outcode(vec4(0.0_r, 0.0_r, 1.5_r, 1.0_r), reversed)
+    == as::clip_near);
+  CHECK(
+    as::clip_outcode(vec4(0.0_r, 0.0_r, 1.5_r, 1.0_r), direct3d)
+    == as::clip_far);
+
+  // the guard band moves the side planes out
+  CHECK(
+    as::clip_outcode(
+      vec4(-2.0_r, 1.5_r, 0.5_r, 1.0_r), direct3d, vec2(3.0_r, 2.0_r))
+    == 0);
+  CHECK(
+    as::clip_outcode(
+      vec4(-2.0_r, 2.5_r, 0.5_r, 1.0_r), direct3d, vec2(3.0_r, 2.0_r))
+    == as::clip_top);
+}
+
+TEST_CASE("clip_polygon", "[as_clip]")
+{
+  const vec2 depth_range = vec2(0.0_r, 1.0_r);
+  const vec2 guard_band = vec2::one();
+  vec4 clipped[3 + as::k_clip_plane_count];
+  vec4 scratch[3 + as::k_clip_plane_count];
+
+  SECTION("inside")
+  {
+    const vec4 triangle[] = {
+      vec4(-0.5_r, -0.5_r, 0.5_r, 1.0_r), vec4(0.5_r, -0.5_r, 0.5_r, 1.0_r),
+      vec4(0.0_r, 0.5_r, 0.5_r, 1.0_r)};
+    REQUIRE(
+      as::clip_polygon(
+        triangle, 3, depth_range, guard_band, clipped, scratch)
+      == 3);
+    CHECK(clipped[0] == triangle[0]);
+    CHECK(clipped[1] == triangle[1]);
+    CHECK(clipped[2] == triangle[2]);
+  }
+
+  SECTION("one plane")
+  {
+    // the last vertex is beyond the right plane
+    const vec4 triangle[] = {
+      vec4(-0.5_r, -0.5_r, 0.5_r, 1.0_r), vec4(0.5_r, -0.5_r, 0.5_r, 1.0_r),
+      vec4(2.0_r, 0.5_r, 0.5_r, 1.0_r)};
+    const index count = as::clip_polygon(
+      triangle, 3, depth_range, guard_band, clipped, scratch);
+    REQUIRE(count == 4);
+    index on_plane = 0;
+    for (index i = 0; i < count; ++i) {
+      CHECK(clip_inside(clipped[i], depth_range, guard_band));
+      on_plane += clipped[i].x == Approx(clipped[i].w);
+    }
+    CHECK(on_plane == 2);
+  }
+
+  SECTION("every plane")
+  {
+    // a large triangle around the view volume (crossing every plane)
+    const vec4 triangle[] = {
+      vec4(-10.0_r, -10.0_r, -1.0_r, 1.0_r),
+      vec4(10.0_r, -10.0_r, 0.5_r, 1.0_r), vec4(0.0_r, 10.0_r, 2.0_r, 1.0_r)};
+    const index count = as::clip_polygon(
+      triangle, 3, depth_range, guard_band, clipped, scratch);
+    CHECK(count >= 3);
+    CHECK(count <= 3 + as::k_clip_plane_count);
+    for (index i = 0; i < count; ++i) {
+      CHECK(clip_inside(clipped[i], depth_range, guard_band));
+    }
+  }
+
+  SECTION("outside")
+  {
+    // behind the camera
+    const vec4 triangle[] = {
+      vec4(-0.5_r, -0.5_r, 0.5_r, -1.0_r),
+      vec4(0.5_r, -0.5_r, 0.5_r, -1.0_r), vec4(0.0_r, 0.5_r, 0.5_r, -1.0_r)};
+    CHECK(
+      as::clip_polygon(
+        triangle, 3, depth_range, guard_band, clipped, scratch)
+      == 0);
+  }
+
+  SECTION("shared edge")
+  {
+    // two triangles sharing an edge crossing the near plane (in opposite
+    // directions) are clipped to the same positions
+    const vec4 a = vec4(-0.5_r, -0.25_r, -0.5_r, 0.5_r);
+    const vec4 b = vec4(0.25_r, 0.5_r, 0.75_r, 1.0_r);
+    const vec4 first[] = {a, b, vec4(0.5_r, -0.5_r, 0.5_r, 1.0_r)};
+    const vec4 second[] = {b, a, vec4(-0.5_r, 0.5_r, 0.5_r, 1.0_r)};
+    vec4 clipped_second[3 + as::k_clip_plane_count];
+    const index first_count = as::clip_polygon(
+      first, 3, depth_range, guard_band, clipped, scratch);
+    const index second_count = as::clip_polygon(
+      second, 3, depth_range, guard_band, clipped_second, scratch);
+    // the vertex on the near plane between a and b
+    index shared = 0;
+    for (index i = 0; i < first_count; ++i) {
+      if (clipped[i] == a || clipped[i] == b || clipped[i] == first[2]) {
+        continue;
+      }
+      for (index j = 0; j < second_count; ++j) {
+        shared += clipped[i] == clipped_second[j];
+      }
+    }
+    CHECK(shared == 1);
+  }
+}
+
+TEST_CASE("clip_triangles", "[as_clip]")
+{
+  const real fov = radians(60.0_r);
+  struct convention
+  {
+    mat4 projection;
+    vec2 depth_range;
+  };
+  const convention conventions[] = {
+    {as::perspective_opengl_rh(fov, 1.0_r, 0.5_r, 100.0_r),
+     vec2(-1.0_r, 1.0_r)},
+    {as::perspective_vulkan_rh(fov, 1.0_r, 0.5_r, 100.0_r),
+     vec2(0.0_r, 1.0_r)},
+    {as::reverse_z(as::perspective_direct3d_rh(fov, 1.0_r, 0.5_r, 100.0_r)),
+     vec2(1.0_r, 0.0_r)}};
+
+  // view space triangles (looking down -z)
+  const vec3 triangles[] = {
+    // in front of the camera
+    vec3(-1.0_r, -1.0_r, -10.0_r), vec3(1.0_r, -1.0_r, -10.0_r),
+    vec3(0.0_r, 1.0_r, -10.0_r),
+    // behind the camera
+    vec3(-1.0_r, -1.0_r, 10.0_r), vec3(1.0_r, -1.0_r, 10.0_r),
+    vec3(0.0_r, 1.0_r, 10.0_r),
+    // extending behind the camera (only crossing the near plane)
+    vec3(-0.1_r, 0.0_r, -10.0_r), vec3(0.1_r, 0.0_r, -10.0_r),
+    vec3(0.0_r, 0.0_r, 10.0_r)};
+  const index triangle_count = 3;
+
+  for (const convention& c : conventions) {
+    std::vector<vec4> clip;
+    for (const vec3& position : triangles) {
+      clip.push_back(
+        as::mat_mul(as::vec4_from_vec3(position, 1.0_r), c.projection));
+    }
+    const index capacity = triangle_count * as::k_clip_max_triangle_count;
+    std::vector<vec4> clipped(capacity * 3);
+    std::vector<uint32_t> sources(capacity);
+    const index clipped_count = as::clip_triangles(
+      clip.data(), triangle_count, c.depth_range, vec2::one(), clipped.data(),
+      sources.data());
+
+    // the first triangle is unchanged and the last is clipped to a quad
+    REQUIRE(clipped_count == 3);
+    CHECK(sources[0] == 0);
+    CHECK(sources[1] == 2);
+    CHECK(sources[2] == 2);
+    CHECK(clipped[0] == clip[0]);
+    CHECK(clipped[1] == clip[1]);
+    CHECK(clipped[2] == clip[2]);
+
+    real min_depth = std::numeric_limits<real>::max();
+    for (index i = 3; i < clipped_count * 3; ++i) {
+      CHECK(clipped[i].w > 0.0_r);
+      CHECK(clip_inside(clipped[i], c.depth_range, vec2::one()));
+      min_depth = std::min(
+        min_depth, std::abs(clipped[i].z / clipped[i].w - c.depth_range.x));
+    }
+    // the new vertices are on the near plane
+    CHECK(min_depth == Approx(0.0_r).margin(1e-4_r));
+  }
+}
+
+} // namespace unit_test
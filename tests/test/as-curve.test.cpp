@@ -0,0 +1,239 @@
+#include "as-helpers.test.hpp"
+#include "as/as-curve.hpp"
+#include "catch-matchers.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <vector>
+
+namespace unit_test
+{
+
+// testing
+using Catch::Approx;
+
+// types
+using as::arc_length_table;
+using as::cubic_curve2;
+using as::cubic_curve3;
+using as::index;
+using as::real;
+using as::vec2;
+using as::vec3;
+using as::vec4;
+
+// functions
+using as::vec_distance;
+using as::vec_mix;
+using as::vec_near;
+using as::operator""_r;
+
+static const real k_curve_epsilon = 1e-5_r;
+
+// returns the point on a cubic Bezier curve with De Casteljau's algorithm
+template<typename T, index d>
+static as::vec<T, d> de_casteljau(
+  const as::vec<T, d>& p0, const as::vec<T, d>& p1, const as::vec<T, d>& p2,
+  const as::vec<T, d>& p3, const real t)
+{
+  const auto p01 = vec_mix(p0, p1, t);
+  const auto p12 = vec_mix(p1, p2, t);
+  const auto p23 = vec_mix(p2, p3, t);
+  return vec_mix(vec_mix(p01, p12, t), vec_mix(p12, p23, t), t);
+}
+
+static cubic_curve3 test_curve()
+{
+  return as::cubic_curve_from_bezier(
+    vec3(0.0_r, 0.0_r, 0.0_r), vec3(1.0_r, 3.0_r, 0.0_r),
+    vec3(4.0_r, 3.0_r, -1.0_r), vec3(5.0_r, 0.0_r, 2.0_r));
+}
+
+TEST_CASE("cubic_curve_from_bezier", "[as_curve]")
+{
+  const vec3 p0(0.0_r, 0.0_r, 0.0_r);
+  const vec3 p1(1.0_r, 3.0_r, 0.0_r);
+  const vec3 p2(4.0_r, 3.0_r, -1.0_r);
+  const vec3 p3(5.0_r, 0.0_r, 2.0_r);
+  const cubic_curve3 curve = as::cubic_curve_from_bezier(p0, p1, p2, p3);
+  for (const real t : {0.0_r, 0.2_r, 0.5_r, 0.65_r, 1.0_r}) {
+    CHECK(vec_near(
+      as::cubic_curve_evaluate(curve, t), de_casteljau(p0, p1, p2, p3, t),
+      k_curve_epsilon));
+  }
+  // the tangents at the end points point to the control points
+  CHECK(vec_near(as::cubic_curve_derivative(curve, 0.0_r), (p1 - p0) * 3.0_r));
+  CHECK(vec_near(as::cubic_curve_derivative(curve, 1.0_r), (p3 - p2) * 3.0_r));
+
+  // any dimension
+  const vec4 q0(1.0_r, 2.0_r, 3.0_r, 4.0_r);
+  const vec4 q1(-1.0_r, 0.0_r, 2.0_r, 8.0_r);
+  const vec4 q2(2.0_r, -3.0_r, 1.0_r, 0.0_r);
+  const vec4 q3(0.0_r, 1.0_r, 0.0_r, 1.0_r);
+  CHECK(vec_near(
+    as::cubic_curve_evaluate(
+      as::cubic_curve_from_bezier(q0, q1, q2, q3), 0.3_r),
+    de_casteljau(q0, q1, q2, q3, 0.3_r), k_curve_epsilon));
+}
+
+TEST_CASE("cubic_curve_from_hermite", "[as_curve]")
+{
+  const vec2 p0(1.0_r, 2.0_r);
+  const vec2 m0(3.0_r, 0.0_r);
+  const vec2 p1(4.0_r, -1.0_r);
+  const vec2 m1(0.0_r, -2.0_r);
+  const cubic_curve2 curve = as::cubic_curve_from_hermite(p0, m0, p1, m1);
+  CHECK(vec_near(as::cubic_curve_evaluate(curve, 0.0_r), p0));
+  CHECK(vec_near(as::cubic_curve_evaluate(curve, 1.0_r), p1));
+  CHECK(vec_near(as::cubic_curve_derivative(curve, 0.0_r), m0));
+  CHECK(vec_near(as::cubic_curve_derivative(curve, 1.0_r), m1));
+}
+
+TEST_CASE("cubic_curve_from_catmull_rom", "[as_curve]")
+{
+  const vec2 p0(0.0_r, 0.0_r);
+  const vec2 p1(1.0_r, 1.0_r);
+  const vec2 p2(3.0_r, 1.0_r);
+  const vec2 p3(4.0_r, -2.0_r);
+  const vec2 p4(6.0_r, 0.0_r);
+  const cubic_curve2 first = as::cubic_curve_from_catmull_rom(p0, p1, p2, p3);
+  const cubic_curve2 second = as::cubic_curve_from_catmull_rom(p1, p2, p3, p4);
+  CHECK(vec_near(as::cubic_curve_evaluate(first, 0.0_r), p1));
+  CHECK(vec_near(as::cubic_curve_evaluate(first, 1.0_r), p2));
+  // consecutive segments join with the same tangent
+  CHECK(vec_near(as::cubic_curve_evaluate(second, 0.0_r), p2));
+  CHECK(vec_near(
+    as::cubic_curve_derivative(first, 1.0_r),
+    as::cubic_curve_derivative(second, 0.0_r)));
+  CHECK(vec_near(as::cubic_curve_derivative(first, 1.0_r), (p3 - p1) * 0.5_r));
+}
+
+TEST_CASE("cubic_curve_derivative", "[as_curve]")
+{
+  const cubic_curve3 curve = test_curve();
+  const real h = 1e-3_r;
+  for (const real t : {0.1_r, 0.4_r, 0.8_r}) {
+    const vec3 derivative = (as::cubic_curve_evaluate(curve, t + h)
+                             - as::cubic_curve_evaluate(curve, t - h))
+                          * (0.5_r / h);
+    CHECK(vec_near(as::cubic_curve_derivative(curve, t), derivative, 1e-2_r));
+    const vec3 second_derivative = (as::cubic_curve_derivative(curve, t + h)
+                                    - as::cubic_curve_derivative(curve, t - h))
+                                 * (0.5_r / h);
+    CHECK(vec_near(
+      as::cubic_curve_second_derivative(curve, t), second_derivative, 1e-2_r));
+  }
+}
+
+TEST_CASE("cubic_curve_evaluate_batch", "[as_curve]")
+{
+  const cubic_curve3 curve = test_curve();
+  std::vector<real> ts;
+  for (index i = 0; i < 100; ++i) {
+    ts.push_back(real(i) / 99.0_r);
+  }
+  std::vector<vec3> positions(ts.size());
+  as::cubic_curve_evaluate(
+    curve, ts.data(), index(ts.size()), positions.data());
+  for (index i = 0; i < index(ts.size()); ++i) {
+    const vec3 expected = as::cubic_curve_evaluate(curve, ts[i]);
+    CHECK(positions[i].x == expected.x);
+    CHECK(positions[i].y == expected.y);
+    CHECK(positions[i].z == expected.z);
+  }
+}
+
+TEST_CASE("cubic_curve_evaluate_uniform", "[as_curve]")
+{
+  const cubic_curve3 curve = test_curve();
+  for (const index count : {1, 2, 7, 1000}) {
+    std::vector<vec3> positions(count);
+    as::cubic_curve_evaluate_uniform(curve, count, positions.data());
+    for (index i = 0; i < count; ++i) {
+      const real t = count > 1 ? real(i) / real(count - 1) : 0.0_r;
+      CHECK(vec_near(
+        positions[i], as::cubic_curve_evaluate(curve, t), 1e-3_r, 1e-3_r));
+    }
+  }
+}
+
+TEST_CASE("cubic_curve_arc_length_table", "[as_curve]")
+{
+  // a straight line with unevenly spaced control points
+  const cubic_curve2 line = as::cubic_curve_from_bezier(
+    vec2(0.0_r, 0.0_r), vec2(0.5_r, 0.0_r), vec2(1.0_r, 0.0_r),
+    vec2(10.0_r, 0.0_r));
+  const arc_length_table line_table =
+    as::cubic_curve_arc_length_table(line, 16);
+  REQUIRE(line_table.lengths.size() == 17);
+  CHECK(line_table.lengths.front() == 0.0_r);
+  CHECK(line_table.lengths.back() == Approx(10.0_r).epsilon(1e-5_r));
+  CHECK(as::arc_length_param_from_distance(line_table, -1.0_r) == 0.0_r);
+  CHECK(as::arc_length_param_from_distance(line_table, 20.0_r) == 1.0_r);
+
+  // the length of a curve matches the sum of many small chords
+  const cubic_curve3 curve = test_curve();
+  const arc_length_table table = as::cubic_curve_arc_length_table(curve, 32);
+  real chords = 0.0_r;
+  for (index i = 0; i < 10000; ++i) {
+    chords += vec_distance(
+      as::cubic_curve_evaluate(curve, real(i) / 10000.0_r),
+      as::cubic_curve_evaluate(curve, real(i + 1) / 10000.0_r));
+  }
+  CHECK(table.lengths.back() == Approx(chords).epsilon(1e-4_r));
+
+  // the parameter at each length of the table is the parameter of the entry
+  for (index i = 0; i < index(table.lengths.size()); ++i) {
+    CHECK(
+      as::arc_length_param_from_distance(table, table.lengths[i])
+      == Approx(real(i) / 32.0_r).margin(1e-5_r));
+  }
+}
+
+TEST_CASE("cubic_curve_arc_length_table_min_intervals", "[as_curve]")
+{
+  // fewer than one interval is treated as one interval
+  const cubic_curve3 curve = test_curve();
+  const arc_length_table one = as::cubic_curve_arc_length_table(curve, 1);
+  for (const index interval_count : {index(0), index(-3)}) {
+    const arc_length_table table =
+      as::cubic_curve_arc_length_table(curve, interval_count);
+    CHECK(table.lengths == one.lengths);
+    CHECK(
+      as::arc_length_param_from_distance(table, table.lengths.back() * 0.5_r)
+      == Approx(0.5_r).margin(1e-5_r));
+    vec3 positions[3];
+    as::cubic_curve_evaluate_constant_speed(curve, table, 3, positions);
+    CHECK(vec_near(positions[0], as::cubic_curve_evaluate(curve, 0.0_r)));
+    CHECK(vec_near(positions[1], as::cubic_curve_evaluate(curve, 0.5_r)));
+    CHECK(vec_near(positions[2], as::cubic_curve_evaluate(curve, 1.0_r)));
+  }
+}
+
+TEST_CASE("cubic_curve_evaluate_constant_speed", "[as_curve]")
+{
+  const cubic_curve3 curve = test_curve();
+  const arc_length_table table = as::cubic_curve_arc_length_table(curve, 256);
+  const index count = 200;
+  std::vector<vec3> positions(count);
+  as::cubic_curve_evaluate_constant_speed(
+    curve, table, count, positions.data());
+  CHECK(vec_near(positions.front(), as::cubic_curve_evaluate(curve, 0.0_r)));
+  CHECK(vec_near(
+    positions.back(), as::cubic_curve_evaluate(curve, 1.0_r), 1e-4_r));
+
+  // samples are evenly spaced (the parameter is not)
+  const real spacing = table.lengths.back() / real(count - 1);
+  for (index i = 1; i < count; ++i) {
+    CHECK(
+      vec_distance(positions[i - 1], positions[i])
+      == Approx(spacing).epsilon(1e-2_r));
+  }
+  // and match the parameter found for each distance
+  for (index i = 0; i < count; ++i) {
+    const real t =
+      as::arc_length_param_from_distance(table, real(i) * spacing);
+    CHECK(vec_near(positions[i], as::cubic_curve_evaluate(curve, t), 1e-4_r));
+  }
+}
+
+} // namespace unit_test
@@ -0,0 +1,186 @@
+#include "as-helpers.test.hpp"
+#include "as/as-dual-quat.hpp"
+#include "catch-matchers.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+namespace unit_test
+{
+
+// testing
+using Catch::Approx;
+
+// types
+using as::dual_quat;
+using as::mat4;
+using as::quat;
+using as::real;
+using as::rigid;
+using as::vec3;
+
+// functions
+using as::radians;
+using as::operator""_r;
+
+[[maybe_unused]] constexpr auto dual_quat_type_check =
+  unit_test::trivial_standard_layout_check<dual_quat>();
+
+TEST_CASE("dual_quat_identity", "[as_dual_quat]")
+{
+  const dual_quat identity = dual_quat::identity();
+  CHECK(as::quat_near(identity.real_part, quat::identity()));
+  CHECK(as::quat_near(identity.dual_part, quat(0.0_r, 0.0_r, 0.0_r, 0.0_r)));
+  CHECK(dual_quat::size() == 8);
+
+  const vec3 position(1.0_r, 2.0_r, 3.0_r);
+  CHECK(
+    as::vec_near(as::dual_quat_transform_pos(identity, position), position));
+}
+
+TEST_CASE("dual_quat_rigid_conversion", "[as_dual_quat]")
+{
+  const rigid r(
+    as::quat_rotation_xyz(radians(30.0_r), radians(45.0_r), radians(60.0_r)),
+    vec3(1.0_r, -2.0_r, 3.0_r));
+  const dual_quat dq = as::dual_quat_from_rigid(r);
+
+  const vec3 position(4.0_r, 5.0_r, -6.0_r);
+  CHECK(as::vec_near(
+    as::dual_quat_transform_pos(dq, position),
+    as::rigid_transform_pos(r, position), 1e-5_r));
+  CHECK(as::vec_near(
+    as::dual_quat_transform_dir(dq, position),
+    as::rigid_transform_dir(r, position), 1e-5_r));
+
+  CHECK(as::rigid_near(as::rigid_from_dual_quat(dq), r, 1e-5_r));
+  // the real part is normalized
+  CHECK(as::rigid_near(
+    as::rigid_from_dual_quat(dq * 3.0_r), as::rigid_from_dual_quat(dq),
+    1e-5_r));
+}
+
+TEST_CASE("dual_quat_mat4_conversion", "[as_dual_quat]")
+{
+  const rigid r(
+    as::quat_rotation_axis(
+      as::vec_normalize(vec3(1.0_r, 1.0_r, 0.0_r)), radians(70.0_r)),
+    vec3(-4.0_r, 0.5_r, 2.0_r));
+  const mat4 m = as::mat4_from_rigid(r);
+
+  const dual_quat dq = as::dual_quat_from_mat4(m);
+  CHECK(as::dual_quat_near(dq, as::dual_quat_from_rigid(r), 1e-5_r));
+  CHECK(as::mat_near(as::mat4_from_dual_quat(dq), m, 1e-5_r));
+}
+
+TEST_CASE("dual_quat_mul", "[as_dual_quat]")
+{
+  const rigid a(
+    as::quat_rotation_x(radians(90.0_r)), vec3(1.0_r, 2.0_r, 3.0_r));
+  const rigid b(
+    as::quat_rotation_z(radians(45.0_r)), vec3(0.0_r, -5.0_r, 1.0_r));
+  const dual_quat product = as::dual_quat_mul(
+    as::dual_quat_from_rigid(a), as::dual_quat_from_rigid(b));
+
+  // a is performed first, then b
+  const vec3 position(2.0_r, -1.0_r, 0.5_r);
+  CHECK(as::vec_near(
+    as::dual_quat_transform_pos(product, position),
+    as::rigid_transform_pos(b, as::rigid_transform_pos(a, position)),
+    1e-5_r));
+  CHECK(as::rigid_near(
+    as::rigid_from_dual_quat(product), as::rigid_mul(a, b), 1e-5_r));
+}
+
+TEST_CASE("dual_quat_inverse", "[as_dual_quat]")
+{
+  const rigid r(
+    as::quat_rotation_y(radians(120.0_r)), vec3(3.0_r, 0.0_r, -1.0_r));
+  const dual_quat dq = as::dual_quat_from_rigid(r);
+
+  CHECK(as::dual_quat_near(
+    as::dual_quat_mul(dq, as::dual_quat_inverse(dq)), dual_quat::identity(),
+    1e-5_r));
+  CHECK(as::dual_quat_near(
+    as::dual_quat_inverse(dq), as::dual_quat_conjugate(dq), 1e-5_r));
+  CHECK(as::rigid_near(
+    as::rigid_from_dual_quat(as::dual_quat_inverse(dq)), as::rigid_inverse(r),
+    1e-5_r));
+}
+
+TEST_CASE("dual_quat_normalize", "[as_dual_quat]")
+{
+  const dual_quat dq = as::dual_quat_from_rigid(rigid(
+    as::quat_rotation_x(radians(30.0_r)), vec3(1.0_r, 2.0_r, 3.0_r)));
+
+  // scaled
+  CHECK(as::dual_quat_near(as::dual_quat_normalize(dq * 4.0_r), dq, 1e-5_r));
+
+  // the part of the dual part parallel to the real part is removed
+  dual_quat skewed = dq;
+  skewed.dual_part = skewed.dual_part + skewed.real_part * 0.25_r;
+  const dual_quat normalized = as::dual_quat_normalize(skewed);
+  CHECK(as::quat_length(normalized.real_part) == Approx(1.0_r));
+  CHECK(
+    as::quat_dot(normalized.real_part, normalized.dual_part)
+    == Approx(0.0_r).margin(1e-6_r));
+  CHECK(as::dual_quat_near(normalized, dq, 1e-5_r));
+}
+
+TEST_CASE("dual_quat_sclerp", "[as_dual_quat]")
+{
+  // rotation of 120 degrees about the z axis through (1, 0, 0)
+  const real half_sqrt3 = std::sqrt(3.0_r) * 0.5_r;
+  const dual_quat begin = dual_quat::identity();
+  const dual_quat end = as::dual_quat_from_rigid(rigid(
+    as::quat_rotation_z(radians(120.0_r)), vec3(1.5_r, -half_sqrt3, 0.0_r)));
+
+  CHECK(as::dual_quat_near(
+    as::dual_quat_sclerp(begin, end, 0.0_r), begin, 1e-5_r));
+  CHECK(
+    as::dual_quat_near(as::dual_quat_sclerp(begin, end, 1.0_r), end, 1e-5_r));
+
+  // points move along a circle around the axis
+  const dual_quat half = as::dual_quat_sclerp(begin, end, 0.5_r);
+  CHECK(as::vec_near(
+    as::dual_quat_transform_pos(half, vec3::zero()),
+    vec3(0.5_r, -half_sqrt3, 0.0_r), 1e-5_r));
+  const dual_quat quarter = as::dual_quat_sclerp(begin, end, 0.25_r);
+  const vec3 quarter_position =
+    as::dual_quat_transform_pos(quarter, vec3::zero());
+  CHECK(
+    as::vec_length(quarter_position - vec3(1.0_r, 0.0_r, 0.0_r))
+    == Approx(1.0_r));
+
+  // a screw motion moves along the axis at a constant rate
+  const dual_quat screw = as::dual_quat_from_rigid(
+    rigid(as::quat_rotation_z(radians(90.0_r)), vec3(0.0_r, 0.0_r, 4.0_r)));
+  const rigid screw_half =
+    as::rigid_from_dual_quat(as::dual_quat_sclerp(begin, screw, 0.5_r));
+  CHECK(as::vec_near(
+    screw_half.translation, vec3(0.0_r, 0.0_r, 2.0_r), 1e-5_r));
+  CHECK(as::quat_near(
+    screw_half.rotation, as::quat_rotation_z(radians(45.0_r)), 1e-5_r));
+
+  // translation only
+  const dual_quat moved =
+    as::dual_quat_from_rigid(rigid(vec3(2.0_r, 4.0_r, -6.0_r)));
+  CHECK(as::vec_near(
+    as::rigid_from_dual_quat(as::dual_quat_sclerp(begin, moved, 0.5_r))
+      .translation,
+    vec3(1.0_r, 2.0_r, -3.0_r), 1e-5_r));
+
+  // the shortest path is taken (the negation is the same transformation)
+  CHECK(as::dual_quat_near(
+    as::dual_quat_sclerp(begin, -screw, 0.5_r),
+    as::dual_quat_sclerp(begin, screw, 0.5_r), 1e-5_r));
+
+  // relative to the start
+  const dual_quat start = as::dual_quat_from_rigid(
+    rigid(as::quat_rotation_x(radians(60.0_r)), vec3(1.0_r, 1.0_r, 1.0_r)));
+  const dual_quat start_screw = as::dual_quat_mul(start, screw);
+  CHECK(as::dual_quat_near(
+    as::dual_quat_sclerp(start, start_screw, 0.5_r),
+    as::dual_quat_mul(start, as::dual_quat_sclerp(begin, screw, 0.5_r)),
+    1e-5_r));
+}
+
+} // namespace unit_test
@@ -0,0 +1,227 @@
+#include "as-helpers.test.hpp"
+#include "as/as-frustum.hpp"
+#include "as/as-view.hpp"
+#include "catch-matchers.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <random>
+#include <vector>
+
+namespace unit_test
+{
+
+// testing
+using Catch::Approx;
+
+// types
+using as::aabb;
+using as::affine;
+using as::frustum;
+using as::index;
+using as::mat4;
+using as::real;
+using as::vec2;
+using as::vec3;
+using as::vec4;
+
+// functions
+using as::radians;
+using as::operator""_r;
+
+struct projection_convention
+{
+  mat4 projection;
+  vec2 depth_range;
+};
+
+static std::vector<projection_convention> projection_conventions()
+{
+  const real fov = radians(60.0_r);
+  const real aspect = 16.0_r / 9.0_r;
+  const real n = 0.5_r;
+  const real f = 100.0_r;
+  return {
+    {as::perspective_opengl_rh(fov, aspect, n, f), vec2(-1.0_r, 1.0_r)},
+    {as::perspective_opengl_lh(fov, aspect, n, f), vec2(-1.0_r, 1.0_r)},
+    {as::perspective_direct3d_rh(fov, aspect, n, f), vec2(0.0_r, 1.0_r)},
+    {as::perspective_direct3d_lh(fov, aspect, n, f), vec2(0.0_r, 1.0_r)},
+    {as::perspective_vulkan_rh(fov, aspect, n, f), vec2(0.0_r, 1.0_r)},
+    {as::perspective_vulkan_lh(fov, aspect, n, f), vec2(0.0_r, 1.0_r)},
+    {as::reverse_z(as::perspective_direct3d_lh(fov, aspect, n, f)),
+     vec2(1.0_r, 0.0_r)},
+    {as::reverse_z(as::perspective_vulkan_rh(fov, aspect, n, f)),
+     vec2(1.0_r, 0.0_r)},
+    {as::ortho_opengl_rh(-4.0_r, 4.0_r, -2.0_r, 2.0_r, n, f),
+     vec2(-1.0_r, 1.0_r)},
+    {as::ortho_direct3d_lh(-4.0_r, 4.0_r, -2.0_r, 2.0_r, n, f),
+     vec2(0.0_r, 1.0_r)},
+    {as::ortho_vulkan_rh(-4.0_r, 4.0_r, -2.0_r, 2.0_r, n, f),
+     vec2(0.0_r, 1.0_r)}};
+}
+
+static mat4 make_view_projection(const mat4& projection)
+{
+  const affine camera = affine(
+    as::mat3_rotation_y(radians(30.0_r)), vec3(3.0_r, 2.0_r, -5.0_r));
+  return as::mat_mul(
+    as::mat4_from_affine(as::affine_inverse(camera)), projection);
+}
+
+// returns the world position of a normalized device coordinate
+static vec3 unproject(const mat4& inverse_view_projection, const vec3& ndc)
+{
+  const vec4 world =
+    as::mat_mul(as::vec4_from_vec3(ndc, 1.0_r), inverse_view_projection);
+  return as::vec3_from_vec4(world / world.w);
+}
+
+TEST_CASE("frustum_from_mat4", "[as_frustum]")
+{
+  for (const auto& convention : projection_conventions()) {
+    const mat4 view_projection = make_view_projection(convention.projection);
+    const mat4 inverse_view_projection = as::mat_inverse(view_projection);
+    const frustum view_frustum =
+      as::frustum_from_mat4(view_projection, convention.depth_range);
+
+    const real near_depth = convention.depth_range.x;
+    const real far_depth = convention.depth_range.y;
+    const auto depth = [&](const real t) {
+      return near_depth + (far_depth - near_depth) * t;
+    };
+
+    for (const vec4& plane : view_frustum.planes) {
+      CHECK(as::vec_length(as::vec3_from_vec4(plane)) == Approx(1.0_r));
+    }
+
+    // inside
+    for (const real t : {0.01_r, 0.5_r, 0.99_r}) {
+      for (const real x : {-0.9_r, 0.0_r, 0.9_r}) {
+        for (const real y : {-0.9_r, 0.0_r, 0.9_r}) {
+          const vec3 world =
+            unproject(inverse_view_projection, vec3(x, y, depth(t)));
+          for (const vec4& plane : view_frustum.planes) {
+            CHECK(as::plane_distance(plane, world) > 0.0_r);
+          }
+        }
+      }
+    }
+
+    // outside of each plane in turn (only just beyond the far plane as depths
+    // past the depth at infinity of a perspective projection are behind the
+    // camera)
+    const vec3 outside[] = {
+      vec3(-1.1_r, 0.0_r, depth(0.5_r)), vec3(1.1_r, 0.0_r, depth(0.5_r)),
+      vec3(0.0_r, -1.1_r, depth(0.5_r)), vec3(0.0_r, 1.1_r, depth(0.5_r)),
+      vec3(0.0_r, 0.0_r, depth(-0.02_r)), vec3(0.0_r, 0.0_r, depth(1.002_r))};
+    for (index plane = 0; plane < frustum::size(); ++plane) {
+      const vec3 world = unproject(inverse_view_projection, outside[plane]);
+      for (index other = 0; other < frustum::size(); ++other) {
+        const real distance =
+          as::plane_distance(view_frustum.planes[other], world);
+        if (other == plane) {
+          CHECK(distance < 0.0_r);
+        } else {
+          CHECK(distance > 0.0_r);
+        }
+      }
+    }
+
+    // the near plane passes through points on the near clip plane
+    const vec3 near_point =
+      unproject(inverse_view_projection, vec3(0.3_r, -0.2_r, near_depth));
+    CHECK(
+      as::plane_distance(view_frustum.planes[4], near_point)
+      == Approx(0.0_r).margin(1e-3_r));
+  }
+}
+
+TEST_CASE("frustum_intersects", "[as_frustum]")
+{
+  const mat4 projection = as::perspective_direct3d_lh(
+    radians(90.0_r), 1.0_r, 1.0_r, 100.0_r);
+  const frustum view_frustum =
+    as::frustum_from_mat4(projection, vec2(0.0_r, 1.0_r));
+
+  CHECK(as::frustum_intersects_sphere(
+    view_frustum, vec3(0.0_r, 0.0_r, 10.0_r), 1.0_r));
+  CHECK(as::frustum_intersects_sphere(
+    view_frustum, vec3(0.0_r, 0.0_r, 0.5_r), 1.0_r));
+  CHECK(!as::frustum_intersects_sphere(
+    view_frustum, vec3(0.0_r, 0.0_r, -5.0_r), 1.0_r));
+  CHECK(!as::frustum_intersects_sphere(
+    view_frustum, vec3(20.0_r, 0.0_r, 10.0_r), 1.0_r));
+
+  const auto intersects = [&view_frustum](const vec3& min, const vec3& max) {
+    return as::frustum_intersects_aabb(view_frustum, aabb(min, max));
+  };
+  CHECK(intersects(vec3(-1.0_r, -1.0_r, 9.0_r), vec3(1.0_r, 1.0_r, 11.0_r)));
+  // straddling the right plane
+  CHECK(intersects(vec3(9.0_r, -1.0_r, 9.0_r), vec3(12.0_r, 1.0_r, 11.0_r)));
+  CHECK(!intersects(vec3(12.0_r, -1.0_r, 9.0_r), vec3(14.0_r, 1.0_r, 11.0_r)));
+  CHECK(
+    !intersects(vec3(-1.0_r, -1.0_r, 101.0_r), vec3(1.0_r, 1.0_r, 102.0_r)));
+}
+
+TEST_CASE("frustum_cull_batch", "[as_frustum]")
+{
+  const mat4 view_projection = make_view_projection(
+    as::perspective_vulkan_rh(radians(60.0_r), 1.5_r, 0.5_r, 100.0_r));
+  const frustum view_frustum =
+    as::frustum_from_mat4(view_projection, vec2(0.0_r, 1.0_r));
+
+  const index count = as::k_cull_chunk_size * 2 + 45;
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<real> position(-100.0_r, 100.0_r);
+  std::uniform_real_distribution<real> size(0.1_r, 5.0_r);
+  std::vector<real> x(count), y(count), z(count), radius(count);
+  std::vector<real> max_x(count), max_y(count), max_z(count);
+  for (index i = 0; i < count; ++i) {
+    x[i] = position(gen);
+    y[i] = position(gen);
+    z[i] = position(gen);
+    radius[i] = size(gen);
+    max_x[i] = x[i] + size(gen);
+    max_y[i] = y[i] + size(gen);
+    max_z[i] = z[i] + size(gen);
+  }
+
+  const index word_count = as::chunk_count(count, 32);
+  std::vector<uint32_t> sphere_visibility(word_count);
+  as::frustum_cull_spheres(
+    view_frustum,
+    as::sphere_soa_t<real>{x.data(), y.data(), z.data(), radius.data()},
+    count, sphere_visibility.data());
+  std::vector<uint32_t> box_visibility(word_count);
+  as::frustum_cull_aabbs(
+    view_frustum,
+    as::aabb_soa_t<real>{
+      x.data(), y.data(), z.data(), max_x.data(), max_y.data(), max_z.data()},
+    count, box_visibility.data(), reverse_executor{});
+
+  index visible_spheres = 0;
+  index visible_boxes = 0;
+  bool spheres_match = true;
+  bool boxes_match = true;
+  for (index i = 0; i < count; ++i) {
+    const bool sphere_visible = as::frustum_intersects_sphere(
+      view_frustum, vec3(x[i], y[i], z[i]), radius[i]);
+    const bool box_visible = as::frustum_intersects_aabb(
+      view_frustum,
+      aabb(vec3(x[i], y[i], z[i]), vec3(max_x[i], max_y[i], max_z[i])));
+    const uint32_t bit = 1u << (i % 32);
+    spheres_match = spheres_match
+                 && ((sphere_visibility[i / 32] & bit) != 0) == sphere_visible;
+    boxes_match =
+      boxes_match && ((box_visibility[i / 32] & bit) != 0) == box_visible;
+    visible_spheres += sphere_visible;
+    visible_boxes += box_visible;
+  }
+  CHECK(spheres_match);
+  CHECK(boxes_match);
+  CHECK(visible_spheres > 0);
+  CHECK(visible_spheres < count);
+  CHECK(visible_boxes > 0);
+  CHECK(visible_boxes < count);
+}
+
+} // namespace unit_test
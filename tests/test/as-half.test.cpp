@@ -0,0 +1,149 @@
+#include "as-helpers.test.hpp"
+#include "as/as-half.hpp"
+#include "catch-matchers.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <limits>
+#include <vector>
+
+namespace unit_test
+{
+
+// types
+using as::half;
+using as::index;
+using as::mat4f;
+using as::mat4h;
+using as::vec3f;
+using as::vec3h;
+
+// functions
+using as::half_from_bits;
+using as::operator""_r;
+
+[[maybe_unused]] constexpr auto half_type_check =
+  unit_test::trivial_standard_layout_check<half>();
+[[maybe_unused]] constexpr auto vec3h_type_check =
+  unit_test::trivial_standard_layout_check<vec3h>();
+
+TEST_CASE("half_size", "[as_half]")
+{
+  STATIC_REQUIRE(sizeof(half) == 2);
+  STATIC_REQUIRE(sizeof(vec3h) == 6);
+  STATIC_REQUIRE(sizeof(as::vec4h) == 8);
+  STATIC_REQUIRE(sizeof(mat4h) == 32);
+}
+
+TEST_CASE("half_from_float", "[as_half]")
+{
+  CHECK(half(0.0f).bits == 0x0000);
+  CHECK(half(-0.0f).bits == 0x8000);
+  CHECK(half(1.0f).bits == 0x3c00);
+  CHECK(half(-2.0f).bits == 0xc000);
+  CHECK(half(0.333251953125f).bits == 0x3555);
+  CHECK(half(65504.0f).bits == 0x7bff);
+  // the smallest normal and subnormal values
+  CHECK(half(6.103515625e-05f).bits == 0x0400);
+  CHECK(half(5.9604644775390625e-08f).bits == 0x0001);
+
+  // ties are rounded to even
+  CHECK(half(1.0f + 1.0f / 2048.0f).bits == 0x3c00);
+  CHECK(half(1.0f + 3.0f / 2048.0f).bits == 0x3c02);
+  CHECK(half(2.98023223876953125e-08f).bits == 0x0000);
+  CHECK(half(8.94069671630859375e-08f).bits == 0x0002);
+
+  // too large values become infinity, nan stays nan
+  CHECK(half(65520.0f).bits == 0x7c00);
+  CHECK(half(-1e10f).bits == 0xfc00);
+  CHECK(half(std::numeric_limits<float>::infinity()).bits == 0x7c00);
+  const half nan = half(std::numeric_limits<float>::quiet_NaN());
+  CHECK((nan.bits & 0x7c00) == 0x7c00);
+  CHECK((nan.bits & 0x03ff) != 0);
+}
+
+TEST_CASE("float_from_half", "[as_half]")
+{
+  CHECK(float(half_from_bits(0x3c00)) == 1.0f);
+  CHECK(float(half_from_bits(0xc000)) == -2.0f);
+  CHECK(float(half_from_bits(0x7bff)) == 65504.0f);
+  CHECK(float(half_from_bits(0x0001)) == 5.9604644775390625e-08f);
+  CHECK(float(half_from_bits(0x03ff)) == 6.09755516052246094e-05f);
+  CHECK(
+    float(half_from_bits(0xfc00)) == -std::numeric_limits<float>::infinity());
+  CHECK(std::isnan(float(half_from_bits(0x7e00))));
+
+  // every value that is not nan converts to float and back unchanged
+  for (uint32_t bits = 0; bits <= 0xffff; ++bits) {
+    const half value = half_from_bits(uint16_t(bits));
+    if ((bits & 0x7c00) == 0x7c00 && (bits & 0x03ff) != 0) {
+      CHECK(std::isnan(float(value)));
+      continue;
+    }
+    CHECK(half(float(value)).bits == value.bits);
+  }
+}
+
+TEST_CASE("half_from_float_batch", "[as_half]")
+{
+  // an odd number of values (converted in groups of eight and one at a time)
+  std::vector<float> values;
+  for (index i = 0; i < 203; ++i) {
+    values.push_back(float(i - 100) * 0.37f * float(i % 7 + 1));
+  }
+  values.push_back(1e-6f);
+  values.push_back(1e6f);
+
+  const auto count = index(values.size());
+  std::vector<half> halves(count);
+  as::half_from_float(values.data(), count, halves.data());
+  std::vector<float> converted(count);
+  as::float_from_half(halves.data(), count, converted.data());
+  for (index i = 0; i < count; ++i) {
+    CHECK(halves[i].bits == half(values[i]).bits);
+    CHECK(converted[i] == float(halves[i]));
+  }
+}
+
+TEST_CASE("vec_from_vec_half", "[as_half]")
+{
+  std::vector<vec3f> vs;
+  for (index i = 0; i < 37; ++i) {
+    vs.push_back(vec3f(float(i), float(i) * -0.25f, 1.0f / float(i + 1)));
+  }
+  const auto count = index(vs.size());
+  std::vector<vec3h> halves(count);
+  as::vec_from_vec(vs.data(), count, halves.data());
+  std::vector<vec3f> converted(count);
+  as::vec_from_vec(halves.data(), count, converted.data());
+  for (index i = 0; i < count; ++i) {
+    const vec3h expected = as::vec_from_vec<half>(vs[i]);
+    CHECK(halves[i].x.bits == expected.x.bits);
+    CHECK(halves[i].y.bits == expected.y.bits);
+    CHECK(halves[i].z.bits == expected.z.bits);
+    CHECK(converted[i] == as::vec_from_vec<float>(halves[i]));
+    // within the precision of half
+    CHECK(as::vec_near(converted[i], vs[i], 0.0_r, 1.0_r / 1024.0_r));
+  }
+}
+
+TEST_CASE("mat_from_mat_half", "[as_half]")
+{
+  const mat4f ms[] = {
+    as::mat4_from_mat3_vec3(
+      as::mat3_rotation_xyz(0.1f, 0.2f, 0.3f), vec3f(1.0f, 2.0f, 3.0f)),
+    mat4f::identity()};
+  mat4h halves[2];
+  as::mat_from_mat(ms, 2, halves);
+  mat4f converted[2];
+  as::mat_from_mat(halves, 2, converted);
+  for (index m = 0; m < 2; ++m) {
+    const mat4h expected = as::mat_from_mat<half>(ms[m]);
+    for (index e = 0; e < 16; ++e) {
+      CHECK(halves[m][e].bits == expected[e].bits);
+      CHECK(converted[m][e] == float(halves[m][e]));
+    }
+    CHECK(as::mat_near(converted[m], ms[m], 1.0_r / 1024.0_r));
+  }
+}
+
+} // namespace unit_test
@@ -29,6 +29,18 @@ constexpr bool trivial_standard_layout_check()
   return true;
 }
 
+// runs chunks last to first to check results do not depend on chunk order
+struct reverse_executor
+{
+  template<typename Fn>
+  void operator()(const as::index count, const Fn& fn) const
+  {
+    for (as::index i = count - 1; i >= 0; --i) {
+      fn(i);
+    }
+  }
+};
+
 template<typename T>
 std::array<T, 2> arr(const T x, const T y)
 {
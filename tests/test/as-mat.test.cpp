@@ -3,6 +3,8 @@
 #include "catch-matchers.hpp"
 #include "catch2/catch_test_macros.hpp"
 
+#include <vector>
+
 namespace unit_test
 {
 
@@ -1931,6 +1933,137 @@ TEST_CASE("mat_conversion", "[as_mat]")
   }
 }
 
+// returns the basis vectors multiplied by the matrix (the stretch is applied
+// to the basis of the rotation)
+static mat3 mat3_stretched(const mat3& rotation, const mat3& stretch)
+{
+  const vec3 axes[] = {
+    as::mat3_basis_x(rotation), as::mat3_basis_y(rotation),
+    as::mat3_basis_z(rotation)};
+  vec3 columns[3];
+  for (index c = 0; c < 3; ++c) {
+    columns[c] = axes[0] * stretch[c] + axes[1] * stretch[3 + c]
+               + axes[2] * stretch[6 + c];
+  }
+  return mat3(columns[0], columns[1], columns[2]);
+}
+
+TEST_CASE("mat4_decompose", "[as_mat]")
+{
+  const quat rotation =
+    as::quat_rotation_xyz(radians(30.0_r), radians(-70.0_r), radians(120.0_r));
+  const vec3 translation(4.0_r, -2.0_r, 9.0_r);
+
+  for (const vec3 scale :
+       {vec3(1.0_r, 1.0_r, 1.0_r), vec3(2.0_r, 0.5_r, 3.0_r),
+        vec3(-2.0_r, 0.5_r, 3.0_r)}) {
+    const mat4 transform = as::mat4_from_mat3_vec3(
+      mat3_stretched(as::mat3_from_quat(rotation), as::mat3_scale(scale)),
+      translation);
+    const auto [decomposed, decomposed_scale] = as::mat4_decompose(transform);
+    CHECK(as::vec_near(decomposed_scale, scale, 1e-5_r));
+    CHECK(as::vec_near(decomposed.translation, translation));
+    CHECK(
+      std::abs(as::quat_dot(decomposed.rotation, rotation))
+      == Approx(1.0_r).margin(1e-5_r));
+  }
+
+  {
+    // a reflection of y is returned as a reflection of x
+    const mat4 transform = as::mat4_from_mat3_vec3(
+      mat3_stretched(
+        as::mat3_from_quat(rotation), as::mat3_scale(1.0_r, -2.0_r, 1.0_r)),
+      translation);
+    const auto [decomposed, scale] = as::mat4_decompose(transform);
+    CHECK(as::vec_near(scale, vec3(-1.0_r, 2.0_r, 1.0_r), 1e-5_r));
+    const mat4 recomposed = as::mat4_from_mat3_vec3(
+      mat3_stretched(
+        as::mat3_from_quat(decomposed.rotation), as::mat3_scale(scale)),
+      decomposed.translation);
+    CHECK(as::mat_near(recomposed, transform, 1e-5_r));
+  }
+}
+
+TEST_CASE("mat4_decompose_batch", "[as_mat]")
+{
+  std::vector<mat4> transforms;
+  for (index i = 0; i < 16; ++i) {
+    const real angle = radians(real(i) * 20.0_r);
+    transforms.push_back(as::mat4_from_mat3_vec3(
+      mat3_stretched(
+        as::mat3_rotation_xyz(angle, angle * 0.5_r, -angle),
+        as::mat3_scale(1.0_r + real(i), 2.0_r, i % 2 == 0 ? 1.0_r : -1.0_r)),
+      vec3(real(i), 0.0_r, 1.0_r)));
+  }
+
+  std::vector<rigid> rigids(transforms.size());
+  std::vector<vec3> scales(transforms.size());
+  as::mat4_decompose(
+    transforms.data(), index(transforms.size()), rigids.data(),
+    scales.data());
+  std::vector<mat3> stretches(transforms.size());
+  as::mat4_decompose_polar(
+    transforms.data(), index(transforms.size()), rigids.data(),
+    stretches.data());
+  for (index i = 0; i < index(transforms.size()); ++i) {
+    const auto [decomposed, scale] = as::mat4_decompose(transforms[i]);
+    CHECK(as::vec_near(scales[i], scale));
+    const auto [polar_decomposed, stretch] =
+      as::mat4_decompose_polar(transforms[i]);
+    CHECK(as::rigid_near(rigids[i], polar_decomposed));
+    CHECK(as::mat_near(stretches[i], stretch));
+  }
+}
+
+TEST_CASE("mat4_decompose_polar", "[as_mat]")
+{
+  const quat rotation =
+    as::quat_rotation_xyz(radians(-45.0_r), radians(10.0_r), radians(80.0_r));
+  const vec3 translation(-1.0_r, 5.0_r, 2.0_r);
+
+  {
+    // a symmetric positive definite stretch (scale and shear)
+    const mat3 stretch(
+      2.0_r, 0.3_r, -0.2_r, 0.3_r, 1.5_r, 0.4_r, -0.2_r, 0.4_r, 0.8_r);
+    const mat4 transform = as::mat4_from_mat3_vec3(
+      mat3_stretched(as::mat3_from_quat(rotation), stretch), translation);
+    const auto [decomposed, decomposed_stretch] =
+      as::mat4_decompose_polar(transform);
+    CHECK(as::mat_near(decomposed_stretch, stretch, 1e-5_r));
+    CHECK(as::vec_near(decomposed.translation, translation));
+    CHECK(
+      std::abs(as::quat_dot(decomposed.rotation, rotation))
+      == Approx(1.0_r).margin(1e-5_r));
+  }
+
+  {
+    // a shear recomposes from the rotation and stretch
+    const mat4 transform = as::mat4_shear_x(0.5_r, -0.25_r);
+    const auto [decomposed, stretch] = as::mat4_decompose_polar(transform);
+    const mat4 recomposed = as::mat4_from_mat3_vec3(
+      mat3_stretched(as::mat3_from_quat(decomposed.rotation), stretch),
+      decomposed.translation);
+    CHECK(as::mat_near(recomposed, transform, 1e-5_r));
+    CHECK(as::quat_length(decomposed.rotation) == Approx(1.0_r).margin(1e-5_r));
+  }
+
+  {
+    // the stretch of a transformation without shear is its scale and a
+    // reflection is a negative stretch
+    const vec3 scale(3.0_r, 0.5_r, -2.0_r);
+    const mat4 transform = as::mat4_from_mat3_vec3(
+      mat3_stretched(as::mat3_from_quat(rotation), as::mat3_scale(scale)),
+      translation);
+    const auto [decomposed, stretch] = as::mat4_decompose_polar(transform);
+    const mat4 recomposed = as::mat4_from_mat3_vec3(
+      mat3_stretched(as::mat3_from_quat(decomposed.rotation), stretch),
+      decomposed.translation);
+    CHECK(as::mat_near(recomposed, transform, 1e-5_r));
+    CHECK(as::mat_determinant(stretch) < 0.0_r);
+    CHECK(as::quat_length(decomposed.rotation) == Approx(1.0_r).margin(1e-5_r));
+  }
+}
+
 } // namespace unit_test
 
 // explicit instantiations (for coverage)
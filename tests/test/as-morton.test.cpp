@@ -0,0 +1,211 @@
+#include "as-helpers.test.hpp"
+#include "as/as-morton.hpp"
+#include "catch-matchers.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <array>
+#include <numeric>
+#include <random>
+
+namespace unit_test
+{
+
+// types
+using as::index;
+using as::real;
+using as::vec2i;
+using as::vec3;
+using as::vec3i;
+
+// functions
+using as::operator""_r;
+
+TEST_CASE("morton_encode_2d", "[as_morton]")
+{
+  CHECK(as::morton_encode(vec2i(0, 0)) == 0);
+  CHECK(as::morton_encode(vec2i(1, 0)) == 1);
+  CHECK(as::morton_encode(vec2i(0, 1)) == 2);
+  CHECK(as::morton_encode(vec2i(3, 3)) == 15);
+  CHECK(as::morton_encode(vec2i(5, 9)) == 0b10010011);
+  CHECK(
+    as::morton_encode(vec2i(0x7fffffff, 0x7fffffff)) == 0x3fffffffffffffff);
+}
+
+TEST_CASE("morton_encode_3d", "[as_morton]")
+{
+  CHECK(as::morton_encode(vec3i(0, 0, 0)) == 0);
+  CHECK(as::morton_encode(vec3i(1, 0, 0)) == 1);
+  CHECK(as::morton_encode(vec3i(0, 1, 0)) == 2);
+  CHECK(as::morton_encode(vec3i(0, 0, 1)) == 4);
+  CHECK(as::morton_encode(vec3i(3, 3, 3)) == 63);
+  CHECK(as::morton_encode(vec3i(5, 0, 2)) == 0b1100001);
+  CHECK(
+    as::morton_encode(vec3i(0x1fffff, 0x1fffff, 0x1fffff))
+    == 0x7fffffffffffffff);
+}
+
+TEST_CASE("morton_decode", "[as_morton]")
+{
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int32_t> dist2(0, 0x7fffffff);
+  std::uniform_int_distribution<int32_t> dist3(0, 0x1fffff);
+  for (index i = 0; i < 1000; ++i) {
+    const vec2i cell2(dist2(gen), dist2(gen));
+    CHECK(as::morton_decode2(as::morton_encode(cell2)) == cell2);
+    const vec3i cell3(dist3(gen), dist3(gen), dist3(gen));
+    CHECK(as::morton_decode3(as::morton_encode(cell3)) == cell3);
+  }
+}
+
+TEST_CASE("hilbert_encode_2d", "[as_morton]")
+{
+  // consecutive indices are always adjacent cells
+  vec2i previous = as::hilbert_decode2(0);
+  CHECK(previous == vec2i(0, 0));
+  for (uint64_t code = 1; code < 4096; ++code) {
+    const vec2i cell = as::hilbert_decode2(code);
+    const vec2i delta = as::vec_abs(cell - previous);
+    CHECK(delta.x + delta.y == 1);
+    CHECK(as::hilbert_encode(cell) == code);
+    previous = cell;
+  }
+}
+
+TEST_CASE("hilbert_encode_3d", "[as_morton]")
+{
+  // consecutive indices are always adjacent cells
+  vec3i previous = as::hilbert_decode3(0);
+  CHECK(previous == vec3i(0, 0, 0));
+  for (uint64_t code = 1; code < 4096; ++code) {
+    const vec3i cell = as::hilbert_decode3(code);
+    const vec3i delta = as::vec_abs(cell - previous);
+    CHECK(delta.x + delta.y + delta.z == 1);
+    CHECK(as::hilbert_encode(cell) == code);
+    previous = cell;
+  }
+}
+
+TEST_CASE("vec_quantize", "[as_morton]")
+{
+  const vec3 min(-1.0_r, 0.0_r, 10.0_r);
+  const vec3 max(1.0_r, 4.0_r, 20.0_r);
+  CHECK(as::vec_quantize(min, min, max, 2) == vec3i(0, 0, 0));
+  CHECK(as::vec_quantize(max, min, max, 2) == vec3i(3, 3, 3));
+  CHECK(
+    as::vec_quantize(vec3(0.1_r, 1.5_r, 12.0_r), min, max, 2)
+    == vec3i(2, 1, 0));
+  CHECK(
+    as::vec_quantize(vec3(-5.0_r, 5.0_r, 15.0_r), min, max, 2)
+    == vec3i(0, 3, 2));
+
+  // the last cell of 31 bits is not representable as a float
+  const as::vec2f min2f(0.0f, 0.0f);
+  const as::vec2f max2f(1.0f, 1.0f);
+  CHECK(
+    as::vec_quantize(max2f, min2f, max2f, 31)
+    == vec2i(0x7fffffff, 0x7fffffff));
+  CHECK(
+    as::vec_quantize(as::vec2f(2.0f, 0.5f), min2f, max2f, 31)
+    == vec2i(0x7fffffff, 0x40000000));
+  const as::vec2d min2d(0.0, 0.0);
+  const as::vec2d max2d(1.0, 1.0);
+  CHECK(
+    as::vec_quantize(max2d, min2d, max2d, 31)
+    == vec2i(0x7fffffff, 0x7fffffff));
+
+  // axes with no extent are in cell 0
+  const vec3 flat_min(-1.0_r, 2.0_r, 10.0_r);
+  const vec3 flat_max(1.0_r, 2.0_r, 20.0_r);
+  CHECK(
+    as::vec_quantize(vec3(1.0_r, 2.0_r, 15.0_r), flat_min, flat_max, 2)
+    == vec3i(3, 0, 2));
+  const vec3 point(3.0_r, -4.0_r, 5.0_r);
+  CHECK(as::vec_quantize(point, point, point, 21) == vec3i(0, 0, 0));
+}
+
+TEST_CASE("morton_encode_batch", "[as_morton]")
+{
+  const vec3i cells[] = {vec3i(1, 0, 0), vec3i(3, 3, 3), vec3i(0, 0, 1)};
+  std::array<uint64_t, 3> morton_codes;
+  as::morton_encode(cells, 3, morton_codes.data());
+  CHECK(morton_codes == arr<uint64_t>(1, 63, 4));
+
+  uint64_t hilbert_codes[3];
+  as::hilbert_encode(cells, 3, hilbert_codes);
+  for (index i = 0; i < 3; ++i) {
+    CHECK(hilbert_codes[i] == as::hilbert_encode(cells[i]));
+  }
+
+  const vec3 positions[] = {
+    vec3(0.0_r, 0.0_r, 0.0_r), vec3(1.0_r, 1.0_r, 1.0_r),
+    vec3(1.0_r, 0.0_r, 0.0_r)};
+  uint64_t position_codes[3];
+  as::morton_encode_positions(
+    positions, 3, vec3::zero(), vec3::one(), position_codes);
+  CHECK(position_codes[0] == 0);
+  CHECK(position_codes[1] == 0x7fffffffffffffff);
+  CHECK(position_codes[2] == as::morton_encode(vec3i(0x1fffff, 0, 0)));
+
+  const as::vec2f positions2f[] = {
+    as::vec2f(0.0f, 0.0f), as::vec2f(1.0f, 1.0f)};
+  uint64_t position_codes2f[2];
+  as::morton_encode_positions(
+    positions2f, 2, positions2f[0], positions2f[1], position_codes2f);
+  CHECK(position_codes2f[0] == 0);
+  CHECK(position_codes2f[1] == 0x3fffffffffffffff);
+
+  // positions in a plane and a single position
+  const vec3 flat_positions[] = {
+    vec3(0.0_r, 5.0_r, 0.0_r), vec3(1.0_r, 5.0_r, 1.0_r)};
+  uint64_t flat_codes[2];
+  as::morton_encode_positions(
+    flat_positions, 2, flat_positions[0], flat_positions[1], flat_codes);
+  CHECK(flat_codes[0] == 0);
+  CHECK(flat_codes[1] == as::morton_encode(vec3i(0x1fffff, 0, 0x1fffff)));
+  uint64_t point_code;
+  as::morton_encode_positions(
+    flat_positions, 1, flat_positions[0], flat_positions[0], &point_code);
+  CHECK(point_code == 0);
+}
+
+TEST_CASE("radix_sort", "[as_morton]")
+{
+  constexpr index count = as::k_radix_sort_chunk_size * 2 + 123;
+  std::mt19937_64 gen(7);
+  std::vector<uint64_t> keys(count);
+  for (auto& key : keys) {
+    // limited range to create duplicate keys
+    key = gen() & 0xffff00000fff;
+  }
+  std::vector<index> values(count);
+  std::iota(values.begin(), values.end(), index(0));
+  const std::vector<uint64_t> original_keys = keys;
+
+  as::radix_sort(keys.data(), values.data(), count);
+
+  CHECK(std::is_sorted(keys.begin(), keys.end()));
+  bool stable = true;
+  bool matching = true;
+  for (index i = 0; i < count; ++i) {
+    matching = matching && original_keys[values[i]] == keys[i];
+    if (i > 0 && keys[i] == keys[i - 1]) {
+      stable = stable && values[i] > values[i - 1];
+    }
+  }
+  CHECK(matching);
+  CHECK(stable);
+}
+
+TEST_CASE("radix_sort_key_bits", "[as_morton]")
+{
+  auto keys = arr<uint64_t>(0x105, 0x003, 0x101, 0x002);
+  auto values = arr(0, 1, 2, 3);
+
+  // only sort by the low 8 bits
+  as::radix_sort(keys.data(), values.data(), 4, 8);
+
+  CHECK(keys == arr<uint64_t>(0x101, 0x002, 0x003, 0x105));
+  CHECK(values == arr(2, 3, 1, 0));
+}
+
+} // namespace unit_test
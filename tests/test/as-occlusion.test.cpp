@@ -0,0 +1,208 @@
+#include "as-helpers.test.hpp"
+#include "as/as-occlusion.hpp"
+#include "as/as-view.hpp"
+#include "catch-matchers.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <random>
+#include <vector>
+
+namespace unit_test
+{
+
+// types
+using as::aabb;
+using as::affine;
+using as::index;
+using as::mat4;
+using as::real;
+using as::vec2;
+using as::vec2i;
+using as::vec3;
+
+// functions
+using as::radians;
+using as::operator""_r;
+
+TEST_CASE("depth_pyramid_build", "[as_occlusion]")
+{
+  as::raster_target target =
+    as::raster_target_create(vec2i(5, 3), vec2(0.0_r, 1.0_r));
+  for (index y = 0; y < 3; ++y) {
+    for (index x = 0; x < 5; ++x) {
+      target.depth[y * target.stride + x] = float(y * 5 + x) / 16.0f;
+    }
+  }
+
+  as::depth_pyramid pyramid;
+  as::depth_pyramid_build(pyramid, target);
+
+  REQUIRE(pyramid.level_dimensions.size() == 4);
+  CHECK(pyramid.level_dimensions[1] == vec2i(3, 2));
+  CHECK(pyramid.level_dimensions[2] == vec2i(2, 1));
+  CHECK(pyramid.level_dimensions[3] == vec2i(1, 1));
+  CHECK(pyramid.level_offsets[1] == 15);
+  CHECK(pyramid.level_offsets[3] == 15 + 6 + 2);
+  CHECK(pyramid.min_depth.size() == 15 + 6 + 2 + 1);
+
+  // the last column of level 1 only covers the last column of level 0
+  CHECK(pyramid.min_depth[15 + 2] == 4.0f / 16.0f);
+  CHECK(pyramid.max_depth[15 + 2] == 9.0f / 16.0f);
+  // the last row of level 1 only covers the last row of level 0
+  CHECK(pyramid.min_depth[15 + 3] == 10.0f / 16.0f);
+  CHECK(pyramid.max_depth[15 + 3] == 11.0f / 16.0f);
+  CHECK(pyramid.min_depth.back() == 0.0f);
+  CHECK(pyramid.max_depth.back() == 14.0f / 16.0f);
+
+  // existing storage is reused and results do not depend on the executor
+  as::depth_pyramid reversed = pyramid;
+  as::depth_pyramid_build(reversed, target, reverse_executor{});
+  CHECK(reversed.min_depth == pyramid.min_depth);
+  CHECK(reversed.max_depth == pyramid.max_depth);
+}
+
+TEST_CASE("occlusion_cull_aabbs", "[as_occlusion]")
+{
+  const vec2i dimension = vec2i(128, 64);
+  const real fov = radians(60.0_r);
+  const real aspect = 2.0_r;
+
+  struct convention
+  {
+    mat4 projection;
+    vec2 depth_range;
+  };
+  const convention conventions[] = {
+    {as::perspective_opengl_rh(fov, aspect, 0.1_r, 100.0_r),
+     vec2(-1.0_r, 1.0_r)},
+    {as::perspective_vulkan_rh(fov, aspect, 0.1_r, 100.0_r),
+     vec2(0.0_r, 1.0_r)},
+    {as::reverse_z(as::perspective_direct3d_rh(fov, aspect, 0.1_r, 100.0_r)),
+     vec2(1.0_r, 0.0_r)}};
+
+  // a wall in front of the camera
+  const vec3 positions[] = {
+    vec3(-4.0_r, -4.0_r, -10.0_r), vec3(4.0_r, -4.0_r, -10.0_r),
+    vec3(4.0_r, 4.0_r, -10.0_r), vec3(-4.0_r, 4.0_r, -10.0_r)};
+  const uint32_t indices[] = {0, 1, 2, 0, 2, 3};
+
+  const auto box = [](const vec3& center, const real half) {
+    return aabb(center - vec3(half), center + vec3(half));
+  };
+  const aabb boxes[] = {
+    box(vec3(0.0_r, 0.0_r, -20.0_r), 1.0_r), // behind the wall
+    box(vec3(2.0_r, -1.0_r, -40.0_r), 0.1_r), // small and behind the wall
+    box(vec3(1.0_r, 1.0_r, -15.0_r), 1.0_r), // just behind the wall
+    box(vec3(0.0_r, 0.0_r, -5.0_r), 0.5_r), // in front of the wall
+    box(vec3(14.0_r, 0.0_r, -20.0_r), 1.0_r), // beside the wall
+    box(vec3(0.0_r, 0.0_r, -20.0_r), 12.0_r), // larger than the wall
+    box(vec3(0.0_r, 0.0_r, 0.0_r), 1.0_r), // crossing the near plane
+    box(vec3(0.0_r, 0.0_r, 20.0_r), 1.0_r)}; // behind the camera
+  const bool occluded[] = {
+    true, true, true, false, false, false, false, false};
+  const index count = std::size(boxes);
+
+  std::vector<real> min_x, min_y, min_z, max_x, max_y, max_z;
+  for (const aabb& b : boxes) {
+    min_x.push_back(b.min.x);
+    min_y.push_back(b.min.y);
+    min_z.push_back(b.min.z);
+    max_x.push_back(b.max.x);
+    max_y.push_back(b.max.y);
+    max_z.push_back(b.max.z);
+  }
+  const as::aabb_soa_t<real> soa = {min_x.data(), min_y.data(), min_z.data(),
+                                    max_x.data(), max_y.data(), max_z.data()};
+
+  for (const convention& c : conventions) {
+    as::raster_target target =
+      as::raster_target_create(dimension, c.depth_range);
+    as::rasterize_triangles(target, c.projection, positions, indices, 2);
+    as::depth_pyramid pyramid;
+    as::depth_pyramid_build(pyramid, target);
+
+    uint32_t visibility = 0;
+    as::occlusion_cull_aabbs(pyramid, c.projection, soa, count, &visibility);
+    for (index i = 0; i < count; ++i) {
+      CHECK(
+        as::depth_pyramid_occludes_aabb(pyramid, c.projection, boxes[i])
+        == occluded[i]);
+      CHECK(((visibility >> i) & 1) == uint32_t(!occluded[i]));
+    }
+  }
+}
+
+TEST_CASE("occlusion_cull_aabbs_executor", "[as_occlusion]")
+{
+  const vec2i dimension = vec2i(96, 64);
+  const mat4 projection = as::perspective_direct3d_lh(
+    radians(60.0_r), 96.0_r / 64.0_r, 0.1_r, 100.0_r);
+  const affine view = as::affine_inverse(affine(vec3(0.0_r, 0.0_r, -3.0_r)));
+  const mat4 view_projection = as::view_projection(view, projection);
+
+  // a field of random occluders
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<real> xy(-8.0_r, 8.0_r);
+  std::uniform_real_distribution<real> depth(4.0_r, 30.0_r);
+  std::uniform_real_distribution<real> extent(0.05_r, 2.0_r);
+  std::vector<vec3> positions;
+  std::vector<uint32_t> indices;
+  for (index q = 0; q < 40; ++q) {
+    const vec3 center = vec3(xy(gen), xy(gen), depth(gen));
+    const real half = extent(gen) * 2.0_r;
+    const auto first = uint32_t(positions.size());
+    positions.push_back(center + vec3(-half, -half, 0.0_r));
+    positions.push_back(center + vec3(half, -half, 0.0_r));
+    positions.push_back(center + vec3(half, half, 0.0_r));
+    positions.push_back(center + vec3(-half, half, 0.0_r));
+    indices.insert(
+      indices.end(),
+      {first, first + 1, first + 2, first, first + 2, first + 3});
+  }
+  as::raster_target target =
+    as::raster_target_create(dimension, vec2(0.0_r, 1.0_r));
+  as::rasterize_triangles(
+    target, view_projection, positions.data(), indices.data(), 80);
+  as::depth_pyramid pyramid;
+  as::depth_pyramid_build(pyramid, target);
+
+  const index count = as::k_cull_chunk_size + 300;
+  std::vector<real> min_x, min_y, min_z, max_x, max_y, max_z;
+  std::vector<aabb> boxes;
+  for (index i = 0; i < count; ++i) {
+    const vec3 center = vec3(xy(gen), xy(gen), depth(gen) + 5.0_r);
+    const vec3 half = vec3(extent(gen), extent(gen), extent(gen));
+    boxes.emplace_back(center - half, center + half);
+    min_x.push_back(boxes.back().min.x);
+    min_y.push_back(boxes.back().min.y);
+    min_z.push_back(boxes.back().min.z);
+    max_x.push_back(boxes.back().max.x);
+    max_y.push_back(boxes.back().max.y);
+    max_z.push_back(boxes.back().max.z);
+  }
+  const as::aabb_soa_t<real> soa = {min_x.data(), min_y.data(), min_z.data(),
+                                    max_x.data(), max_y.data(), max_z.data()};
+
+  std::vector<uint32_t> serial(as::chunk_count(count, 32));
+  as::occlusion_cull_aabbs(
+    pyramid, view_projection, soa, count, serial.data());
+  std::vector<uint32_t> reversed(as::chunk_count(count, 32));
+  as::occlusion_cull_aabbs(
+    pyramid, view_projection, soa, count, reversed.data(),
+    reverse_executor{});
+  CHECK(serial == reversed);
+
+  index occluded_count = 0;
+  bool matches = true;
+  for (index i = 0; i < count; ++i) {
+    const bool occluded =
+      as::depth_pyramid_occludes_aabb(pyramid, view_projection, boxes[i]);
+    occluded_count += occluded;
+    matches = matches && ((serial[i / 32] >> (i % 32)) & 1) == !occluded;
+  }
+  CHECK(matches);
+  CHECK(occluded_count > 0);
+  CHECK(occluded_count < count);
+}
+
+} // namespace unit_test
@@ -0,0 +1,217 @@
+#include "as-helpers.test.hpp"
+#include "as/as-pack.hpp"
+#include "catch-matchers.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <random>
+#include <vector>
+
+namespace unit_test
+{
+
+// testing
+using Catch::Approx;
+
+// types
+using as::index;
+using as::quat;
+using as::real;
+using as::vec3;
+
+// functions
+using as::operator""_r;
+
+// the angle between two rotations
+static real rotation_angle(const quat& lhs, const quat& rhs)
+{
+  const quat difference = as::quat_conjugate(lhs) * rhs;
+  return 2.0_r
+       * std::atan2(
+           std::sqrt(
+             difference.x * difference.x + difference.y * difference.y
+             + difference.z * difference.z),
+           std::abs(difference.w));
+}
+
+// the angle between two directions
+static real direction_angle(const vec3& lhs, const vec3& rhs)
+{
+  return std::atan2(
+    as::vec_length(as::vec3_cross(lhs, rhs)), as::vec_dot(lhs, rhs));
+}
+
+// unit quaternions spread over every orientation and those with components
+// that are equal, zero or the largest possible
+static std::vector<quat> pack_quats()
+{
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<real> dist(-1.0_r, 1.0_r);
+  std::vector<quat> quats;
+  for (index i = 0; i < 20000; ++i) {
+    quats.push_back(
+      as::quat_normalize(quat(dist(gen), dist(gen), dist(gen), dist(gen))));
+  }
+  quats.push_back(quat(1.0_r, 0.0_r, 0.0_r, 0.0_r));
+  quats.push_back(quat(0.0_r, 1.0_r, 0.0_r, 0.0_r));
+  quats.push_back(quat(0.0_r, 0.0_r, -1.0_r, 0.0_r));
+  quats.push_back(quat(0.0_r, 0.0_r, 0.0_r, 1.0_r));
+  quats.push_back(quat(0.5_r, -0.5_r, 0.5_r, -0.5_r));
+  quats.push_back(as::quat_normalize(quat(1.0_r, 1.0_r, 0.0_r, 0.0_r)));
+  return quats;
+}
+
+// unit vectors spread over every direction and along each axis
+static std::vector<vec3> pack_directions()
+{
+  std::mt19937 gen(13);
+  std::uniform_real_distribution<real> dist(-1.0_r, 1.0_r);
+  std::vector<vec3> directions;
+  for (index i = 0; i < 20000; ++i) {
+    directions.push_back(
+      as::vec_normalize(vec3(dist(gen), dist(gen), dist(gen))));
+  }
+  for (index axis = 0; axis < 3; ++axis) {
+    directions.push_back(vec3::zero());
+    directions.back()[axis] = 1.0_r;
+    directions.push_back(vec3::zero());
+    directions.back()[axis] = -1.0_r;
+  }
+  directions.push_back(as::vec_normalize(vec3(1.0_r, -1.0_r, -1.0_r)));
+  return directions;
+}
+
+// returns the largest angle between each quaternion and its packed and
+// unpacked quaternion (and checks batches match single quaternions)
+template<typename Packed, typename Pack, typename Unpack>
+static real pack_quats_max_angle(
+  const std::vector<quat>& quats, const Pack& pack, const Unpack& unpack)
+{
+  const auto count = index(quats.size());
+  std::vector<Packed> packed(count);
+  std::vector<quat> unpacked(count);
+  pack(quats.data(), count, packed.data());
+  unpack(packed.data(), count, unpacked.data());
+  real max_angle = 0.0_r;
+  for (index i = 0; i < count; ++i) {
+    CHECK(packed[i] == pack(quats[i]));
+    CHECK(as::quat_near(unpacked[i], unpack(packed[i]), 0.0_r));
+    CHECK(as::quat_length(unpacked[i]) == Approx(1.0_r).margin(1e-5_r));
+    max_angle = std::max(max_angle, rotation_angle(quats[i], unpacked[i]));
+  }
+  return max_angle;
+}
+
+// returns the largest angle between each direction and its packed and
+// unpacked direction (and checks batches match single directions)
+template<typename Packed, typename Pack, typename Unpack>
+static real pack_directions_max_angle(
+  const std::vector<vec3>& directions, const Pack& pack, const Unpack& unpack)
+{
+  const auto count = index(directions.size());
+  std::vector<Packed> packed(count);
+  std::vector<vec3> unpacked(count);
+  pack(directions.data(), count, packed.data());
+  unpack(packed.data(), count, unpacked.data());
+  real max_angle = 0.0_r;
+  for (index i = 0; i < count; ++i) {
+    CHECK(packed[i] == pack(directions[i]));
+    CHECK(as::vec_near(unpacked[i], unpack(packed[i]), 0.0_r));
+    CHECK(as::vec_length(unpacked[i]) == Approx(1.0_r).margin(1e-5_r));
+    max_angle =
+      std::max(max_angle, direction_angle(directions[i], unpacked[i]));
+  }
+  return max_angle;
+}
+
+TEST_CASE("quat_pack_smallest3", "[as_pack]")
+{
+  const std::vector<quat> quats = pack_quats();
+
+  const auto pack32 = [](const auto&... args) {
+    return as::quat_pack_smallest3_32(args...);
+  };
+  const auto unpack32 = [](const auto&... args) {
+    return as::quat_unpack_smallest3_32(args...);
+  };
+  CHECK(pack_quats_max_angle<uint32_t>(quats, pack32, unpack32) < 0.005_r);
+
+  const auto pack48 = [](const auto&... args) {
+    return as::quat_pack_smallest3_48(args...);
+  };
+  const auto unpack48 = [](const auto&... args) {
+    return as::quat_unpack_smallest3_48(args...);
+  };
+  CHECK(pack_quats_max_angle<uint64_t>(quats, pack48, unpack48) < 0.00015_r);
+  for (const quat& q : quats) {
+    CHECK(as::quat_pack_smallest3_48(q) < (uint64_t(1) << 48));
+  }
+
+  const auto pack64 = [](const auto&... args) {
+    return as::quat_pack_smallest3_64(args...);
+  };
+  const auto unpack64 = [](const auto&... args) {
+    return as::quat_unpack_smallest3_64(args...);
+  };
+  CHECK(
+    pack_quats_max_angle<uint64_t>(quats, pack64, unpack64) < 0.000005_r);
+  for (const quat& q : quats) {
+    CHECK(as::quat_pack_smallest3_64(q) < (uint64_t(1) << 62));
+  }
+
+  // negated quaternions represent the same rotation
+  const quat q = as::quat_rotation_xyz(
+    as::radians(10.0_r), as::radians(200.0_r), as::radians(30.0_r));
+  CHECK(as::quat_pack_smallest3_32(q) == as::quat_pack_smallest3_32(-q));
+  CHECK(as::quat_pack_smallest3_48(q) == as::quat_pack_smallest3_48(-q));
+  CHECK(as::quat_pack_smallest3_64(q) == as::quat_pack_smallest3_64(-q));
+}
+
+TEST_CASE("vec3_pack_octahedral", "[as_pack]")
+{
+  const std::vector<vec3> directions = pack_directions();
+
+  const auto pack16 = [](const auto&... args) {
+    return as::vec3_pack_octahedral_16(args...);
+  };
+  const auto unpack16 = [](const auto&... args) {
+    return as::vec3_unpack_octahedral_16(args...);
+  };
+  CHECK(
+    pack_directions_max_angle<uint16_t>(directions, pack16, unpack16)
+    < 0.017_r);
+
+  const auto pack24 = [](const auto&... args) {
+    return as::vec3_pack_octahedral_24(args...);
+  };
+  const auto unpack24 = [](const auto&... args) {
+    return as::vec3_unpack_octahedral_24(args...);
+  };
+  CHECK(
+    pack_directions_max_angle<uint32_t>(directions, pack24, unpack24)
+    < 0.0011_r);
+  for (const vec3& direction : directions) {
+    CHECK(as::vec3_pack_octahedral_24(direction) < (uint32_t(1) << 24));
+  }
+
+  const auto pack32 = [](const auto&... args) {
+    return as::vec3_pack_octahedral_32(args...);
+  };
+  const auto unpack32 = [](const auto&... args) {
+    return as::vec3_unpack_octahedral_32(args...);
+  };
+  CHECK(
+    pack_directions_max_angle<uint32_t>(directions, pack32, unpack32)
+    < 0.00007_r);
+
+  // the poles and corners of the folded square
+  CHECK(as::vec_near(
+    as::vec3_unpack_octahedral_32(
+      as::vec3_pack_octahedral_32(vec3(0.0_r, 0.0_r, -1.0_r))),
+    vec3(0.0_r, 0.0_r, -1.0_r), 1e-4_r));
+  CHECK(as::vec_near(
+    as::vec3_unpack_octahedral_16(
+      as::vec3_pack_octahedral_16(vec3(0.0_r, 0.0_r, 1.0_r))),
+    vec3(0.0_r, 0.0_r, 1.0_r), 0.01_r));
+}
+
+} // namespace unit_test
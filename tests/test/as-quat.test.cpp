@@ -397,6 +397,43 @@ TEST_CASE("quat_slerp", "[as_quat]")
   }
 }
 
+TEST_CASE("quat_log_exp", "[as_quat]")
+{
+  {
+    const quat log = as::quat_log(quat::identity());
+    CHECK(log.w == Approx(0.0_r).margin(g_epsilon));
+    CHECK(log.x == Approx(0.0_r).margin(g_epsilon));
+    CHECK(log.y == Approx(0.0_r).margin(g_epsilon));
+    CHECK(log.z == Approx(0.0_r).margin(g_epsilon));
+  }
+
+  {
+    const quat log =
+      as::quat_log(quat_rotation_axis(vec3::axis_x(), radians(90.0_r)));
+    CHECK(log.w == Approx(0.0_r).margin(g_epsilon));
+    CHECK(log.x == Approx(radians(45.0_r)).epsilon(g_epsilon));
+    CHECK(log.y == Approx(0.0_r).margin(g_epsilon));
+    CHECK(log.z == Approx(0.0_r).margin(g_epsilon));
+  }
+
+  {
+    const quat exp = as::quat_exp(quat(0.0_r, 0.0_r, radians(30.0_r), 0.0_r));
+    const quat expected = quat_rotation_axis(vec3::axis_y(), radians(60.0_r));
+    CHECK(as::quat_near(exp, expected));
+  }
+
+  {
+    const quat exp = as::quat_exp(quat(0.0_r, 0.0_r, 0.0_r, 0.0_r));
+    CHECK(as::quat_near(exp, quat::identity()));
+  }
+
+  {
+    const quat q = as::quat_rotation_xyz(
+      radians(20.0_r), radians(-130.0_r), radians(75.0_r)) * 2.0_r;
+    CHECK(as::quat_near(as::quat_exp(as::quat_log(q)), q, k_quat_epsilon));
+  }
+}
+
 TEST_CASE("quat_from_mat3", "[as_quat]")
 {
   using gsl::make_span;
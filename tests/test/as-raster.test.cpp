@@ -0,0 +1,279 @@
+#include "as-helpers.test.hpp"
+#include "as/as-raster.hpp"
+#include "as/as-view.hpp"
+#include "catch-matchers.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <random>
+#include <vector>
+
+namespace unit_test
+{
+
+// testing
+using Catch::Approx;
+
+// types
+using as::affine;
+using as::index;
+using as::mat4;
+using as::real;
+using as::vec2;
+using as::vec2i;
+using as::vec3;
+
+// functions
+using as::radians;
+using as::operator""_r;
+
+// appends a grid of quads (two triangles each) covering [min, max] in x and y
+// at depth z
+static void append_grid(
+  const vec2& min, const vec2& max, const real z, const index cells_x,
+  const index cells_y, std::vector<vec3>& positions,
+  std::vector<uint32_t>& indices)
+{
+  const auto first = uint32_t(positions.size());
+  for (index y = 0; y <= cells_y; ++y) {
+    for (index x = 0; x <= cells_x; ++x) {
+      positions.emplace_back(
+        min.x + (max.x - min.x) * real(x) / real(cells_x),
+        min.y + (max.y - min.y) * real(y) / real(cells_y), z);
+    }
+  }
+  const auto row = uint32_t(cells_x + 1);
+  for (index y = 0; y < cells_y; ++y) {
+    for (index x = 0; x < cells_x; ++x) {
+      const uint32_t i = first + uint32_t(y) * row + uint32_t(x);
+      indices.insert(indices.end(), {i, i + 1, i + row + 1});
+      indices.insert(indices.end(), {i, i + row + 1, i + row});
+    }
+  }
+}
+
+TEST_CASE("raster_target_create", "[as_raster]")
+{
+  const as::raster_target target =
+    as::raster_target_create(vec2i(13, 5), vec2(1.0_r, 0.0_r));
+  CHECK(target.stride == 16);
+  CHECK(target.depth.size() == 16 * 5);
+  CHECK(target.depth[0] == 0.0f);
+  CHECK(target.primitive[0] == as::k_raster_no_primitive);
+
+  const as::raster_target forward =
+    as::raster_target_create(vec2i(16, 5), vec2(-1.0_r, 1.0_r));
+  CHECK(forward.stride == 16);
+  CHECK(forward.depth[0] == 1.0f);
+}
+
+TEST_CASE("rasterize_triangles_watertight", "[as_raster]")
+{
+  // an orthographic projection of a grid larger than the screen (edges
+  // shared by neighboring triangles run through pixel centers)
+  const vec2i dimension = vec2i(40, 24);
+  const mat4 projection =
+    as::ortho_direct3d_lh(0.0_r, 40.0_r, 0.0_r, 24.0_r, 0.0_r, 10.0_r);
+  std::vector<vec3> positions;
+  std::vector<uint32_t> indices;
+  append_grid(
+    vec2(-2.5_r, -3.5_r), vec2(42.5_r, 26.5_r), 5.0_r, 9, 6, positions,
+    indices);
+  const index triangle_count = index(indices.size()) / 3;
+
+  // every pixel is covered by exactly one triangle
+  std::vector<int32_t> coverage(index(dimension.x) * dimension.y, 0);
+  for (index t = 0; t < triangle_count; ++t) {
+    as::raster_target target =
+      as::raster_target_create(dimension, vec2(0.0_r, 1.0_r));
+    as::rasterize_triangles(
+      target, projection, positions.data(), indices.data() + t * 3, 1);
+    for (index y = 0; y < dimension.y; ++y) {
+      for (index x = 0; x < dimension.x; ++x) {
+        coverage[y * dimension.x + x] +=
+          target.primitive[y * target.stride + x] != as::k_raster_no_primitive;
+      }
+    }
+  }
+  CHECK(std::all_of(coverage.begin(), coverage.end(), [](const int32_t c) {
+    return c == 1;
+  }));
+}
+
+TEST_CASE("rasterize_triangles_depth_test", "[as_raster]")
+{
+  const vec2i dimension = vec2i(64, 48);
+  const real fov = radians(60.0_r);
+  const real aspect = 64.0_r / 48.0_r;
+
+  struct convention
+  {
+    mat4 projection;
+    vec2 depth_range;
+  };
+  const convention conventions[] = {
+    {as::perspective_opengl_rh(fov, aspect, 0.1_r, 100.0_r),
+     vec2(-1.0_r, 1.0_r)},
+    {as::perspective_vulkan_rh(fov, aspect, 0.1_r, 100.0_r),
+     vec2(0.0_r, 1.0_r)},
+    {as::reverse_z(as::perspective_direct3d_rh(fov, aspect, 0.1_r, 100.0_r)),
+     vec2(1.0_r, 0.0_r)}};
+
+  // a far quad covering the screen and a near quad covering the center
+  std::vector<vec3> positions;
+  std::vector<uint32_t> indices;
+  append_grid(
+    vec2(-20.0_r, -20.0_r), vec2(20.0_r, 20.0_r), -10.0_r, 1, 1, positions,
+    indices);
+  append_grid(
+    vec2(-1.0_r, -1.0_r), vec2(1.0_r, 1.0_r), -5.0_r, 1, 1, positions,
+    indices);
+  // the same triangles with the near quad first
+  std::vector<uint32_t> reordered(indices.begin() + 6, indices.end());
+  reordered.insert(reordered.end(), indices.begin(), indices.begin() + 6);
+
+  for (const convention& c : conventions) {
+    as::raster_target target =
+      as::raster_target_create(dimension, c.depth_range);
+    as::rasterize_triangles(
+      target, c.projection, positions.data(), indices.data(), 4);
+    as::raster_target reordered_target =
+      as::raster_target_create(dimension, c.depth_range);
+    as::rasterize_triangles(
+      reordered_target, c.projection, positions.data(), reordered.data(), 4,
+      reverse_executor{});
+
+    const index center = 24 * target.stride + 32;
+    CHECK(target.primitive[center] >= 2);
+    CHECK(reordered_target.primitive[center] < 2);
+    CHECK(target.depth == reordered_target.depth);
+    CHECK(target.primitive[0] < 2);
+    CHECK(reordered_target.primitive[0] >= 2);
+
+    // depth matches the view space depth of the quads
+    std::vector<real> x(target.depth.size());
+    std::vector<real> y(target.depth.size());
+    std::vector<real> z(target.depth.size());
+    as::depth_buffer_to_world(
+      target.depth.data(), dimension, c.projection, affine::identity(),
+      c.depth_range, x.data(), y.data(), z.data());
+    CHECK(z[center] == Approx(-5.0_r).epsilon(1e-3_r));
+    CHECK(z[0] == Approx(-10.0_r).epsilon(1e-3_r));
+  }
+}
+
+TEST_CASE("rasterize_triangles_near_clip", "[as_raster]")
+{
+  // a ground plane extending behind the camera
+  const vec2i dimension = vec2i(96, 64);
+  const mat4 projection = as::perspective_direct3d_rh(
+    radians(70.0_r), 96.0_r / 64.0_r, 0.5_r, 200.0_r);
+  const affine camera = affine(vec3(0.0_r, 2.0_r, 0.0_r));
+  const affine view = as::affine_inverse(camera);
+  const mat4 view_projection = as::view_projection(view, projection);
+
+  std::vector<vec3> positions = {
+    vec3(-100.0_r, 0.0_r, 100.0_r), vec3(100.0_r, 0.0_r, 100.0_r),
+    vec3(100.0_r, 0.0_r, -100.0_r), vec3(-100.0_r, 0.0_r, -100.0_r)};
+  std::vector<uint32_t> indices = {0, 1, 2, 0, 2, 3};
+
+  as::raster_target target =
+    as::raster_target_create(dimension, vec2(0.0_r, 1.0_r));
+  as::rasterize_triangles(
+    target, view_projection, positions.data(), indices.data(), 2);
+
+  std::vector<real> x(target.depth.size());
+  std::vector<real> y(target.depth.size());
+  std::vector<real> z(target.depth.size());
+  as::depth_buffer_to_world(
+    target.depth.data(), dimension, projection, view, vec2(0.0_r, 1.0_r),
+    x.data(), y.data(), z.data());
+
+  // the bottom half of the screen sees the ground, the top half is empty (the
+  // far edge of the ground is just below the horizon at the center row)
+  bool on_ground = true;
+  for (index py = 0; py < dimension.y; ++py) {
+    for (index px = 0; px < dimension.x; ++px) {
+      const index i = py * target.stride + px;
+      const bool covered = target.primitive[i] != as::k_raster_no_primitive;
+      if (py < dimension.y / 2) {
+        CHECK(!covered);
+      } else if (py > dimension.y / 2) {
+        CHECK(covered);
+      }
+      if (covered) {
+        on_ground = on_ground && std::abs(y[i]) < 1e-2_r;
+      }
+    }
+  }
+  CHECK(on_ground);
+}
+
+TEST_CASE("rasterize_triangles_executor", "[as_raster]")
+{
+  const vec2i dimension = vec2i(200, 150);
+  const mat4 projection = as::perspective_vulkan_lh(
+    radians(60.0_r), 200.0_r / 150.0_r, 0.1_r, 100.0_r);
+
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<real> xy(-6.0_r, 6.0_r);
+  std::uniform_real_distribution<real> depth(2.0_r, 12.0_r);
+  std::uniform_real_distribution<real> offset(-1.5_r, 1.5_r);
+  const index triangle_count = as::k_raster_chunk_size + 500;
+  std::vector<vec3> positions;
+  std::vector<uint32_t> indices;
+  for (index t = 0; t < triangle_count; ++t) {
+    const vec3 center = vec3(xy(gen), xy(gen), depth(gen));
+    for (index v = 0; v < 3; ++v) {
+      indices.push_back(uint32_t(positions.size()));
+      positions.push_back(
+        center + vec3(offset(gen), offset(gen), offset(gen) * 0.1_r));
+    }
+  }
+
+  as::raster_target serial =
+    as::raster_target_create(dimension, vec2(0.0_r, 1.0_r));
+  as::rasterize_triangles(
+    serial, projection, positions.data(), indices.data(), triangle_count);
+  as::raster_target reversed =
+    as::raster_target_create(dimension, vec2(0.0_r, 1.0_r));
+  as::rasterize_triangles(
+    reversed, projection, positions.data(), indices.data(), triangle_count,
+    reverse_executor{});
+
+  CHECK(serial.depth == reversed.depth);
+  CHECK(serial.primitive == reversed.primitive);
+
+  // the primitive written to a pixel covers its center and is the closest
+  const mat4 inverse_projection = as::mat_inverse(projection);
+  index covered = 0;
+  bool depths_match = true;
+  for (index py = 0; py < dimension.y; py += 7) {
+    for (index px = 0; px < dimension.x; px += 7) {
+      const index i = py * serial.stride + px;
+      if (serial.primitive[i] == as::k_raster_no_primitive) {
+        continue;
+      }
+      ++covered;
+      const as::vec4 ndc = as::vec4(
+        (real(px) + 0.5_r) / real(dimension.x) * 2.0_r - 1.0_r,
+        1.0_r - (real(py) + 0.5_r) / real(dimension.y) * 2.0_r,
+        serial.depth[i], 1.0_r);
+      as::vec4 view_position = as::mat_mul(ndc, inverse_projection);
+      view_position /= view_position.w;
+      // the point lies on the plane of the primitive
+      const uint32_t p = serial.primitive[i];
+      const vec3 v0 = positions[indices[p * 3]];
+      const vec3 v1 = positions[indices[p * 3 + 1]];
+      const vec3 v2 = positions[indices[p * 3 + 2]];
+      const vec3 normal = as::vec_normalize(as::vec3_cross(v1 - v0, v2 - v0));
+      depths_match = depths_match
+                  && std::abs(as::vec_dot(
+                       as::vec3_from_vec4(view_position) - v0, normal))
+                       < 1e-2_r;
+    }
+  }
+  CHECK(covered > 0);
+  CHECK(depths_match);
+}
+
+} // namespace unit_test
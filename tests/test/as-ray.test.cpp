@@ -0,0 +1,272 @@
+#include "as-helpers.test.hpp"
+#include "as/as-ray-packet.hpp"
+#include "catch-matchers.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <random>
+
+namespace unit_test
+{
+
+// testing
+using Catch::Approx;
+
+// types
+using as::aabb;
+using as::index;
+using as::ray;
+using as::real;
+using as::vec2;
+using as::vec3;
+
+// functions
+using as::operator""_r;
+
+[[maybe_unused]] constexpr auto ray_type_check =
+  unit_test::trivial_standard_layout_check<ray>();
+
+TEST_CASE("ray_constructor", "[as_ray]")
+{
+  const ray r(vec3(1.0_r, 2.0_r, 3.0_r), vec3(2.0_r, -4.0_r, 0.5_r));
+  CHECK_THAT(arr(1.0_r, 2.0_r, 3.0_r), elements_are_array(r.origin));
+  CHECK_THAT(arr(2.0_r, -4.0_r, 0.5_r), elements_are_array(r.direction));
+  CHECK_THAT(arr(0.5_r, -0.25_r, 2.0_r), elements_are_array(r.inv_direction));
+  CHECK_THAT(
+    arr(5.0_r, -6.0_r, 4.0_r), elements_are_array(as::ray_point(r, 2.0_r)));
+}
+
+TEST_CASE("ray_intersect_aabb", "[as_ray]")
+{
+  const aabb bounds(vec3(-1.0_r), vec3(1.0_r));
+
+  {
+    const auto [hit, distance] = as::ray_intersect_aabb(
+      ray(vec3(-5.0_r, 0.0_r, 0.0_r), vec3::axis_x()), bounds);
+    CHECK(hit);
+    CHECK(distance == Approx(4.0_r));
+  }
+
+  {
+    // axis aligned ray with zero components (infinite reciprocal)
+    const auto [hit, distance] = as::ray_intersect_aabb(
+      ray(vec3(0.5_r, 0.5_r, 5.0_r), -vec3::axis_z()), bounds);
+    CHECK(hit);
+    CHECK(distance == Approx(4.0_r));
+  }
+
+  {
+    // origin inside box
+    const auto [hit, distance] =
+      as::ray_intersect_aabb(ray(vec3::zero(), vec3::axis_y()), bounds);
+    CHECK(hit);
+    CHECK(distance == Approx(0.0_r));
+  }
+
+  {
+    // box behind ray
+    const auto [hit, distance] = as::ray_intersect_aabb(
+      ray(vec3(5.0_r, 0.0_r, 0.0_r), vec3::axis_x()), bounds);
+    CHECK(!hit);
+  }
+
+  {
+    // miss
+    const auto [hit, distance] = as::ray_intersect_aabb(
+      ray(vec3(-5.0_r, 2.0_r, 0.0_r), vec3::axis_x()), bounds);
+    CHECK(!hit);
+  }
+
+  {
+    // beyond max distance
+    const auto [hit, distance] = as::ray_intersect_aabb(
+      ray(vec3(-5.0_r, 0.0_r, 0.0_r), vec3::axis_x()), bounds, 3.0_r);
+    CHECK(!hit);
+  }
+}
+
+TEST_CASE("ray_intersect_triangle", "[as_ray]")
+{
+  const vec3 v0(0.0_r, 0.0_r, 0.0_r);
+  const vec3 v1(2.0_r, 0.0_r, 0.0_r);
+  const vec3 v2(0.0_r, 2.0_r, 0.0_r);
+
+  {
+    const auto [hit, distance, uv] = as::ray_intersect_triangle(
+      ray(vec3(0.5_r, 1.0_r, 3.0_r), -vec3::axis_z()), v0, v1, v2);
+    CHECK(hit);
+    CHECK(distance == Approx(3.0_r));
+    CHECK_THAT(arr(0.25_r, 0.5_r), elements_are_array(uv));
+  }
+
+  {
+    // double sided
+    const auto [hit, distance, uv] = as::ray_intersect_triangle(
+      ray(vec3(0.5_r, 0.5_r, -2.0_r), vec3::axis_z()), v0, v1, v2);
+    CHECK(hit);
+    CHECK(distance == Approx(2.0_r));
+  }
+
+  {
+    // outside edge
+    const auto [hit, distance, uv] = as::ray_intersect_triangle(
+      ray(vec3(1.5_r, 1.5_r, 3.0_r), -vec3::axis_z()), v0, v1, v2);
+    CHECK(!hit);
+  }
+
+  {
+    // parallel
+    const auto [hit, distance, uv] = as::ray_intersect_triangle(
+      ray(vec3(0.5_r, 0.5_r, 1.0_r), vec3::axis_x()), v0, v1, v2);
+    CHECK(!hit);
+  }
+
+  {
+    // behind
+    const auto [hit, distance, uv] = as::ray_intersect_triangle(
+      ray(vec3(0.5_r, 0.5_r, 3.0_r), vec3::axis_z()), v0, v1, v2);
+    CHECK(!hit);
+  }
+
+  {
+    // beyond max distance
+    const auto [hit, distance, uv] = as::ray_intersect_triangle(
+      ray(vec3(0.5_r, 0.5_r, 3.0_r), -vec3::axis_z()), v0, v1, v2, 2.0_r);
+    CHECK(!hit);
+  }
+}
+
+// compares each lane of a packet to the single ray functions
+template<index N>
+static void check_ray_packet(std::mt19937& gen)
+{
+  std::uniform_real_distribution<real> position(-4.0_r, 4.0_r);
+  const auto random_vec3 = [&] {
+    return vec3(position(gen), position(gen), position(gen));
+  };
+
+  ray rays[N];
+  for (index i = 0; i < N; ++i) {
+    const vec3 origin = random_vec3() + vec3(0.0_r, 0.0_r, 8.0_r);
+    const vec3 target = random_vec3() * 0.5_r;
+    rays[i] = ray(origin, as::vec_normalize(target - origin));
+  }
+  const auto packet = as::ray_packet_from_rays<N>(rays);
+  for (index i = 0; i < N; ++i) {
+    const ray lane = as::ray_packet_get(packet, i);
+    CHECK(as::vec_near(lane.origin, rays[i].origin));
+    CHECK(as::vec_near(lane.direction, rays[i].direction));
+  }
+
+  const aabb bounds(vec3(-1.0_r), vec3(1.0_r, 2.0_r, 1.5_r));
+  real max_distance[N];
+  real entry[N];
+  for (index i = 0; i < N; ++i) {
+    max_distance[i] = 100.0_r;
+  }
+  const uint32_t aabb_mask =
+    as::ray_packet_intersect_aabb(packet, bounds, max_distance, entry);
+  for (index i = 0; i < N; ++i) {
+    const auto [hit, distance] = as::ray_intersect_aabb(rays[i], bounds);
+    CHECK(((aabb_mask >> i) & 1) == uint32_t(hit));
+    if (hit) {
+      CHECK(entry[i] == Approx(distance));
+    }
+  }
+
+  real closest[N];
+  real u[N] = {};
+  real v[N] = {};
+  for (index i = 0; i < N; ++i) {
+    closest[i] = 100.0_r;
+  }
+  const vec3 v0 = random_vec3();
+  const vec3 v1 = random_vec3();
+  const vec3 v2 = random_vec3();
+  const uint32_t triangle_mask =
+    as::ray_packet_intersect_triangle(packet, v0, v1, v2, closest, u, v);
+  for (index i = 0; i < N; ++i) {
+    const auto [hit, distance, uv] =
+      as::ray_intersect_triangle(rays[i], v0, v1, v2, 100.0_r);
+    CHECK(((triangle_mask >> i) & 1) == uint32_t(hit));
+    if (hit) {
+      CHECK(closest[i] == Approx(distance));
+      CHECK(u[i] == Approx(uv.x));
+      CHECK(v[i] == Approx(uv.y));
+    } else {
+      CHECK(closest[i] == 100.0_r);
+    }
+  }
+}
+
+TEST_CASE("ray_packet", "[as_ray]")
+{
+  CHECK(as::ray_packet4::size() == 4);
+  CHECK(as::ray_packet16::size() == 16);
+
+  std::mt19937 gen(17);
+  for (index i = 0; i < 100; ++i) {
+    check_ray_packet<4>(gen);
+    check_ray_packet<8>(gen);
+    check_ray_packet<16>(gen);
+  }
+}
+
+TEST_CASE("ray_packet_closest_hit", "[as_ray]")
+{
+  as::ray_packet4 packet;
+  for (index i = 0; i < 4; ++i) {
+    as::ray_packet_set(
+      packet, i, ray(vec3(real(i) * 0.1_r, 0.1_r, 10.0_r), -vec3::axis_z()));
+  }
+
+  real distance[4] = {100.0_r, 100.0_r, 100.0_r, 5.0_r};
+  real u[4] = {};
+  real v[4] = {};
+  const vec3 v0(0.0_r, 0.0_r, 0.0_r);
+  const vec3 v1(1.0_r, 0.0_r, 0.0_r);
+  const vec3 v2(0.0_r, 1.0_r, 0.0_r);
+  // far triangle then near triangle
+  CHECK(
+    as::ray_packet_intersect_triangle(packet, v0, v1, v2, distance, u, v)
+    == 0b0111);
+  const vec3 offset(0.0_r, 0.0_r, 2.0_r);
+  CHECK(
+    as::ray_packet_intersect_triangle(
+      packet, v0 + offset, v1 + offset, v2 + offset, distance, u, v)
+    == 0b0111);
+  CHECK(distance[0] == Approx(8.0_r));
+  CHECK(distance[1] == Approx(8.0_r));
+  CHECK(distance[2] == Approx(8.0_r));
+  CHECK(distance[3] == Approx(5.0_r));
+}
+
+TEST_CASE("ray_packet_intersect_triangle_at_max_distance", "[as_ray]")
+{
+  const vec3 v0(0.0_r, 0.0_r, 0.0_r);
+  const vec3 v1(2.0_r, 0.0_r, 0.0_r);
+  const vec3 v2(0.0_r, 2.0_r, 0.0_r);
+  const ray r(vec3(0.5_r, 1.0_r, 3.0_r), -vec3::axis_z());
+
+  as::ray_packet4 packet;
+  for (index i = 0; i < 4; ++i) {
+    as::ray_packet_set(packet, i, r);
+  }
+  // a hit exactly at the limit is kept by both the single ray and the packet
+  real distance[4] = {3.0_r, 3.0_r, 3.0_r, 3.0_r};
+  real u[4] = {};
+  real v[4] = {};
+  const auto [hit, single_distance, uv] =
+    as::ray_intersect_triangle(r, v0, v1, v2, 3.0_r);
+  CHECK(hit);
+  CHECK(single_distance == 3.0_r);
+  CHECK(
+    as::ray_packet_intersect_triangle(packet, v0, v1, v2, distance, u, v)
+    == 0b1111);
+  for (index i = 0; i < 4; ++i) {
+    CHECK(distance[i] == 3.0_r);
+    CHECK(u[i] == Approx(uv.x));
+    CHECK(v[i] == Approx(uv.y));
+  }
+}
+
+} // namespace unit_test
@@ -0,0 +1,149 @@
+#include "as-helpers.test.hpp"
+#include "as/as-reduce.hpp"
+#include "catch-matchers.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <limits>
+#include <memory>
+
+namespace unit_test
+{
+
+// testing
+using Catch::Approx;
+
+// types
+using as::index;
+using as::mat3;
+using as::real;
+using as::vec3;
+
+// functions
+using as::operator""_r;
+
+static std::unique_ptr<vec3[]> make_points(const index count)
+{
+  auto points = std::make_unique<vec3[]>(count);
+  for (index i = 0; i < count; ++i) {
+    points[i] = vec3(
+      real(i % 17) - 8.0_r, real(i % 5) * 0.5_r + 100.0_r,
+      -real(i % 11) * 0.25_r);
+  }
+  return points;
+}
+
+TEST_CASE("chunk_ranges", "[as_reduce]")
+{
+  CHECK(as::chunk_count(0, 4) == 0);
+  CHECK(as::chunk_count(8, 4) == 2);
+  CHECK(as::chunk_count(9, 4) == 3);
+  CHECK(as::chunk_begin(2, 4) == 8);
+  CHECK(as::chunk_end(1, 9, 4) == 8);
+  CHECK(as::chunk_end(2, 9, 4) == 9);
+}
+
+TEST_CASE("vec_average_chunked", "[as_reduce]")
+{
+  {
+    const vec3 vecs[] = {
+      vec3{3.0_r, 3.0_r, 3.0_r}, vec3{5.0_r, 5.0_r, 5.0_r}};
+    const vec3 avg = as::vec_average_chunked(vecs, std::size(vecs));
+    CHECK_THAT(arr(4.0_r, 4.0_r, 4.0_r), elements_are_array(avg));
+  }
+
+  {
+    constexpr index count = as::k_reduce_chunk_size * 3 + 17;
+    const auto points = make_points(count);
+
+    const vec3 avg = as::vec_average_chunked(points.get(), count);
+    const vec3 avg_reversed =
+      as::vec_average_chunked(points.get(), count, reverse_executor{});
+    const vec3 expected = as::vec_average_compensated(points.get(), count);
+
+    CHECK(avg == avg_reversed);
+    CHECK_THAT(
+      arr(expected.x, expected.y, expected.z), elements_are_array(avg));
+  }
+}
+
+TEST_CASE("vec_min_max_chunked", "[as_reduce]")
+{
+  constexpr index count = as::k_reduce_chunk_size * 2 + 5;
+  auto points = make_points(count);
+  points[as::k_reduce_chunk_size + 3] = vec3(-20.0_r, 200.0_r, 1.0_r);
+
+  const auto [min, max] =
+    as::vec_min_max_chunked(points.get(), count, reverse_executor{});
+
+  CHECK_THAT(arr(-20.0_r, 100.0_r, -2.5_r), elements_are_array(min));
+  CHECK_THAT(arr(8.0_r, 200.0_r, 1.0_r), elements_are_array(max));
+
+  // an empty array has an empty range
+  const auto [empty_min, empty_max] =
+    as::vec_min_max_chunked(points.get(), 0);
+  CHECK(empty_min == vec3(std::numeric_limits<real>::max()));
+  CHECK(empty_max == vec3(std::numeric_limits<real>::lowest()));
+}
+
+TEST_CASE("vec_covariance_chunked", "[as_reduce]")
+{
+  {
+    using gsl::make_span;
+
+    // points along the x axis and y axis
+    const vec3 points[] = {
+      vec3{-1.0_r, 0.0_r, 0.0_r}, vec3{1.0_r, 0.0_r, 0.0_r},
+      vec3{0.0_r, -2.0_r, 0.0_r}, vec3{0.0_r, 2.0_r, 0.0_r}};
+    const mat3 covariance =
+      as::vec_covariance_chunked(points, std::size(points));
+
+    // clang-format off
+    const real expected[] = {0.5_r, 0.0_r, 0.0_r,
+                             0.0_r, 2.0_r, 0.0_r,
+                             0.0_r, 0.0_r, 0.0_r};
+    // clang-format on
+    CHECK_THAT(make_span(expected), elements_are_span(covariance));
+
+    // an empty array has zero covariance
+    const mat3 empty_covariance = as::vec_covariance_chunked(points, 0);
+    for (index i = 0; i < 9; ++i) {
+      CHECK(empty_covariance[i] == 0.0_r);
+    }
+  }
+
+  {
+    // compare against a (double precision) two pass reference
+    constexpr index count = as::k_reduce_chunk_size * 3 + 101;
+    const auto points = make_points(count);
+
+    double mean[3] = {};
+    for (index i = 0; i < count; ++i) {
+      for (index e = 0; e < 3; ++e) {
+        const double element = points[i][e];
+        mean[e] += element / double(count);
+      }
+    }
+    double expected[9] = {};
+    for (index i = 0; i < count; ++i) {
+      for (index c = 0; c < 3; ++c) {
+        for (index r = 0; r < 3; ++r) {
+          const double row = points[i][r];
+          const double column = points[i][c];
+          expected[c * 3 + r] +=
+            (row - mean[r]) * (column - mean[c]) / double(count);
+        }
+      }
+    }
+
+    const mat3 covariance = as::vec_covariance_chunked(points.get(), count);
+    const mat3 covariance_reversed =
+      as::vec_covariance_chunked(points.get(), count, reverse_executor{});
+
+    CHECK(covariance == covariance_reversed);
+    for (index i = 0; i < 9; ++i) {
+      CHECK(covariance[i] == Approx(expected[i]).margin(1.0e-4_r));
+    }
+  }
+}
+
+} // namespace unit_test
@@ -0,0 +1,198 @@
+#include "as-helpers.test.hpp"
+#include "as/as-shadow.hpp"
+#include "catch-matchers.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <vector>
+
+namespace unit_test
+{
+
+// testing
+using Catch::Approx;
+
+// types
+using as::affine;
+using as::index;
+using as::mat4;
+using as::real;
+using as::vec2;
+using as::vec3;
+using as::vec4;
+
+// functions
+using as::radians;
+using as::operator""_r;
+
+TEST_CASE("shadow_cascade_splits", "[as_shadow]")
+{
+  real splits[5];
+
+  // uniform
+  as::shadow_cascade_splits(1.0_r, 101.0_r, 0.0_r, 4, splits);
+  CHECK(splits[0] == 1.0_r);
+  CHECK(splits[1] == Approx(26.0_r));
+  CHECK(splits[2] == Approx(51.0_r));
+  CHECK(splits[3] == Approx(76.0_r));
+  CHECK(splits[4] == 101.0_r);
+
+  // logarithmic
+  as::shadow_cascade_splits(1.0_r, 10000.0_r, 1.0_r, 4, splits);
+  CHECK(splits[0] == 1.0_r);
+  CHECK(splits[1] == Approx(10.0_r));
+  CHECK(splits[2] == Approx(100.0_r));
+  CHECK(splits[3] == Approx(1000.0_r));
+  CHECK(splits[4] == 10000.0_r);
+
+  // practical (between the two)
+  as::shadow_cascade_splits(1.0_r, 10000.0_r, 0.5_r, 4, splits);
+  CHECK(splits[1] == Approx((10.0_r + 2500.75_r) * 0.5_r));
+  for (index i = 0; i < 4; ++i) {
+    CHECK(splits[i] < splits[i + 1]);
+  }
+}
+
+TEST_CASE("shadow_cascades", "[as_shadow]")
+{
+  const real fov = radians(60.0_r);
+  const real aspect = 16.0_r / 9.0_r;
+  const real n = 0.5_r;
+  const real f = 200.0_r;
+  const index cascade_count = 4;
+  const index shadow_map_size = 1024;
+  real splits[cascade_count + 1];
+  as::shadow_cascade_splits(n, f, 0.75_r, cascade_count, splits);
+
+  // a light shining down at an angle
+  const affine light_view = affine(
+    as::mat3_rotation_x(radians(-60.0_r))
+    * as::mat3_rotation_y(radians(30.0_r)));
+
+  struct convention
+  {
+    mat4 projection;
+    vec2 depth_range;
+  };
+  const convention conventions[] = {
+    {as::perspective_opengl_rh(fov, aspect, n, f), vec2(-1.0_r, 1.0_r)},
+    {as::perspective_direct3d_lh(fov, aspect, n, f), vec2(0.0_r, 1.0_r)},
+    {as::reverse_z(as::perspective_vulkan_rh(fov, aspect, n, f)),
+     vec2(1.0_r, 0.0_r)}};
+
+  for (const convention& c : conventions) {
+    const affine camera = affine(
+      as::mat3_rotation_y(radians(20.0_r)), vec3(3.0_r, 2.0_r, -7.0_r));
+    const affine view = as::affine_inverse(camera);
+    const mat4 inverse_view_projection =
+      as::inverse_view_projection(view, c.projection);
+
+    as::shadow_cascade cascades[cascade_count];
+    as::shadow_cascades(
+      inverse_view_projection, c.depth_range, n, f, splits, cascade_count,
+      light_view, shadow_map_size, 10.0_r, as::ortho_direct3d_lh, cascades);
+
+    for (index i = 0; i < cascade_count; ++i) {
+      // the corners of the slice are inside the shadow map of the cascade
+      const real depths[] = {splits[i], splits[i + 1]};
+      bool inside = true;
+      for (const real depth : depths) {
+        for (index corner = 0; corner < 4; ++corner) {
+          // the corner in view space (at the given distance from the camera)
+          const real half_height = depth * std::tan(fov * 0.5_r);
+          const real half_width = half_height * aspect;
+          // right handed projections look down -z (w is then positive)
+          const bool right_handed =
+            as::mat_mul(vec4(0.0_r, 0.0_r, -1.0_r, 0.0_r), c.projection).w
+            > 0.0_r;
+          const vec3 view_position = vec3(
+            (corner & 1) != 0 ? half_width : -half_width,
+            (corner & 2) != 0 ? half_height : -half_height,
+            right_handed ? -depth : depth);
+          const vec3 world_position =
+            as::affine_transform_pos(camera, view_position);
+          const vec4 clip = as::mat_mul(
+            as::vec4_from_vec3(world_position, 1.0_r),
+            cascades[i].view_projection);
+          inside = inside && std::abs(clip.x) <= 1.0_r
+                && std::abs(clip.y) <= 1.0_r && clip.z >= 0.0_r
+                && clip.z <= 1.0_r;
+          // the bounding sphere contains the corner
+          inside = inside
+                && as::vec_distance(world_position, cascades[i].center)
+                     <= cascades[i].radius + 1e-3_r;
+        }
+      }
+      CHECK(inside);
+    }
+
+    // the size of each cascade does not change as the camera rotates
+    const affine rotated_camera = affine(
+      as::mat3_rotation_y(radians(-65.0_r)) * as::mat3_rotation_x(0.3_r),
+      camera.translation);
+    as::shadow_cascade rotated[cascade_count];
+    as::shadow_cascades(
+      as::inverse_view_projection(
+        as::affine_inverse(rotated_camera), c.projection),
+      c.depth_range, n, f, splits, cascade_count, light_view, shadow_map_size,
+      10.0_r, as::ortho_direct3d_lh, rotated);
+    for (index i = 0; i < cascade_count; ++i) {
+      CHECK(rotated[i].radius == cascades[i].radius);
+    }
+
+    // as the camera moves a world position moves a whole number of texels in
+    // the shadow map
+    const affine moved_camera = affine(
+      camera.rotation, camera.translation + vec3(0.013_r, 0.0_r, 0.021_r));
+    as::shadow_cascade moved[cascade_count];
+    as::shadow_cascades(
+      as::inverse_view_projection(
+        as::affine_inverse(moved_camera), c.projection),
+      c.depth_range, n, f, splits, cascade_count, light_view, shadow_map_size,
+      10.0_r, as::ortho_direct3d_lh, moved);
+    const vec4 world_position = vec4(4.0_r, 1.0_r, -12.0_r, 1.0_r);
+    for (index i = 0; i < cascade_count; ++i) {
+      const vec4 before =
+        as::mat_mul(world_position, cascades[i].view_projection);
+      const vec4 after = as::mat_mul(world_position, moved[i].view_projection);
+      const vec2 texels = (vec2(after.x, after.y) - vec2(before.x, before.y))
+                        * (real(shadow_map_size) * 0.5_r);
+      CHECK(texels.x == Approx(std::round(texels.x)).margin(1e-2_r));
+      CHECK(texels.y == Approx(std::round(texels.y)).margin(1e-2_r));
+    }
+  }
+}
+
+TEST_CASE("shadow_cascades_radius_and_count", "[as_shadow]")
+{
+  const real n = 0.5_r;
+  const real f = 200.0_r;
+  const index shadow_map_size = 512;
+  const mat4 projection = as::perspective_direct3d_lh(
+    radians(60.0_r), 16.0_r / 9.0_r, n, f);
+  const mat4 inverse_view_projection =
+    as::inverse_view_projection(affine::identity(), projection);
+
+  // counts greater than the maximum are clamped (the rest are not written)
+  constexpr index cascade_count = as::k_shadow_max_cascades + 2;
+  real splits[cascade_count + 1];
+  as::shadow_cascade_splits(n, f, 0.75_r, cascade_count, splits);
+  as::shadow_cascade cascades[cascade_count] = {};
+  as::shadow_cascades(
+    inverse_view_projection, vec2(0.0_r, 1.0_r), n, f, splits, cascade_count,
+    affine::identity(), shadow_map_size, 10.0_r, as::ortho_direct3d_lh,
+    cascades);
+  for (index i = 0; i < cascade_count; ++i) {
+    CHECK((cascades[i].radius > 0.0_r) == (i < as::k_shadow_max_cascades));
+  }
+
+  // each radius is a whole number of steps no larger than a texel
+  for (index i = 0; i < as::k_shadow_max_cascades; ++i) {
+    const real radius = cascades[i].radius;
+    const real step = std::exp2(std::ceil(std::log2(radius) - 1e-3_r))
+                    / real(shadow_map_size);
+    CHECK(step <= radius * 2.0_r / real(shadow_map_size));
+    CHECK(radius / step == std::round(radius / step));
+  }
+}
+
+} // namespace unit_test
@@ -0,0 +1,150 @@
+#include "as-helpers.test.hpp"
+#include "as/as-skeleton.hpp"
+#include "catch-matchers.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <vector>
+
+namespace unit_test
+{
+
+// types
+using as::affine;
+using as::index;
+using as::real;
+using as::rigid;
+using as::vec3;
+
+// functions
+using as::radians;
+using as::operator""_r;
+
+// poses of every joint of every instance stored as arrays
+struct skeleton_poses
+{
+  explicit skeleton_poses(const index count)
+    : rotation_w(count), rotation_x(count), rotation_y(count),
+      rotation_z(count), translation_x(count), translation_y(count),
+      translation_z(count)
+  {
+  }
+
+  std::vector<real> rotation_w, rotation_x, rotation_y, rotation_z;
+  std::vector<real> translation_x, translation_y, translation_z;
+
+  as::rigid_soa_t<real> soa()
+  {
+    return {rotation_w.data(),    rotation_x.data(),    rotation_y.data(),
+            rotation_z.data(),    translation_x.data(), translation_y.data(),
+            translation_z.data()};
+  }
+
+  as::rigid_soa_t<const real> const_soa() const
+  {
+    return {rotation_w.data(),    rotation_x.data(),    rotation_y.data(),
+            rotation_z.data(),    translation_x.data(), translation_y.data(),
+            translation_z.data()};
+  }
+};
+
+// a local pose that differs for every joint and instance
+static rigid skeleton_local_pose(const index joint, const index instance)
+{
+  const real t = real(joint) + real(instance) * 0.37_r;
+  return rigid(
+    as::quat_rotation_xyz(
+      radians(t * 13.0_r), radians(t * 7.0_r), radians(t * 19.0_r)),
+    vec3(std::sin(t), 1.0_r, std::cos(t) * 0.5_r));
+}
+
+TEST_CASE("rigid_soa_set_get", "[as_skeleton]")
+{
+  skeleton_poses poses(4);
+  const rigid r = skeleton_local_pose(3, 5);
+  as::rigid_soa_set(poses.soa(), 2, r);
+  CHECK(as::rigid_near(as::rigid_soa_get(poses.const_soa(), 2), r));
+}
+
+TEST_CASE("skeleton_parents_sorted", "[as_skeleton]")
+{
+  const int32_t sorted[] = {-1, 0, 1, 1, 0, -1, 5};
+  CHECK(as::skeleton_parents_sorted(sorted, 7));
+  const int32_t unsorted[] = {-1, 2, 0};
+  CHECK(!as::skeleton_parents_sorted(unsorted, 3));
+  const int32_t self[] = {-1, 1};
+  CHECK(!as::skeleton_parents_sorted(self, 2));
+}
+
+TEST_CASE("skeleton_local_to_model", "[as_skeleton]")
+{
+  // two chains branching from a root and a second root
+  const std::vector<int32_t> parents = {-1, 0, 1, 2, 1, 4, 0, -1, 7, 8};
+  const auto joint_count = index(parents.size());
+  const index instance_count = 150;
+
+  skeleton_poses local(joint_count * instance_count);
+  for (index j = 0; j < joint_count; ++j) {
+    for (index i = 0; i < instance_count; ++i) {
+      as::rigid_soa_set(
+        local.soa(), j * instance_count + i, skeleton_local_pose(j, i));
+    }
+  }
+
+  std::vector<affine> inverse_bind;
+  for (index j = 0; j < joint_count; ++j) {
+    inverse_bind.push_back(
+      as::affine_from_rigid(as::rigid_inverse(skeleton_local_pose(j, 1000))));
+  }
+
+  skeleton_poses model(joint_count * instance_count);
+  as::skeleton_local_to_model(
+    parents.data(), joint_count, local.const_soa(), instance_count,
+    model.soa());
+
+  // the same as concatenating each joint with its parent in turn
+  for (index i = 0; i < instance_count; ++i) {
+    std::vector<rigid> expected;
+    for (index j = 0; j < joint_count; ++j) {
+      const rigid pose = skeleton_local_pose(j, i);
+      expected.push_back(
+        parents[j] < 0 ? pose : as::rigid_mul(pose, expected[parents[j]]));
+      CHECK(as::rigid_near(
+        as::rigid_soa_get(model.const_soa(), j * instance_count + i),
+        expected[j], 1e-4_r));
+    }
+  }
+
+  // the skinning palette is the inverse bind pose followed by the model pose
+  skeleton_poses fused(joint_count * instance_count);
+  std::vector<affine> palette(joint_count * instance_count);
+  as::skeleton_skinning_palette(
+    parents.data(), joint_count, local.const_soa(), instance_count,
+    inverse_bind.data(), fused.soa(), palette.data());
+  CHECK(fused.rotation_w == model.rotation_w);
+  CHECK(fused.translation_z == model.translation_z);
+  for (index i = 0; i < instance_count; ++i) {
+    for (index j = 0; j < joint_count; ++j) {
+      const affine expected = as::affine_mul(
+        inverse_bind[j],
+        as::affine_from_rigid(
+          as::rigid_soa_get(model.const_soa(), j * instance_count + i)));
+      CHECK(as::affine_near(
+        palette[i * joint_count + j], expected, 1e-4_r, 1e-4_r));
+    }
+  }
+
+  // the result does not depend on the order chunks are processed in
+  skeleton_poses reversed(joint_count * instance_count);
+  std::vector<affine> reversed_palette(joint_count * instance_count);
+  as::skeleton_skinning_palette(
+    parents.data(), joint_count, local.const_soa(), instance_count,
+    inverse_bind.data(), reversed.soa(), reversed_palette.data(),
+    reverse_executor{});
+  CHECK(reversed.rotation_x == model.rotation_x);
+  CHECK(reversed.translation_y == model.translation_y);
+  for (index k = 0; k < joint_count * instance_count; ++k) {
+    CHECK(as::affine_near(reversed_palette[k], palette[k], 0.0_r, 0.0_r));
+  }
+}
+
+} // namespace unit_test
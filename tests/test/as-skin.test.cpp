@@ -0,0 +1,369 @@
+#include "as-helpers.test.hpp"
+#include "as/as-skin.hpp"
+#include "catch-matchers.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <vector>
+
+namespace unit_test
+{
+
+// testing
+using Catch::Approx;
+
+// types
+using as::affine;
+using as::dual_quat;
+using as::index;
+using as::mat3;
+using as::real;
+using as::rigid;
+using as::vec3;
+
+// functions
+using as::radians;
+using as::operator""_r;
+
+// vertices, influences and the skinned results stored as arrays
+struct skin_mesh
+{
+  std::vector<real> x, y, z;
+  std::vector<real> normal_x, normal_y, normal_z;
+  std::vector<uint16_t> bones;
+  std::vector<real> weights;
+
+  as::vec3_soa_t<const real> positions() const
+  {
+    return {x.data(), y.data(), z.data()};
+  }
+
+  as::vec3_soa_t<const real> normals() const
+  {
+    return {normal_x.data(), normal_y.data(), normal_z.data()};
+  }
+};
+
+struct skinned_vertices
+{
+  explicit skinned_vertices(const index count)
+    : x(count), y(count), z(count), normal_x(count), normal_y(count),
+      normal_z(count)
+  {
+  }
+
+  std::vector<real> x, y, z;
+  std::vector<real> normal_x, normal_y, normal_z;
+
+  as::vec3_soa_t<real> positions() { return {x.data(), y.data(), z.data()}; }
+
+  as::vec3_soa_t<real> normals()
+  {
+    return {normal_x.data(), normal_y.data(), normal_z.data()};
+  }
+};
+
+// a palette of bones rotating and moving by different amounts
+static std::vector<dual_quat> skin_palette(const index bone_count)
+{
+  std::vector<dual_quat> palette;
+  for (index b = 0; b < bone_count; ++b) {
+    const real t = real(b);
+    palette.push_back(as::dual_quat_from_rigid(rigid(
+      as::quat_rotation_xyz(
+        radians(t * 17.0_r), radians(t * 29.0_r), radians(t * 41.0_r)),
+      vec3(t * 0.5_r, -t, t * 0.25_r))));
+  }
+  return palette;
+}
+
+static skin_mesh skin_mesh_create(
+  const index count, const index influence_count, const index bone_count)
+{
+  skin_mesh mesh;
+  for (index i = 0; i < count; ++i) {
+    const real t = real(i) * 0.01_r;
+    mesh.x.push_back(std::sin(t) * 2.0_r);
+    mesh.y.push_back(t);
+    mesh.z.push_back(std::cos(t * 3.0_r));
+    const vec3 normal =
+      as::vec_normalize(vec3(std::cos(t), 0.5_r, std::sin(t * 2.0_r)));
+    mesh.normal_x.push_back(normal.x);
+    mesh.normal_y.push_back(normal.y);
+    mesh.normal_z.push_back(normal.z);
+    real total = 0.0_r;
+    for (index j = 0; j < influence_count; ++j) {
+      mesh.bones.push_back(uint16_t((i * 7 + j * 3) % bone_count));
+      // the last influence of every third vertex is unused
+      const real weight = (j == influence_count - 1 && i % 3 == 0)
+                          ? 0.0_r
+                          : real((i + j) % 5 + 1);
+      mesh.weights.push_back(weight);
+      total += weight;
+    }
+    for (index j = 0; j < influence_count; ++j) {
+      mesh.weights[i * influence_count + j] /= total;
+    }
+  }
+  return mesh;
+}
+
+// the blended transform of a vertex using dual quaternion operations
+static dual_quat skin_blend(
+  const std::vector<dual_quat>& palette, const skin_mesh& mesh,
+  const index influence_count, const index vertex)
+{
+  const dual_quat& pivot = palette[mesh.bones[vertex * influence_count]];
+  dual_quat blend = pivot * 0.0_r;
+  for (index j = 0; j < influence_count; ++j) {
+    const index influence = vertex * influence_count + j;
+    const dual_quat& dq = palette[mesh.bones[influence]];
+    const real sign =
+      as::quat_dot(dq.real_part, pivot.real_part) < 0.0_r ? -1.0_r : 1.0_r;
+    blend = blend + dq * (mesh.weights[influence] * sign);
+  }
+  return as::dual_quat_normalize(blend);
+}
+
+TEST_CASE("skin_dual_quat", "[as_skin]")
+{
+  const index count = 5000;
+  const std::vector<dual_quat> palette = skin_palette(12);
+
+  SECTION("four influences")
+  {
+    const skin_mesh mesh = skin_mesh_create(count, 4, 12);
+    skinned_vertices skinned(count);
+    as::skin_dual_quat<4>(
+      palette.data(), mesh.bones.data(), mesh.weights.data(),
+      mesh.positions(), mesh.normals(), count, skinned.positions(),
+      skinned.normals());
+
+    for (index i = 0; i < count; ++i) {
+      const dual_quat blend = skin_blend(palette, mesh, 4, i);
+      const vec3 position = as::dual_quat_transform_pos(
+        blend, vec3(mesh.x[i], mesh.y[i], mesh.z[i]));
+      const vec3 normal = as::dual_quat_transform_dir(
+        blend, vec3(mesh.normal_x[i], mesh.normal_y[i], mesh.normal_z[i]));
+      CHECK(as::vec_near(
+        vec3(skinned.x[i], skinned.y[i], skinned.z[i]), position, 1e-4_r));
+      CHECK(as::vec_near(
+        vec3(skinned.normal_x[i], skinned.normal_y[i], skinned.normal_z[i]),
+        normal, 1e-4_r));
+    }
+
+    // the result does not depend on the order chunks are processed in
+    skinned_vertices reversed(count);
+    as::skin_dual_quat<4>(
+      palette.data(), mesh.bones.data(), mesh.weights.data(),
+      mesh.positions(), mesh.normals(), count, reversed.positions(),
+      reversed.normals(), reverse_executor{});
+    CHECK(reversed.x == skinned.x);
+    CHECK(reversed.y == skinned.y);
+    CHECK(reversed.z == skinned.z);
+    CHECK(reversed.normal_z == skinned.normal_z);
+  }
+
+  SECTION("eight influences without normals")
+  {
+    const skin_mesh mesh = skin_mesh_create(count, 8, 12);
+    skinned_vertices skinned(count);
+    as::skin_dual_quat<8>(
+      palette.data(), mesh.bones.data(), mesh.weights.data(),
+      mesh.positions(), as::vec3_soa_t<const real>{nullptr, nullptr, nullptr},
+      count, skinned.positions(),
+      as::vec3_soa_t<real>{nullptr, nullptr, nullptr});
+
+    for (index i = 0; i < count; ++i) {
+      const vec3 position = as::dual_quat_transform_pos(
+        skin_blend(palette, mesh, 8, i),
+        vec3(mesh.x[i], mesh.y[i], mesh.z[i]));
+      CHECK(as::vec_near(
+        vec3(skinned.x[i], skinned.y[i], skinned.z[i]), position, 1e-4_r));
+    }
+  }
+
+  SECTION("antipodal bones")
+  {
+    // negating a bone represents the same transformation
+    std::vector<dual_quat> negated = palette;
+    for (index b = 0; b < index(negated.size()); b += 2) {
+      negated[b] = -negated[b];
+    }
+    const skin_mesh mesh = skin_mesh_create(count, 4, 12);
+    skinned_vertices skinned(count);
+    skinned_vertices skinned_negated(count);
+    as::skin_dual_quat<4>(
+      palette.data(), mesh.bones.data(), mesh.weights.data(),
+      mesh.positions(), mesh.normals(), count, skinned.positions(),
+      skinned.normals());
+    as::skin_dual_quat<4>(
+      negated.data(), mesh.bones.data(), mesh.weights.data(),
+      mesh.positions(), mesh.normals(), count, skinned_negated.positions(),
+      skinned_negated.normals());
+    for (index i = 0; i < count; ++i) {
+      CHECK(skinned_negated.x[i] == Approx(skinned.x[i]).margin(1e-4_r));
+      CHECK(skinned_negated.y[i] == Approx(skinned.y[i]).margin(1e-4_r));
+      CHECK(
+        skinned_negated.normal_z[i]
+        == Approx(skinned.normal_z[i]).margin(1e-4_r));
+    }
+  }
+
+  SECTION("single bone")
+  {
+    // a vertex influenced by one bone is transformed rigidly
+    const skin_mesh mesh = skin_mesh_create(1, 4, 1);
+    skinned_vertices skinned(1);
+    const dual_quat bone = as::dual_quat_from_rigid(rigid(
+      as::quat_rotation_y(radians(90.0_r)), vec3(0.0_r, 1.0_r, 0.0_r)));
+    as::skin_dual_quat<4>(
+      &bone, mesh.bones.data(), mesh.weights.data(), mesh.positions(),
+      mesh.normals(), 1, skinned.positions(), skinned.normals());
+    CHECK(as::vec_near(
+      vec3(skinned.x[0], skinned.y[0], skinned.z[0]),
+      as::dual_quat_transform_pos(bone, vec3(mesh.x[0], mesh.y[0], mesh.z[0])),
+      1e-5_r));
+  }
+}
+
+// a palette of bones rotating, scaling and moving by different amounts
+static std::vector<affine> skin_affine_palette(const index bone_count)
+{
+  std::vector<affine> palette;
+  for (index b = 0; b < bone_count; ++b) {
+    const real t = real(b);
+    palette.push_back(affine(
+      as::mat3_from_quat(as::quat_rotation_xyz(
+        radians(t * 23.0_r), radians(t * 11.0_r), radians(t * 37.0_r)))
+        * (1.0_r + t * 0.1_r),
+      vec3(-t, t * 0.5_r, t * 2.0_r)));
+  }
+  return palette;
+}
+
+TEST_CASE("skin_lbs", "[as_skin]")
+{
+  const index count = 5000;
+  const std::vector<affine> palette = skin_affine_palette(12);
+  const skin_mesh mesh = skin_mesh_create(count, 4, 12);
+  skinned_vertices skinned(count);
+  as::skin_lbs<4>(
+    palette.data(), mesh.bones.data(), mesh.weights.data(), mesh.positions(),
+    mesh.normals(), count, skinned.positions(), skinned.normals());
+
+  for (index i = 0; i < count; ++i) {
+    // the weighted sum of the transformed positions
+    vec3 position = vec3::zero();
+    vec3 normal = vec3::zero();
+    for (index j = 0; j < 4; ++j) {
+      const affine& a = palette[mesh.bones[i * 4 + j]];
+      const real weight = mesh.weights[i * 4 + j];
+      position +=
+        as::affine_transform_pos(a, vec3(mesh.x[i], mesh.y[i], mesh.z[i]))
+        * weight;
+      normal += as::affine_transform_dir(
+                  a, vec3(mesh.normal_x[i], mesh.normal_y[i], mesh.normal_z[i]))
+              * weight;
+    }
+    CHECK(as::vec_near(
+      vec3(skinned.x[i], skinned.y[i], skinned.z[i]), position, 1e-4_r));
+    CHECK(as::vec_near(
+      vec3(skinned.normal_x[i], skinned.normal_y[i], skinned.normal_z[i]),
+      as::vec_normalize(normal), 1e-4_r));
+  }
+
+  // the result does not depend on the order chunks are processed in
+  skinned_vertices reversed(count);
+  as::skin_lbs<4>(
+    palette.data(), mesh.bones.data(), mesh.weights.data(), mesh.positions(),
+    mesh.normals(), count, reversed.positions(), reversed.normals(),
+    reverse_executor{});
+  CHECK(reversed.x == skinned.x);
+  CHECK(reversed.normal_y == skinned.normal_y);
+}
+
+TEST_CASE("skin_lbs_normal_length", "[as_skin]")
+{
+  // normals are renormalized accurately for any scale
+  const skin_mesh mesh = skin_mesh_create(1000, 8, 1);
+  for (const real scale : {1e-3_r, 0.5_r, 1.0_r, 3.0_r, 1e3_r}) {
+    const affine bone(mat3::identity() * scale);
+    skinned_vertices skinned(1000);
+    as::skin_lbs<8>(
+      &bone, mesh.bones.data(), mesh.weights.data(), mesh.positions(),
+      mesh.normals(), 1000, skinned.positions(), skinned.normals());
+    for (index i = 0; i < 1000; ++i) {
+      const vec3 normal(
+        skinned.normal_x[i], skinned.normal_y[i], skinned.normal_z[i]);
+      CHECK(as::vec_length(normal) == Approx(1.0_r).epsilon(1e-5_r));
+      CHECK(as::vec_near(
+        normal,
+        vec3(mesh.normal_x[i], mesh.normal_y[i], mesh.normal_z[i]), 1e-5_r));
+    }
+  }
+}
+
+TEST_CASE("skin_quantized", "[as_skin]")
+{
+  const index count = 1000;
+  skin_mesh mesh = skin_mesh_create(count, 4, 12);
+
+  // quantize the influences and use the quantized weights as the reference
+  std::vector<uint8_t> bones8;
+  std::vector<uint8_t> weights8;
+  std::vector<uint16_t> weights16;
+  for (index i = 0; i < count * 4; ++i) {
+    bones8.push_back(uint8_t(mesh.bones[i]));
+    weights8.push_back(uint8_t(std::round(mesh.weights[i] * 255.0_r)));
+    weights16.push_back(uint16_t(std::round(mesh.weights[i] * 65535.0_r)));
+  }
+
+  SECTION("linear blend skinning")
+  {
+    const std::vector<affine> palette = skin_affine_palette(12);
+    skinned_vertices quantized(count);
+    as::skin_lbs<4>(
+      palette.data(), bones8.data(), weights8.data(), mesh.positions(),
+      mesh.normals(), count, quantized.positions(), quantized.normals());
+    for (index i = 0; i < count * 4; ++i) {
+      mesh.weights[i] = real(weights8[i]) / 255.0_r;
+    }
+    skinned_vertices skinned(count);
+    as::skin_lbs<4>(
+      palette.data(), mesh.bones.data(), mesh.weights.data(),
+      mesh.positions(), mesh.normals(), count, skinned.positions(),
+      skinned.normals());
+    for (index i = 0; i < count; ++i) {
+      CHECK(quantized.x[i] == Approx(skinned.x[i]).margin(1e-4_r));
+      CHECK(quantized.y[i] == Approx(skinned.y[i]).margin(1e-4_r));
+      CHECK(quantized.z[i] == Approx(skinned.z[i]).margin(1e-4_r));
+      CHECK(
+        quantized.normal_x[i] == Approx(skinned.normal_x[i]).margin(1e-4_r));
+    }
+  }
+
+  SECTION("dual quaternion skinning")
+  {
+    const std::vector<dual_quat> palette = skin_palette(12);
+    skinned_vertices quantized(count);
+    as::skin_dual_quat<4>(
+      palette.data(), mesh.bones.data(), weights16.data(), mesh.positions(),
+      mesh.normals(), count, quantized.positions(), quantized.normals());
+    for (index i = 0; i < count * 4; ++i) {
+      mesh.weights[i] = real(weights16[i]) / 65535.0_r;
+    }
+    skinned_vertices skinned(count);
+    as::skin_dual_quat<4>(
+      palette.data(), bones8.data(), mesh.weights.data(), mesh.positions(),
+      mesh.normals(), count, skinned.positions(), skinned.normals());
+    for (index i = 0; i < count; ++i) {
+      CHECK(quantized.x[i] == Approx(skinned.x[i]).margin(1e-4_r));
+      CHECK(quantized.y[i] == Approx(skinned.y[i]).margin(1e-4_r));
+      CHECK(quantized.z[i] == Approx(skinned.z[i]).margin(1e-4_r));
+      CHECK(
+        quantized.normal_z[i] == Approx(skinned.normal_z[i]).margin(1e-4_r));
+    }
+  }
+}
+
+} // namespace unit_test
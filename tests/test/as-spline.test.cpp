@@ -0,0 +1,177 @@
+#include "as-helpers.test.hpp"
+#include "as/as-spline.hpp"
+#include "catch-matchers.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <vector>
+
+namespace unit_test
+{
+
+// types
+using as::index;
+using as::quat;
+using as::quat_spline;
+using as::real;
+using as::vec3;
+
+// functions
+using as::quat_near;
+using as::quat_rotation_axis;
+using as::quat_rotation_xyz;
+using as::radians;
+using as::operator""_r;
+
+// returns the angular velocity in radians per unit of t from q0 to q1 over h
+static vec3 angular_velocity(const quat& q0, const quat& q1, const real h)
+{
+  const quat delta = as::quat_log(as::quat_conjugate(q0) * q1);
+  return vec3(delta.x, delta.y, delta.z) * (2.0_r / h);
+}
+
+// returns the angular velocity of the spline from t to t + h
+static vec3 angular_velocity(
+  const quat_spline& spline, const real t, const real h)
+{
+  return angular_velocity(
+    as::quat_spline_sample(spline, t), as::quat_spline_sample(spline, t + h),
+    h);
+}
+
+static std::vector<quat> camera_keys()
+{
+  return {
+    quat_rotation_xyz(0.0_r, 0.0_r, 0.0_r),
+    quat_rotation_xyz(radians(20.0_r), radians(60.0_r), 0.0_r),
+    quat_rotation_xyz(radians(-10.0_r), radians(130.0_r), radians(15.0_r)),
+    quat_rotation_xyz(radians(30.0_r), radians(170.0_r), radians(-20.0_r)),
+    quat_rotation_xyz(0.0_r, radians(250.0_r), 0.0_r)};
+}
+
+TEST_CASE("quat_squad_tangent", "[as_spline]")
+{
+  // keys at a constant angular velocity do not need to be adjusted
+  const vec3 axis = as::vec_normalize(vec3(1.0_r, 2.0_r, -1.0_r));
+  const quat prev = quat_rotation_axis(axis, radians(10.0_r));
+  const quat key = quat_rotation_axis(axis, radians(40.0_r));
+  const quat next = quat_rotation_axis(axis, radians(70.0_r));
+  CHECK(quat_near(as::quat_squad_tangent(prev, key, next), key, 1e-5_r));
+}
+
+TEST_CASE("quat_squad", "[as_spline]")
+{
+  const quat q0 = quat_rotation_axis(vec3::axis_y(), radians(30.0_r));
+  const quat q1 = quat_rotation_axis(vec3::axis_y(), radians(90.0_r));
+  // with the keys as intermediate quaternions SQUAD is slerp
+  for (const real t : {0.0_r, 0.25_r, 0.5_r, 0.75_r, 1.0_r}) {
+    CHECK(quat_near(
+      as::quat_squad(q0, q1, q0, q1, t), as::quat_slerp(q0, q1, t), 1e-5_r));
+  }
+}
+
+TEST_CASE("quat_spline_keys", "[as_spline]")
+{
+  const std::vector<quat> keys = camera_keys();
+  const quat_spline spline =
+    as::quat_spline_build(keys.data(), index(keys.size()));
+  REQUIRE(spline.segments.size() == keys.size() - 1);
+
+  for (index k = 0; k < index(keys.size()); ++k) {
+    const quat sampled = as::quat_spline_sample(spline, real(k));
+    const real sign = as::quat_dot(sampled, keys[k]) < 0.0_r ? -1.0_r : 1.0_r;
+    CHECK(quat_near(sampled, keys[k] * sign, 1e-5_r));
+  }
+
+  // clamped to the first and last key
+  CHECK(quat_near(
+    as::quat_spline_sample(spline, -1.0_r),
+    as::quat_spline_sample(spline, 0.0_r)));
+  CHECK(quat_near(
+    as::quat_spline_sample(spline, 10.0_r),
+    as::quat_spline_sample(spline, 4.0_r)));
+}
+
+TEST_CASE("quat_spline_continuity", "[as_spline]")
+{
+  const std::vector<quat> keys = camera_keys();
+  const quat_spline spline =
+    as::quat_spline_build(keys.data(), index(keys.size()));
+
+  // the angular velocity is the same either side of each inner key
+  const real h = 0.01_r;
+  for (index k = 1; k < index(keys.size()) - 1; ++k) {
+    const vec3 before = angular_velocity(spline, real(k) - h, h);
+    const vec3 after = angular_velocity(spline, real(k), h);
+    CHECK(as::vec_distance(before, after) < 0.05_r);
+  }
+
+  // (it is not with slerp)
+  const vec3 slerp_before = angular_velocity(
+    as::quat_slerp(keys[0], keys[1], 1.0_r - h), keys[1], h);
+  const vec3 slerp_after =
+    angular_velocity(keys[1], as::quat_slerp(keys[1], keys[2], h), h);
+  CHECK(as::vec_distance(slerp_before, slerp_after) > 0.5_r);
+
+  // every sample is a unit quaternion
+  for (real t = 0.0_r; t <= 4.0_r; t += 0.05_r) {
+    CHECK(as::quat_length(as::quat_spline_sample(spline, t))
+          == Catch::Approx(1.0_r).margin(1e-5_r));
+  }
+}
+
+TEST_CASE("quat_spline_sample_squad", "[as_spline]")
+{
+  const std::vector<quat> keys = camera_keys();
+  const quat_spline spline =
+    as::quat_spline_build(keys.data(), index(keys.size()));
+
+  // the precomputed segments match SQUAD with the same keys and tangents
+  for (const auto& segment : spline.segments) {
+    for (const real t : {0.1_r, 0.3_r, 0.5_r, 0.7_r, 0.9_r}) {
+      const quat expected = as::quat_squad(
+        segment.key0, segment.key1, segment.tangent0, segment.tangent1, t);
+      const auto s = real(&segment - spline.segments.data());
+      CHECK(quat_near(as::quat_spline_sample(spline, s + t), expected, 1e-4_r));
+    }
+  }
+}
+
+TEST_CASE("quat_spline_sample_batch", "[as_spline]")
+{
+  const std::vector<quat> keys = camera_keys();
+  const quat_spline spline =
+    as::quat_spline_build(keys.data(), index(keys.size()));
+
+  std::vector<real> ts;
+  for (index i = 0; i <= 1000; ++i) {
+    ts.push_back(real(i) * 0.004_r);
+  }
+  std::vector<quat> quats(ts.size());
+  as::quat_spline_sample(spline, ts.data(), index(ts.size()), quats.data());
+  for (index i = 0; i < index(ts.size()); ++i) {
+    const quat expected = as::quat_spline_sample(spline, ts[i]);
+    CHECK(quats[i].w == expected.w);
+    CHECK(quats[i].x == expected.x);
+    CHECK(quats[i].y == expected.y);
+    CHECK(quats[i].z == expected.z);
+  }
+}
+
+TEST_CASE("quat_spline_single_key", "[as_spline]")
+{
+  const quat key = quat_rotation_axis(vec3::axis_z(), radians(45.0_r));
+  const quat_spline spline = as::quat_spline_build(&key, 1);
+  REQUIRE(spline.segments.size() == 1);
+  CHECK(quat_near(as::quat_spline_sample(spline, 0.0_r), key, 1e-6_r));
+  CHECK(quat_near(as::quat_spline_sample(spline, 0.5_r), key, 1e-6_r));
+}
+
+TEST_CASE("quat_spline_no_keys", "[as_spline]")
+{
+  const quat_spline spline = as::quat_spline_build(nullptr, 0);
+  CHECK(spline.segments.empty());
+  CHECK(quat_near(
+    as::quat_spline_sample(spline, 0.5_r), quat::identity(), 0.0_r));
+}
+
+} // namespace unit_test
@@ -0,0 +1,187 @@
+#include "as-helpers.test.hpp"
+#include "as/as-svd.hpp"
+#include "catch-matchers.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <random>
+#include <vector>
+
+namespace unit_test
+{
+
+// testing
+using Catch::Approx;
+
+// types
+using as::index;
+using as::mat3;
+using as::quat;
+using as::real;
+using as::vec3;
+
+// functions
+using as::mat_near;
+using as::radians;
+using as::operator""_r;
+
+static const real k_svd_epsilon = 1e-5_r;
+
+// the product of two matrices applied to the basis vectors (rhs first), the
+// element at row r and column c is m[c * 3 + r]
+static mat3 basis_mul(const mat3& lhs, const mat3& rhs)
+{
+  mat3 result;
+  for (index c = 0; c < 3; ++c) {
+    for (index r = 0; r < 3; ++r) {
+      result[c * 3 + r] = lhs[r] * rhs[c * 3] + lhs[3 + r] * rhs[c * 3 + 1]
+                        + lhs[6 + r] * rhs[c * 3 + 2];
+    }
+  }
+  return result;
+}
+
+// u * sigma * transpose(v)
+static mat3 svd_recompose(const mat3& u, const vec3& sigma, const mat3& v)
+{
+  return basis_mul(
+    basis_mul(u, as::mat3_scale(sigma)), as::mat_transpose(v));
+}
+
+// random matrices and those that are singular, repeated or reflections
+static std::vector<mat3> svd_matrices()
+{
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<real> dist(-1.0_r, 1.0_r);
+  std::vector<mat3> matrices;
+  for (index i = 0; i < 5000; ++i) {
+    mat3 m;
+    for (index e = 0; e < 9; ++e) {
+      m[e] = dist(gen);
+    }
+    matrices.push_back(m);
+  }
+  const mat3 rotation =
+    as::mat3_rotation_xyz(radians(20.0_r), radians(-50.0_r), radians(75.0_r));
+  matrices.push_back(mat3::identity());
+  matrices.push_back(mat3(
+    0.0_r, 0.0_r, 0.0_r, 0.0_r, 0.0_r, 0.0_r, 0.0_r, 0.0_r, 0.0_r));
+  matrices.push_back(rotation);
+  matrices.push_back(as::mat3_scale(2.0_r, 2.0_r, 0.5_r));
+  matrices.push_back(as::mat3_scale(1.0_r, -1.0_r, 1.0_r));
+  matrices.push_back(
+    basis_mul(rotation, as::mat3_scale(3.0_r, -0.25_r, 1.0_r)));
+  // rank one and rank two
+  matrices.push_back(mat3(
+    1.0_r, 2.0_r, 3.0_r, 2.0_r, 4.0_r, 6.0_r, -1.0_r, -2.0_r, -3.0_r));
+  matrices.push_back(basis_mul(rotation, as::mat3_scale(1.0_r, 0.5_r, 0.0_r)));
+  return matrices;
+}
+
+TEST_CASE("mat3_svd", "[as_svd]")
+{
+  for (const mat3& m : svd_matrices()) {
+    const auto [u, sigma, v] = as::mat3_svd(m);
+    CHECK(mat_near(svd_recompose(u, sigma, v), m, k_svd_epsilon));
+    // u and v are rotations
+    CHECK(as::mat_determinant(u) == Approx(1.0_r).margin(k_svd_epsilon));
+    CHECK(as::mat_determinant(v) == Approx(1.0_r).margin(k_svd_epsilon));
+    CHECK(mat_near(
+      basis_mul(u, as::mat_transpose(u)), mat3::identity(), k_svd_epsilon));
+    // sorted by decreasing magnitude, only the last may be negative
+    CHECK(sigma.x >= 0.0_r);
+    CHECK(sigma.y >= 0.0_r);
+    CHECK(sigma.x >= sigma.y);
+    CHECK(sigma.y >= std::abs(sigma.z) - k_svd_epsilon);
+  }
+}
+
+TEST_CASE("mat3_svd_reflection", "[as_svd]")
+{
+  const mat3 reflection = basis_mul(
+    as::mat3_rotation_xyz(radians(10.0_r), radians(30.0_r), radians(-60.0_r)),
+    as::mat3_scale(4.0_r, 2.0_r, -1.0_r));
+  const auto [u, sigma, v] = as::mat3_svd_quat(reflection);
+  CHECK(as::vec_near(sigma, vec3(4.0_r, 2.0_r, -1.0_r), k_svd_epsilon));
+  CHECK(mat_near(
+    svd_recompose(as::mat3_from_quat(u), sigma, as::mat3_from_quat(v)),
+    reflection, k_svd_epsilon));
+}
+
+TEST_CASE("mat3_svd_batch", "[as_svd]")
+{
+  const std::vector<mat3> matrices = svd_matrices();
+  const auto count = index(matrices.size());
+  std::vector<quat> us(count);
+  std::vector<vec3> sigmas(count);
+  std::vector<quat> vs(count);
+  as::mat3_svd(matrices.data(), count, us.data(), sigmas.data(), vs.data());
+  for (index i = 0; i < count; ++i) {
+    const auto [u, sigma, v] = as::mat3_svd_quat(matrices[i]);
+    CHECK(as::quat_near(us[i], u, k_svd_epsilon));
+    CHECK(as::vec_near(sigmas[i], sigma, k_svd_epsilon));
+    CHECK(as::quat_near(vs[i], v, k_svd_epsilon));
+  }
+}
+
+TEST_CASE("mat3_polar", "[as_svd]")
+{
+  for (const mat3& m : svd_matrices()) {
+    const auto [rotation, stretch] = as::mat3_polar(m);
+    CHECK(mat_near(basis_mul(rotation, stretch), m, k_svd_epsilon));
+    CHECK(mat_near(stretch, as::mat_transpose(stretch), k_svd_epsilon));
+    CHECK(
+      as::mat_determinant(rotation) == Approx(1.0_r).margin(k_svd_epsilon));
+  }
+
+  // the rotation of a rotation and (positive) scale is the rotation
+  const quat rotation =
+    as::quat_rotation_xyz(radians(-35.0_r), radians(15.0_r), radians(95.0_r));
+  const mat3 scaled = basis_mul(
+    as::mat3_from_quat(rotation), as::mat3_scale(0.5_r, 2.0_r, 3.0_r));
+  const auto [polar_rotation, stretch] = as::mat3_polar_quat(scaled);
+  CHECK(
+    std::abs(as::quat_dot(polar_rotation, rotation))
+    == Approx(1.0_r).margin(k_svd_epsilon));
+  CHECK(mat_near(stretch, as::mat3_scale(0.5_r, 2.0_r, 3.0_r), k_svd_epsilon));
+}
+
+TEST_CASE("mat3_polar_kabsch", "[as_svd]")
+{
+  // the rotation that best aligns two point sets is the rotation of the
+  // polar decomposition of their cross covariance
+  const quat rotation =
+    as::quat_rotation_xyz(radians(40.0_r), radians(-120.0_r), radians(5.0_r));
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<real> dist(-1.0_r, 1.0_r);
+  mat3 covariance(
+    0.0_r, 0.0_r, 0.0_r, 0.0_r, 0.0_r, 0.0_r, 0.0_r, 0.0_r, 0.0_r);
+  for (index i = 0; i < 32; ++i) {
+    const vec3 point(dist(gen), dist(gen), dist(gen));
+    const vec3 rotated = as::quat_rotate(rotation, point);
+    const real p[] = {point.x, point.y, point.z};
+    const real q[] = {rotated.x, rotated.y, rotated.z};
+    for (index c = 0; c < 3; ++c) {
+      for (index r = 0; r < 3; ++r) {
+        covariance[c * 3 + r] += q[r] * p[c];
+      }
+    }
+  }
+  const auto [aligned, stretch] = as::mat3_polar_quat(covariance);
+  CHECK(
+    std::abs(as::quat_dot(aligned, rotation))
+    == Approx(1.0_r).margin(k_svd_epsilon));
+}
+
+TEST_CASE("mat3_polar_batch", "[as_svd]")
+{
+  const std::vector<mat3> matrices = svd_matrices();
+  const auto count = index(matrices.size());
+  std::vector<quat> rotations(count);
+  as::mat3_polar(matrices.data(), count, rotations.data());
+  for (index i = 0; i < count; ++i) {
+    const auto [rotation, stretch] = as::mat3_polar_quat(matrices[i]);
+    CHECK(as::quat_near(rotations[i], rotation, k_svd_epsilon));
+  }
+}
+
+} // namespace unit_test
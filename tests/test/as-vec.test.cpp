@@ -1659,6 +1659,28 @@ TEST_CASE("length_squared_generic", "[as_vec]")
   CHECK(length_sq == Approx(135.0_r).epsilon(g_epsilon));
 }
 
+TEST_CASE("dot_compensated", "[as_vec]")
+{
+  using vec5 = vec<real, 5>;
+
+  // the small product is lost with a naive running sum (in float and double)
+  const vec5 lhs(1.0e20_r, 1.0_r, -1.0e20_r, 2.0_r, 3.0_r);
+  const vec5 rhs(1.0_r, 1.0_r, 1.0_r, 2.0_r, 2.0_r);
+  const real dot = as::vec_dot_compensated(lhs, rhs);
+
+  CHECK(dot == Approx(11.0_r).epsilon(g_epsilon));
+}
+
+TEST_CASE("length_squared_compensated", "[as_vec]")
+{
+  using vec5 = vec<real, 5>;
+
+  const vec5 v(3.0_r, 4.0_r, 5.0_r, 6.0_r, 7.0_r);
+  const real length_sq = as::vec_length_sq_compensated(v);
+
+  CHECK(length_sq == Approx(135.0_r).epsilon(g_epsilon));
+}
+
 TEST_CASE("select", "[as_vec]")
 {
   using int3 = vec<int, 3>;
@@ -2011,6 +2033,37 @@ TEST_CASE("average", "[as_vec]")
   }
 }
 
+TEST_CASE("average_compensated", "[as_vec]")
+{
+  {
+    vec2 vecs[] = {vec2{2.0_r, 2.0_r}, vec2{4.0_r, 4.0_r}};
+    vec2 avg = as::vec_average_compensated(vecs, std::size(vecs));
+    CHECK_THAT(arr(3.0_r, 3.0_r), elements_are_array(avg));
+  }
+
+  {
+    // large offset with a small varying part (e.g. a point cloud far from
+    // the origin)
+    constexpr index count = 1000003;
+    auto vecs = std::make_unique<vec3[]>(count);
+    double expected[3] = {};
+    for (index i = 0; i < count; ++i) {
+      vecs[i] = vec3(
+        10000.0_r + real(i % 10) * 0.1_r, -5000.0_r + real(i % 7) * 0.01_r,
+        real(i % 3) * 0.3_r);
+      for (index e = 0; e < 3; ++e) {
+        const double element = vecs[i][e];
+        expected[e] += element;
+      }
+    }
+
+    const vec3 avg = as::vec_average_compensated(vecs.get(), count);
+    for (index e = 0; e < 3; ++e) {
+      CHECK(avg[e] == Approx(expected[e] / double(count)).epsilon(g_epsilon));
+    }
+  }
+}
+
 TEST_CASE("vec_data", "[as_vec]")
 {
   vec4 vec = vec4(1.0_r, 2.0_r, 3.0_r, 4.0_r);
@@ -2430,6 +2483,8 @@ template as::vec<as::real, 5> as::vec_select(
   const as::vec<as::real, 5>&, const as::vec<as::real, 5>&, bool);
 template as::vec<as::real, 5> as::vec_average(
   const as::vec<as::real, 5>* v, as::index);
+template as::vec<as::real, 5> as::vec_average_compensated(
+  const as::vec<as::real, 5>* v, as::index);
 template auto as::vec_average_fold<as::vec<as::real, 5>, as::vec<as::real, 5>>(
   as::vec<as::real, 5>&&, as::vec<as::real, 5>&&);
 template as::real* as::vec_data(as::vec<as::real, 5>&);
@@ -3,11 +3,18 @@
 #include "catch-matchers.hpp"
 #include "catch2/catch_test_macros.hpp"
 
+#include <random>
+#include <vector>
+
 namespace unit_test
 {
 
+// testing
+using Catch::Approx;
+
 // types
 using as::affine;
+using as::index;
 using as::mat4;
 using as::real;
 using as::vec2;
@@ -521,4 +528,240 @@ TEST_CASE("vec2_to_vec2i_conversions", "[as_view]")
   }
 }
 
+TEST_CASE("view_projection", "[as_view]")
+{
+  const mat4 projection = as::perspective_direct3d_lh(
+    radians(60.0_r), 4.0_r / 3.0_r, 0.1_r, 100.0_r);
+  const affine view =
+    affine(as::mat3_rotation_x(radians(20.0_r)), vec3(1.0_r, 2.0_r, 3.0_r));
+
+  const vec3 position = vec3(4.0_r, -2.0_r, 9.0_r);
+  const as::vec4 expected = as::mat_mul(
+    as::vec4_from_vec3(as::affine_transform_pos(view, position), 1.0_r),
+    projection);
+  const as::vec4 clip = as::mat_mul(
+    as::vec4_from_vec3(position, 1.0_r), as::view_projection(view, projection));
+
+  CHECK_THAT(expected, elements_are(clip).margin(k_view_epsilon));
+}
+
+TEST_CASE("world_to_screen_batch", "[as_view]")
+{
+  const vec2i screen_dimension = vec2i(1280, 720);
+  const affine view = as::affine_inverse(
+    affine(as::mat3_rotation_y(radians(45.0_r)), vec3(2.0_r, 1.0_r, 4.0_r)));
+
+  const mat4 projections[] = {
+    as::perspective_opengl_rh(radians(60.0_r), 16.0_r / 9.0_r, 0.1_r, 100.0_r),
+    as::perspective_vulkan_lh(radians(60.0_r), 16.0_r / 9.0_r, 0.1_r, 100.0_r),
+    as::ortho_direct3d_lh(-20.0_r, 20.0_r, -10.0_r, 10.0_r, 0.1_r, 100.0_r)};
+
+  const index count = as::k_world_to_screen_chunk_size * 2 + 37;
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<real> dist(-20.0_r, 20.0_r);
+  std::vector<real> x(count), y(count), z(count);
+  for (index i = 0; i < count; ++i) {
+    x[i] = dist(gen);
+    y[i] = dist(gen);
+    z[i] = dist(gen);
+  }
+
+  for (const mat4& projection : projections) {
+    const mat4 view_projection = as::view_projection(view, projection);
+
+    std::vector<vec2i> screen_positions(count);
+    std::vector<uint32_t> clipped(as::chunk_count(count, 32));
+    as::world_to_screen(
+      x.data(), y.data(), z.data(), count, view_projection, screen_dimension,
+      screen_positions.data(), clipped.data(), reverse_executor{});
+
+    index clipped_count = 0;
+    bool positions_match = true;
+    bool clipped_match = true;
+    for (index i = 0; i < count; ++i) {
+      const vec3 position = vec3(x[i], y[i], z[i]);
+      const as::vec4 clip = as::mat_mul(
+        as::vec4_from_vec3(position, 1.0_r), view_projection);
+      const bool behind = (clipped[i / 32] & (1u << (i % 32))) != 0;
+      clipped_match = clipped_match && behind == (clip.w <= 0.0_r);
+      clipped_count += behind;
+      if (!behind) {
+        const vec2i expected =
+          as::world_to_screen(position, projection, view, screen_dimension);
+        positions_match = positions_match
+                       && expected.x == screen_positions[i].x
+                       && expected.y == screen_positions[i].y;
+      }
+    }
+
+    CHECK(positions_match);
+    CHECK(clipped_match);
+    CHECK(clipped_count < count);
+  }
+}
+
+TEST_CASE("camera_rays", "[as_view]")
+{
+  const vec2i screen_dimension = vec2i(67, 45);
+  const affine camera =
+    affine(as::mat3_rotation_y(radians(30.0_r)), vec3(2.0_r, 1.0_r, 4.0_r));
+  const affine view = as::affine_inverse(camera);
+
+  struct convention
+  {
+    mat4 projection;
+    vec2 depth_range;
+    bool perspective;
+  };
+
+  const real fov = radians(60.0_r);
+  const real aspect = 67.0_r / 45.0_r;
+  const convention conventions[] = {
+    {as::perspective_opengl_rh(fov, aspect, 0.1_r, 100.0_r),
+     vec2(-1.0_r, 1.0_r), true},
+    {as::perspective_vulkan_lh(fov, aspect, 0.1_r, 100.0_r),
+     vec2(0.0_r, 1.0_r), true},
+    {as::reverse_z(as::perspective_direct3d_rh(fov, aspect, 0.1_r, 100.0_r)),
+     vec2(1.0_r, 0.0_r), true},
+    {as::ortho_opengl_rh(-6.0_r, 6.0_r, -4.0_r, 4.0_r, 0.1_r, 100.0_r),
+     vec2(-1.0_r, 1.0_r), false}};
+
+  const index count = index(screen_dimension.x) * screen_dimension.y;
+  for (const convention& c : conventions) {
+    const mat4 inverse_view_projection =
+      as::mat_inverse(as::view_projection(view, c.projection));
+
+    std::vector<real> ox(count), oy(count), oz(count);
+    std::vector<real> dx(count), dy(count), dz(count);
+    as::camera_rays(
+      inverse_view_projection, screen_dimension, c.depth_range, ox.data(),
+      oy.data(), oz.data(), dx.data(), dy.data(), dz.data(),
+      reverse_executor{});
+
+    const auto unproject = [&](const vec2& ndc, const real depth) {
+      const as::vec4 world = as::mat_mul(
+        as::vec4(ndc.x, ndc.y, depth, 1.0_r), inverse_view_projection);
+      return as::vec3_from_vec4(world / world.w);
+    };
+
+    for (index y = 0; y < screen_dimension.y; y += 11) {
+      for (index x = 0; x < screen_dimension.x; x += 13) {
+        const index i = y * screen_dimension.x + x;
+        const vec2 ndc = vec2(
+          (real(x) + 0.5_r) / real(screen_dimension.x) * 2.0_r - 1.0_r,
+          1.0_r - (real(y) + 0.5_r) / real(screen_dimension.y) * 2.0_r);
+        const vec3 origin = unproject(ndc, c.depth_range.x);
+        const vec3 direction = as::vec_normalize(
+          unproject(ndc, (c.depth_range.x + c.depth_range.y) * 0.5_r)
+          - origin);
+
+        CHECK_THAT(
+          vec3(ox[i], oy[i], oz[i]), elements_are(origin).margin(1e-3_r));
+        CHECK_THAT(
+          vec3(dx[i], dy[i], dz[i]), elements_are(direction).margin(1e-3_r));
+
+        // rays start on the near plane and pass through the pixel
+        CHECK(
+          std::abs(as::affine_transform_pos(view, origin).z)
+          == Approx(0.1_r).margin(1e-3_r));
+        const vec2i screen = as::world_to_screen(
+          origin + direction * 5.0_r, c.projection, view, screen_dimension);
+        CHECK(std::abs(screen.x - x) <= 1);
+        CHECK(std::abs(screen.y - y) <= 1);
+
+        if (c.perspective) {
+          // rays pass through the camera position
+          const vec3 to_camera = camera.translation - origin;
+          CHECK(
+            as::vec_length(as::vec3_cross(direction, to_camera))
+            == Approx(0.0_r).margin(1e-3_r));
+        } else {
+          // right handed orthographic rays look down the negative z axis
+          const vec3 forward =
+            as::affine_transform_dir(camera, -vec3::axis_z());
+          CHECK(as::vec_dot(direction, forward) == Approx(1.0_r));
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("depth_buffer_to_world", "[as_view]")
+{
+  const vec2i screen_dimension = vec2i(53, 29);
+  const affine camera =
+    affine(as::mat3_rotation_x(radians(-20.0_r)), vec3(1.0_r, 5.0_r, 2.0_r));
+  const affine view = as::affine_inverse(camera);
+
+  struct convention
+  {
+    mat4 projection;
+    vec2 depth_range;
+  };
+
+  const real fov = radians(70.0_r);
+  const real aspect = 53.0_r / 29.0_r;
+  const real n = 0.5_r;
+  const real f = 50.0_r;
+  const convention conventions[] = {
+    {as::perspective_opengl_lh(fov, aspect, n, f), vec2(-1.0_r, 1.0_r)},
+    {as::perspective_direct3d_rh(fov, aspect, n, f), vec2(0.0_r, 1.0_r)},
+    {as::perspective_vulkan_rh(fov, aspect, n, f), vec2(0.0_r, 1.0_r)},
+    {as::reverse_z(as::perspective_direct3d_lh(fov, aspect, n, f)),
+     vec2(1.0_r, 0.0_r)},
+    {as::ortho_direct3d_rh(-4.0_r, 4.0_r, -3.0_r, 3.0_r, n, f),
+     vec2(0.0_r, 1.0_r)}};
+
+  const index count = index(screen_dimension.x) * screen_dimension.y;
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+  std::vector<float> depth(count);
+  for (float& d : depth) {
+    d = dist(gen);
+  }
+  // the first pixels lie on the near and far planes
+  depth[0] = 0.0f;
+  depth[1] = 1.0f;
+
+  for (const convention& c : conventions) {
+    std::vector<real> x(count), y(count), z(count);
+    as::depth_buffer_to_world(
+      depth.data(), screen_dimension, c.projection, view, c.depth_range,
+      x.data(), y.data(), z.data(), reverse_executor{});
+
+    const mat4 inverse_view_projection =
+      as::mat_inverse(as::view_projection(view, c.projection));
+    const real depth_min = std::min(c.depth_range.x, c.depth_range.y);
+    const real depth_max = std::max(c.depth_range.x, c.depth_range.y);
+
+    bool positions_match = true;
+    for (index i = 0; i < count; ++i) {
+      const index px = i % screen_dimension.x;
+      const index py = i / screen_dimension.x;
+      const real depth_value = depth[i];
+      const as::vec4 ndc = as::vec4(
+        (real(px) + 0.5_r) / real(screen_dimension.x) * 2.0_r - 1.0_r,
+        1.0_r - (real(py) + 0.5_r) / real(screen_dimension.y) * 2.0_r,
+        depth_min + depth_value * (depth_max - depth_min), 1.0_r);
+      const as::vec4 world = as::mat_mul(ndc, inverse_view_projection);
+      const vec3 expected = as::vec3_from_vec4(world / world.w);
+      const real tolerance = 1e-3_r * std::max(1.0_r, as::vec_length(expected));
+      positions_match = positions_match
+                     && std::abs(expected.x - x[i]) < tolerance
+                     && std::abs(expected.y - y[i]) < tolerance
+                     && std::abs(expected.z - z[i]) < tolerance;
+    }
+    CHECK(positions_match);
+
+    // the stored depth of the near and far planes depends on the convention
+    const bool reversed = c.depth_range.x > c.depth_range.y;
+    const real near_depth =
+      std::abs(as::affine_transform_pos(view, vec3(x[0], y[0], z[0])).z);
+    const real far_depth =
+      std::abs(as::affine_transform_pos(view, vec3(x[1], y[1], z[1])).z);
+    CHECK(near_depth == Approx(reversed ? f : n).epsilon(1e-3_r));
+    CHECK(far_depth == Approx(reversed ? n : f).epsilon(1e-3_r));
+  }
+}
+
 } // namespace unit_test